@@ -0,0 +1,172 @@
+#include "async_matrix.hpp"
+#include "lu_decomposition.hpp"
+#include <limits>
+#include <vector>
+
+namespace
+{
+ThreadPool &executor_of( AsyncOptions const &options )
+{
+    return ( options.executor != nullptr ) ? *options.executor : ThreadPool::instance();
+}
+
+void report( AsyncOptions const &options, value_t const &fraction )
+{
+    if( options.progress )
+    {
+        options.progress( fraction );
+    }
+}
+
+void assert_square( Matrix const &matrix, char const *message )
+{
+    if( matrix.dimensions().first != matrix.dimensions().second )
+    {
+        throw std::domain_error( message );
+    }
+}
+}
+
+OperationCancelled::OperationCancelled( void )
+    : std::runtime_error( "Operation was cancelled!" )
+{
+}
+
+CancellationToken::CancellationToken( void )
+    : _state( std::make_shared< State >() )
+{
+    _state->cancelled = false;
+    _state->deadline = std::numeric_limits< Clock::rep >::max();
+}
+
+void CancellationToken::cancel( void )
+{
+    _state->cancelled = true;
+}
+
+void CancellationToken::cancel_at( Clock::time_point const &deadline )
+{
+    _state->deadline = deadline.time_since_epoch().count();
+}
+
+bool CancellationToken::is_cancelled( void ) const
+{
+    if( _state->cancelled )
+    {
+        return true;
+    }
+
+    const Clock::rep deadline = _state->deadline;
+
+    return ( deadline != std::numeric_limits< Clock::rep >::max() ) &&
+           ( Clock::now().time_since_epoch().count() >= deadline );
+}
+
+void CancellationToken::check( void ) const
+{
+    if( is_cancelled() )
+    {
+        throw OperationCancelled();
+    }
+}
+
+std::future< Matrix > multiply_async( Matrix const &first,
+                                      Matrix const &second,
+                                      AsyncOptions const &options )
+{
+    if( first.dimensions().second != second.dimensions().first )
+    {
+        throw std::domain_error(
+            "First matrix column count differs from second matrix lines count!" );
+    }
+
+    return executor_of( options ).async( [first, second, options]( void ) -> Matrix {
+        const position_t lines = first.dimensions().first;
+        const position_t inner = first.dimensions().second;
+        const position_t columns = second.dimensions().second;
+        Matrix result;
+
+        result.reset_dimensions( lines, columns );
+
+        for( position_t i = 0; i < lines; ++i )
+        {
+            options.token.check();
+
+            value_t *result_line = result[i];
+
+            std::fill( result_line, result_line + columns, 0.0 );
+
+            for( position_t k = 0; k < inner; ++k )
+            {
+                const value_t factor = first[i][k];
+                value_t const *second_line = second[k];
+
+                for( position_t j = 0; j < columns; ++j )
+                {
+                    result_line[j] += factor * second_line[j];
+                }
+            }
+
+            report( options, static_cast< value_t >( i + 1 ) / lines );
+        }
+
+        return result;
+    } );
+}
+
+std::future< Matrix > inverse_async( Matrix const &matrix, AsyncOptions const &options )
+{
+    assert_square( matrix, "Matrix should be square to have an inverse!" );
+
+    return executor_of( options ).async( [matrix, options]( void ) -> Matrix {
+        const position_t size = matrix.dimensions().first;
+        std::vector< value_t > column_values( size );
+        Matrix result;
+
+        LUDecomposition lu( matrix, [&options, size]( position_t const &step ) -> void {
+            options.token.check();
+            report( options, 0.5 * step / size );
+        } );
+
+        // Same rejection as Matrix::generate_inverse()
+        lu.assert_well_conditioned();
+
+        result.reset_dimensions( size, size );
+
+        for( position_t column = 0; column < size; ++column )
+        {
+            options.token.check();
+
+            std::fill( column_values.begin(), column_values.end(), 0.0 );
+            column_values[column] = 1.0;
+            column_values = lu.solve( column_values );
+
+            for( position_t i = 0; i < size; ++i )
+            {
+                result[i][column] = column_values[i];
+            }
+
+            report( options, 0.5 + 0.5 * ( column + 1 ) / size );
+        }
+
+        return result;
+    } );
+}
+
+std::future< value_t > determinant_async( Matrix const &matrix, AsyncOptions const &options )
+{
+    assert_square( matrix, "This class can only compute determinant for square matrixes!" );
+
+    return executor_of( options ).async( [matrix, options]( void ) -> value_t {
+        const position_t size = matrix.dimensions().first;
+
+        LUDecomposition lu( matrix, [&options, size]( position_t const &step ) -> void {
+            options.token.check();
+            report( options, static_cast< value_t >( step ) / size );
+        } );
+
+        report( options, 1.0 );
+
+        return lu.determinant();
+    } );
+}
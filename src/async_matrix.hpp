@@ -0,0 +1,65 @@
+#ifndef ASYNC_MATRIX_H
+#define ASYNC_MATRIX_H
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <stdexcept>
+
+#include "matrix.hpp"
+#include "thread_pool.hpp"
+
+// Thrown through the future when an operation observed its cancellation
+class OperationCancelled : public std::runtime_error
+{
+    public:
+    OperationCancelled( void );
+};
+
+// Copies share state: cancelling one cancels every copy. A deadline makes
+// the token report itself as cancelled once it has passed.
+class CancellationToken
+{
+    public:
+    typedef std::chrono::steady_clock Clock;
+
+    CancellationToken( void );
+
+    void cancel( void );
+    void cancel_at( Clock::time_point const &deadline );
+    bool is_cancelled( void ) const;
+    // Throws OperationCancelled when cancelled
+    void check( void ) const;
+
+    private:
+    struct State
+    {
+        std::atomic< bool > cancelled;
+        std::atomic< Clock::rep > deadline;
+    };
+
+    std::shared_ptr< State > _state;
+};
+
+// Receives the completed fraction of the work, between 0 and 1
+typedef std::function< void( value_t ) > ProgressCallback;
+
+struct AsyncOptions
+{
+    CancellationToken token;
+    ProgressCallback progress;
+    // nullptr means ThreadPool::instance()
+    ThreadPool *executor = nullptr;
+};
+
+std::future< Matrix > multiply_async( Matrix const &first,
+                                      Matrix const &second,
+                                      AsyncOptions const &options = AsyncOptions() );
+std::future< Matrix > inverse_async( Matrix const &matrix,
+                                     AsyncOptions const &options = AsyncOptions() );
+std::future< value_t > determinant_async( Matrix const &matrix,
+                                          AsyncOptions const &options = AsyncOptions() );
+
+#endif
@@ -0,0 +1,257 @@
+#include "banded_matrix.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+BandedMatrix::BandedMatrix( void )
+    : _size( 0 )
+    , _lower_bandwidth( 0 )
+    , _upper_bandwidth( 0 )
+{
+}
+
+BandedMatrix::BandedMatrix( position_t const &size,
+                            position_t const &lower_bandwidth,
+                            position_t const &upper_bandwidth )
+    : _size( size )
+    , _lower_bandwidth( lower_bandwidth )
+    , _upper_bandwidth( upper_bandwidth )
+    , _data( static_cast< std::size_t >( size ) * ( lower_bandwidth + upper_bandwidth + 1 ), 0.0 )
+{
+}
+
+BandedMatrix::BandedMatrix( Matrix const &matrix,
+                            position_t const &lower_bandwidth,
+                            position_t const &upper_bandwidth )
+    : BandedMatrix( matrix.dimensions().first, lower_bandwidth, upper_bandwidth )
+{
+    if( matrix.dimensions().first != matrix.dimensions().second )
+    {
+        throw std::domain_error( "Banded matrixes should be square!" );
+    }
+
+    for( position_t line = 0; line < _size; ++line )
+    {
+        for( position_t column = 0; column < _size; ++column )
+        {
+            if( contains( line, column ) )
+            {
+                _data[offset( line, column )] = matrix[line][column];
+            }
+        }
+    }
+}
+
+position_t BandedMatrix::size( void ) const
+{
+    return _size;
+}
+
+position_t BandedMatrix::lower_bandwidth( void ) const
+{
+    return _lower_bandwidth;
+}
+
+position_t BandedMatrix::upper_bandwidth( void ) const
+{
+    return _upper_bandwidth;
+}
+
+value_t &BandedMatrix::element( position_t const &line, position_t const &column )
+{
+    if( ( line >= _size ) || ( column >= _size ) || !contains( line, column ) )
+    {
+        throw std::out_of_range( "Position is outside the stored band!" );
+    }
+
+    return _data[offset( line, column )];
+}
+
+value_t BandedMatrix::get( position_t const &line, position_t const &column ) const
+{
+    if( ( line >= _size ) || ( column >= _size ) )
+    {
+        throw std::out_of_range( "Position out of range!" );
+    }
+
+    return contains( line, column ) ? _data[offset( line, column )] : 0.0;
+}
+
+value_t BandedMatrix::determinant( void ) const
+{
+    return eliminate( nullptr );
+}
+
+std::vector< value_t > BandedMatrix::solve( std::vector< value_t > const &rhs ) const
+{
+    std::vector< value_t > result( rhs );
+
+    assert_vector_size( rhs );
+    eliminate( &result );
+
+    return result;
+}
+
+std::vector< value_t > BandedMatrix::multiply( std::vector< value_t > const &values ) const
+{
+    std::vector< value_t > result( _size, 0.0 );
+
+    assert_vector_size( values );
+
+    for( position_t line = 0; line < _size; ++line )
+    {
+        const position_t first = ( line > _lower_bandwidth ) ? line - _lower_bandwidth : 0;
+        const position_t last = std::min( _size - 1, line + _upper_bandwidth );
+        value_t sum = 0.0;
+
+        for( position_t column = first; column <= last; ++column )
+        {
+            sum += _data[offset( line, column )] * values[column];
+        }
+
+        result[line] = sum;
+    }
+
+    return result;
+}
+
+Matrix BandedMatrix::to_matrix( void ) const
+{
+    Matrix result;
+
+    result.reset_dimensions( _size, _size );
+
+    for( position_t line = 0; line < _size; ++line )
+    {
+        for( position_t column = 0; column < _size; ++column )
+        {
+            result[line][column] = get( line, column );
+        }
+    }
+
+    return result;
+}
+
+bool BandedMatrix::contains( position_t const &line, position_t const &column ) const
+{
+    return ( column + _lower_bandwidth >= line ) && ( column <= line + _upper_bandwidth );
+}
+
+std::size_t BandedMatrix::offset( position_t const &line, position_t const &column ) const
+{
+    const std::size_t width = _lower_bandwidth + _upper_bandwidth + 1;
+
+    return line * width + ( column + _lower_bandwidth - line );
+}
+
+// Gaussian elimination with partial pivoting on a copy of the band. Row
+// swaps can push U up to lower_bandwidth extra diagonals, so every work line
+// is that much wider. Returns the determinant and, when rhs is given,
+// overwrites it with the solution.
+value_t BandedMatrix::eliminate( std::vector< value_t > *rhs ) const
+{
+    const position_t fill = _lower_bandwidth + _upper_bandwidth;
+    const std::size_t width = _lower_bandwidth + fill + 1;
+    std::vector< value_t > work( static_cast< std::size_t >( _size ) * width, 0.0 );
+    value_t determinant = 1.0;
+
+    auto at = [&work, width, this]( position_t line, position_t column ) -> value_t & {
+        return work[line * width + ( column + _lower_bandwidth - line )];
+    };
+
+    for( position_t line = 0; line < _size; ++line )
+    {
+        const position_t first = ( line > _lower_bandwidth ) ? line - _lower_bandwidth : 0;
+        const position_t last = std::min( _size - 1, line + _upper_bandwidth );
+
+        for( position_t column = first; column <= last; ++column )
+        {
+            at( line, column ) = _data[offset( line, column )];
+        }
+    }
+
+    for( position_t k = 0; k < _size; ++k )
+    {
+        const position_t last_line = std::min( _size - 1, k + _lower_bandwidth );
+        const position_t last_column = std::min( _size - 1, k + fill );
+        position_t pivot = k;
+
+        for( position_t i = k + 1; i <= last_line; ++i )
+        {
+            if( std::fabs( at( i, k ) ) > std::fabs( at( pivot, k ) ) )
+            {
+                pivot = i;
+            }
+        }
+
+        if( at( pivot, k ) == 0.0 )
+        {
+            if( rhs != nullptr )
+            {
+                throw std::domain_error( "Matrix is singular, system has no unique solution!" );
+            }
+
+            return 0.0;
+        }
+
+        if( pivot != k )
+        {
+            for( position_t j = k; j <= last_column; ++j )
+            {
+                std::swap( at( k, j ), at( pivot, j ) );
+            }
+
+            if( rhs != nullptr )
+            {
+                std::swap( ( *rhs )[k], ( *rhs )[pivot] );
+            }
+
+            determinant = -determinant;
+        }
+
+        determinant *= at( k, k );
+
+        for( position_t i = k + 1; i <= last_line; ++i )
+        {
+            const value_t factor = at( i, k ) / at( k, k );
+
+            for( position_t j = k + 1; j <= last_column; ++j )
+            {
+                at( i, j ) -= factor * at( k, j );
+            }
+
+            if( rhs != nullptr )
+            {
+                ( *rhs )[i] -= factor * ( *rhs )[k];
+            }
+        }
+    }
+
+    if( rhs != nullptr )
+    {
+        std::vector< value_t > &values = *rhs;
+
+        for( position_t line = _size; line-- > 0; )
+        {
+            const position_t last_column = std::min( _size - 1, line + fill );
+            value_t sum = values[line];
+
+            for( position_t column = line + 1; column <= last_column; ++column )
+            {
+                sum -= at( line, column ) * values[column];
+            }
+
+            values[line] = sum / at( line, line );
+        }
+    }
+
+    return determinant;
+}
+
+void BandedMatrix::assert_vector_size( std::vector< value_t > const &values ) const
+{
+    if( values.size() != _size )
+    {
+        throw std::domain_error( "Vector size differs from matrix size!" );
+    }
+}
@@ -0,0 +1,52 @@
+#ifndef BANDED_MATRIX_H
+#define BANDED_MATRIX_H
+
+#include <cstddef>
+#include <vector>
+
+#include "matrix.hpp"
+
+// Square matrix whose non zero entries lie at most lower_bandwidth diagonals
+// below and upper_bandwidth diagonals above the main one. Only the band is
+// stored, so memory is n * (lower_bandwidth + upper_bandwidth + 1).
+class BandedMatrix
+{
+    public:
+    BandedMatrix( void );
+    BandedMatrix( position_t const &size,
+                  position_t const &lower_bandwidth,
+                  position_t const &upper_bandwidth );
+    BandedMatrix( Matrix const &matrix,
+                  position_t const &lower_bandwidth,
+                  position_t const &upper_bandwidth );
+
+    position_t size( void ) const;
+    position_t lower_bandwidth( void ) const;
+    position_t upper_bandwidth( void ) const;
+
+    // Throws std::out_of_range for positions outside the band
+    value_t &element( position_t const &line, position_t const &column );
+    // Returns 0 for positions outside the band
+    value_t get( position_t const &line, position_t const &column ) const;
+
+    // Banded LU with partial pivoting, O(n * kl * (kl + ku))
+    value_t determinant( void ) const;
+    std::vector< value_t > solve( std::vector< value_t > const &rhs ) const;
+
+    std::vector< value_t > multiply( std::vector< value_t > const &values ) const;
+
+    Matrix to_matrix( void ) const;
+
+    private:
+    position_t _size;
+    position_t _lower_bandwidth;
+    position_t _upper_bandwidth;
+    std::vector< value_t > _data;
+
+    bool contains( position_t const &line, position_t const &column ) const;
+    std::size_t offset( position_t const &line, position_t const &column ) const;
+    value_t eliminate( std::vector< value_t > *rhs ) const;
+    void assert_vector_size( std::vector< value_t > const &values ) const;
+};
+
+#endif
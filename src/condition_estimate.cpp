@@ -0,0 +1,128 @@
+#include "condition_estimate.hpp"
+#include <cmath>
+#include <vector>
+
+namespace
+{
+const unsigned int MAXIMUM_ITERATIONS = 5;
+
+value_t absolute_sum( std::vector< value_t > const &values )
+{
+    value_t sum = 0.0;
+
+    for( value_t const &value : values )
+    {
+        sum += std::fabs( value );
+    }
+
+    return sum;
+}
+}
+
+value_t estimate_inverse_norm1( position_t const &size,
+                                InPlaceSolver const &solve,
+                                InPlaceSolver const &solve_transposed )
+{
+    if( size == 0 )
+    {
+        return 0.0;
+    }
+
+    std::vector< value_t > x( size, 1.0 / size );
+    std::vector< value_t > signs( size, 0.0 );
+    value_t estimate = 0.0;
+    position_t previous_index = size;
+
+    for( unsigned int iteration = 0; iteration < MAXIMUM_ITERATIONS; ++iteration )
+    {
+        solve( x.data() );
+
+        const value_t norm = absolute_sum( x );
+        bool signs_repeated = ( iteration > 0 );
+
+        if( ( iteration > 0 ) && ( norm <= estimate ) )
+        {
+            break;
+        }
+
+        estimate = norm;
+
+        for( position_t i = 0; i < size; ++i )
+        {
+            const value_t sign = ( x[i] >= 0.0 ) ? 1.0 : -1.0;
+
+            signs_repeated = signs_repeated && ( sign == signs[i] );
+            signs[i] = sign;
+        }
+
+        // Same sign vector, the next step would give the same estimate
+        if( signs_repeated )
+        {
+            break;
+        }
+
+        x = signs;
+        solve_transposed( x.data() );
+
+        position_t index = 0;
+
+        for( position_t i = 1; i < size; ++i )
+        {
+            if( std::fabs( x[i] ) > std::fabs( x[index] ) )
+            {
+                index = i;
+            }
+        }
+
+        // No direction does better than the one just tried: z^T x, with x
+        // being e_j after the first iteration
+        if( ( previous_index < size ) && ( std::fabs( x[index] ) <= x[previous_index] ) )
+        {
+            break;
+        }
+
+        previous_index = index;
+        std::fill( x.begin(), x.end(), 0.0 );
+        x[index] = 1.0;
+    }
+
+    // Higham's extra vector with alternating signs and growing magnitudes,
+    // catches the matrixes where the main iteration is badly fooled
+    for( position_t i = 0; i < size; ++i )
+    {
+        const value_t magnitude = 1.0 + ( ( size > 1 ) ? value_t( i ) / ( size - 1 ) : 0.0 );
+
+        x[i] = ( ( i % 2 ) == 0 ) ? magnitude : -magnitude;
+    }
+
+    solve( x.data() );
+
+    const value_t alternative = 2.0 * absolute_sum( x ) / ( 3.0 * size );
+
+    return std::max( estimate, alternative );
+}
+
+value_t norm1( Matrix const &matrix )
+{
+    const MatrixDimensions dimensions = matrix.dimensions();
+    std::vector< value_t > sums( dimensions.second, 0.0 );
+
+    for( position_t i = 0; i < dimensions.first; ++i )
+    {
+        value_t const *line = matrix[i];
+
+        for( position_t j = 0; j < dimensions.second; ++j )
+        {
+            sums[j] += std::fabs( line[j] );
+        }
+    }
+
+    value_t norm = 0.0;
+
+    for( value_t const &sum : sums )
+    {
+        norm = std::max( norm, sum );
+    }
+
+    return norm;
+}
@@ -0,0 +1,22 @@
+#ifndef CONDITION_ESTIMATE_H
+#define CONDITION_ESTIMATE_H
+
+#include <functional>
+
+#include "matrix.hpp"
+
+// Solves a system in place, values holds the right hand side on entry
+typedef std::function< void( value_t * ) > InPlaceSolver;
+
+// Lower bound of ||A^-1||_1 that is exact or within a small factor in
+// practice, using Hager's method with Higham's refinements (LAPACK xLACON):
+// a few solves with A and A^T, so O(n^2) once A is factored, instead of
+// the O(n^3) explicit inverse.
+value_t estimate_inverse_norm1( position_t const &size,
+                                InPlaceSolver const &solve,
+                                InPlaceSolver const &solve_transposed );
+
+// Largest absolute column sum
+value_t norm1( Matrix const &matrix );
+
+#endif
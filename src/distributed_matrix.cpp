@@ -0,0 +1,356 @@
+#include "distributed_matrix.hpp"
+#include "gemm.hpp"
+#include <algorithm>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+// Negative tags are reserved for the library's own collective operations
+const int GATHER_TAG = -1;
+
+// SUMMA panels of step k use -2 - 2k (A) and -3 - 2k (B), below GATHER_TAG
+int a_panel_tag( std::size_t const &panel )
+{
+    return -2 - 2 * static_cast< int >( panel );
+}
+
+int b_panel_tag( std::size_t const &panel )
+{
+    return -3 - 2 * static_cast< int >( panel );
+}
+
+position_t split_offset( position_t const &count, int const &block, int const &blocks )
+{
+    return static_cast< position_t >( static_cast< std::size_t >( count ) * block / blocks );
+}
+
+// Block owning global position, skipping the empty blocks left when there
+// are more blocks than positions
+template < typename Offset >
+int owner_of( position_t const &position, int const &blocks, Offset &&offset )
+{
+    for( int block = 0; block < blocks; ++block )
+    {
+        if( ( offset( block ) <= position ) && ( position < offset( block + 1 ) ) )
+        {
+            return block;
+        }
+    }
+
+    throw std::out_of_range( "Position is outside the distributed matrix!" );
+}
+
+std::vector< value_t > flatten( Matrix const &matrix,
+                                position_t const &first_column,
+                                position_t const &columns )
+{
+    std::vector< value_t > values;
+
+    values.reserve( static_cast< std::size_t >( matrix.dimensions().first ) * columns );
+
+    for( position_t i = 0; i < matrix.dimensions().first; ++i )
+    {
+        value_t const *line = matrix[i] + first_column;
+
+        values.insert( values.end(), line, line + columns );
+    }
+
+    return values;
+}
+
+Matrix from_values( std::vector< value_t > const &values,
+                    position_t const &lines,
+                    position_t const &columns )
+{
+    Matrix matrix;
+
+    if( values.size() != static_cast< std::size_t >( lines ) * columns )
+    {
+        throw std::domain_error( "Received block does not match the expected dimensions!" );
+    }
+
+    matrix.reset_dimensions( lines, columns );
+    std::copy( values.begin(), values.end(), matrix[0] );
+
+    return matrix;
+}
+
+struct Panels
+{
+    Matrix a;
+    Matrix b;
+};
+}
+
+ProcessGrid::ProcessGrid( Transport &transport, int const &lines, int const &columns )
+    : _transport( &transport )
+    , _lines( lines )
+    , _columns( columns )
+{
+    if( ( lines < 1 ) || ( columns < 1 ) || ( lines * columns != transport.size() ) )
+    {
+        throw std::domain_error( "Process grid does not match the transport size!" );
+    }
+}
+
+Transport &ProcessGrid::transport( void ) const
+{
+    return *_transport;
+}
+
+int ProcessGrid::lines( void ) const
+{
+    return _lines;
+}
+
+int ProcessGrid::columns( void ) const
+{
+    return _columns;
+}
+
+int ProcessGrid::line( void ) const
+{
+    return _transport->rank() / _columns;
+}
+
+int ProcessGrid::column( void ) const
+{
+    return _transport->rank() % _columns;
+}
+
+int ProcessGrid::rank_at( int const &line, int const &column ) const
+{
+    return line * _columns + column;
+}
+
+DistributedMatrix::DistributedMatrix( ProcessGrid const &grid,
+                                      position_t const &lines,
+                                      position_t const &columns )
+    : _grid( grid )
+    , _dimensions( lines, columns )
+{
+    const position_t local_lines = line_offset( grid.line() + 1 ) - line_offset( grid.line() );
+    const position_t local_columns =
+        column_offset( grid.column() + 1 ) - column_offset( grid.column() );
+
+    _local.reset_dimensions( local_lines, local_columns );
+
+    if( local_lines * local_columns > 0 )
+    {
+        std::fill( _local[0], _local[0] + local_lines * local_columns, 0.0 );
+    }
+}
+
+DistributedMatrix DistributedMatrix::distribute( ProcessGrid const &grid, Matrix const &global )
+{
+    DistributedMatrix result( grid, global.dimensions().first, global.dimensions().second );
+    const position_t first_line = result.line_offset( grid.line() );
+    const position_t first_column = result.column_offset( grid.column() );
+    Matrix &local = result.local();
+
+    for( position_t i = 0; i < local.dimensions().first; ++i )
+    {
+        value_t const *line = global[first_line + i] + first_column;
+
+        std::copy( line, line + local.dimensions().second, local[i] );
+    }
+
+    return result;
+}
+
+ProcessGrid const &DistributedMatrix::grid( void ) const
+{
+    return _grid;
+}
+
+MatrixDimensions DistributedMatrix::dimensions( void ) const
+{
+    return _dimensions;
+}
+
+Matrix &DistributedMatrix::local( void )
+{
+    return _local;
+}
+
+Matrix const &DistributedMatrix::local( void ) const
+{
+    return _local;
+}
+
+position_t DistributedMatrix::line_offset( int const &block_line ) const
+{
+    return split_offset( _dimensions.first, block_line, _grid.lines() );
+}
+
+position_t DistributedMatrix::column_offset( int const &block_column ) const
+{
+    return split_offset( _dimensions.second, block_column, _grid.columns() );
+}
+
+Matrix DistributedMatrix::gather( int const &root ) const
+{
+    Transport &transport = _grid.transport();
+    Matrix result;
+
+    if( transport.rank() != root )
+    {
+        transport.send( root, GATHER_TAG, flatten( _local, 0, _local.dimensions().second ) );
+
+        return result;
+    }
+
+    result.reset_dimensions( _dimensions.first, _dimensions.second );
+
+    for( int line = 0; line < _grid.lines(); ++line )
+    {
+        for( int column = 0; column < _grid.columns(); ++column )
+        {
+            const int source = _grid.rank_at( line, column );
+            const position_t first_line = line_offset( line );
+            const position_t lines = line_offset( line + 1 ) - first_line;
+            const position_t first_column = column_offset( column );
+            const position_t columns = column_offset( column + 1 ) - first_column;
+            Matrix block = ( source == root ) ?
+                               _local :
+                               from_values( transport.receive( source, GATHER_TAG ), lines, columns );
+
+            for( position_t i = 0; i < lines; ++i )
+            {
+                std::copy( block[i], block[i] + columns, result[first_line + i] + first_column );
+            }
+        }
+    }
+
+    return result;
+}
+
+DistributedMatrix summa_multiply( DistributedMatrix const &a, DistributedMatrix const &b )
+{
+    ProcessGrid const &grid = a.grid();
+
+    if( ( &grid.transport() != &b.grid().transport() ) || ( grid.lines() != b.grid().lines() ) ||
+        ( grid.columns() != b.grid().columns() ) )
+    {
+        throw std::domain_error( "Distributed matrixes should share the same process grid!" );
+    }
+
+    if( a.dimensions().second != b.dimensions().first )
+    {
+        throw std::domain_error(
+            "First matrix column count differs from second matrix lines count!" );
+    }
+
+    DistributedMatrix c( grid, a.dimensions().first, b.dimensions().second );
+    Transport &transport = grid.transport();
+    const int line = grid.line();
+    const int column = grid.column();
+
+    // Panels end at every block boundary of A's columns and B's lines
+    std::vector< position_t > boundaries;
+
+    for( int j = 0; j <= grid.columns(); ++j )
+    {
+        boundaries.push_back( a.column_offset( j ) );
+    }
+
+    for( int i = 0; i <= grid.lines(); ++i )
+    {
+        boundaries.push_back( b.line_offset( i ) );
+    }
+
+    std::sort( boundaries.begin(), boundaries.end() );
+    boundaries.erase( std::unique( boundaries.begin(), boundaries.end() ), boundaries.end() );
+
+    const std::size_t panel_count = boundaries.size() - 1;
+
+    auto exchange = [&]( std::size_t const &panel ) -> Panels {
+        const position_t first = boundaries[panel];
+        const position_t width = boundaries[panel + 1] - first;
+        const int a_tag = a_panel_tag( panel );
+        const int b_tag = b_panel_tag( panel );
+        const int a_owner = owner_of( first, grid.columns(),
+                                      [&a]( int const &block ) { return a.column_offset( block ); } );
+        const int b_owner = owner_of( first, grid.lines(),
+                                      [&b]( int const &block ) { return b.line_offset( block ); } );
+        Panels panels;
+
+        // A panel travels along the grid line, B panel along the grid column
+        if( column == a_owner )
+        {
+            std::vector< value_t > values =
+                flatten( a.local(), first - a.column_offset( column ), width );
+
+            for( int j = 0; j < grid.columns(); ++j )
+            {
+                if( j != column )
+                {
+                    transport.send( grid.rank_at( line, j ), a_tag, values );
+                }
+            }
+
+            panels.a = from_values( values, a.local().dimensions().first, width );
+        }
+        else
+        {
+            panels.a = from_values( transport.receive( grid.rank_at( line, a_owner ), a_tag ),
+                                    a.local().dimensions().first,
+                                    width );
+        }
+
+        if( line == b_owner )
+        {
+            const position_t first_line = first - b.line_offset( line );
+            Matrix const &local = b.local();
+            std::vector< value_t > values;
+
+            values.reserve( static_cast< std::size_t >( width ) * local.dimensions().second );
+
+            for( position_t i = first_line; i < first_line + width; ++i )
+            {
+                values.insert( values.end(), local[i], local[i] + local.dimensions().second );
+            }
+
+            for( int i = 0; i < grid.lines(); ++i )
+            {
+                if( i != line )
+                {
+                    transport.send( grid.rank_at( i, column ), b_tag, values );
+                }
+            }
+
+            panels.b = from_values( values, width, local.dimensions().second );
+        }
+        else
+        {
+            panels.b = from_values( transport.receive( grid.rank_at( b_owner, column ), b_tag ),
+                                    width,
+                                    b.local().dimensions().second );
+        }
+
+        return panels;
+    };
+
+    if( panel_count == 0 )
+    {
+        return c;
+    }
+
+    std::future< Panels > next = std::async( std::launch::async, exchange, 0 );
+
+    for( std::size_t panel = 0; panel < panel_count; ++panel )
+    {
+        Panels current = next.get();
+
+        if( panel + 1 < panel_count )
+        {
+            next = std::async( std::launch::async, exchange, panel + 1 );
+        }
+
+        gemm( 1.0, current.a, false, current.b, false, 1.0, c.local() );
+    }
+
+    return c;
+}
@@ -0,0 +1,67 @@
+#ifndef DISTRIBUTED_MATRIX_H
+#define DISTRIBUTED_MATRIX_H
+
+#include "matrix.hpp"
+#include "transport.hpp"
+
+// lines x columns grid of processes laid over the ranks of a transport,
+// rank = line * columns + column
+class ProcessGrid
+{
+    public:
+    ProcessGrid( Transport &transport, int const &lines, int const &columns );
+
+    Transport &transport( void ) const;
+    int lines( void ) const;
+    int columns( void ) const;
+    // Position of this process in the grid
+    int line( void ) const;
+    int column( void ) const;
+    int rank_at( int const &line, int const &column ) const;
+
+    private:
+    Transport *_transport;
+    int _lines;
+    int _columns;
+};
+
+// Global matrix split in one block per process of a grid. Lines are split
+// in grid.lines() nearly equal contiguous ranges and columns in
+// grid.columns() ranges; every process only stores its own block.
+class DistributedMatrix
+{
+    public:
+    DistributedMatrix( ProcessGrid const &grid, position_t const &lines, position_t const &columns );
+
+    // Every process passes the same global matrix and keeps its block
+    static DistributedMatrix distribute( ProcessGrid const &grid, Matrix const &global );
+
+    ProcessGrid const &grid( void ) const;
+    MatrixDimensions dimensions( void ) const;
+
+    Matrix &local( void );
+    Matrix const &local( void ) const;
+
+    // First global line of block line i (i == grid.lines() gives the end)
+    position_t line_offset( int const &block_line ) const;
+    // First global column of block column j
+    position_t column_offset( int const &block_column ) const;
+
+    // Sends every block to root, which returns the whole matrix. Other
+    // processes return an empty matrix.
+    Matrix gather( int const &root = 0 ) const;
+
+    private:
+    ProcessGrid _grid;
+    MatrixDimensions _dimensions;
+    Matrix _local;
+};
+
+// C = A * B with SUMMA: for every panel of the inner dimension, the owners
+// broadcast their piece of A along grid lines and of B along grid columns,
+// and every process accumulates the panel product into its block of C with
+// gemm. The next panel is exchanged on a separate thread while the current
+// one is multiplied. Must be called by every process of the grid.
+DistributedMatrix summa_multiply( DistributedMatrix const &a, DistributedMatrix const &b );
+
+#endif
@@ -0,0 +1,423 @@
+#include "eigen_solvers.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+#include "jacobi_rotation.hpp"
+#include "krylov_vectors.hpp"
+#include "parallel.hpp"
+
+namespace
+{
+// Below this fraction of ||A v|| the new Lanczos vector is rounding noise
+const value_t BREAKDOWN = 64.0 * std::numeric_limits< value_t >::epsilon();
+
+void random_vector( std::size_t const &size, std::uint64_t const &seed, value_t *x )
+{
+    std::mt19937_64 generator( seed );
+    std::normal_distribution< value_t > distribution;
+
+    for( std::size_t i = 0; i < size; ++i )
+    {
+        x[i] = distribution( generator );
+    }
+}
+
+// w -= V * (V^T w) against the first count vectors, twice: a single
+// classical Gram-Schmidt pass loses orthogonality once w nearly lies in
+// the basis. coefficients receives V^T w summed over both passes.
+void orthogonalize( KrylovWorkspace &work,
+                    std::size_t const &size,
+                    std::size_t const &count,
+                    value_t *w,
+                    value_t *projections,
+                    value_t *coefficients )
+{
+    std::fill( coefficients, coefficients + count, 0.0 );
+
+    for( unsigned int pass = 0; pass < 2; ++pass )
+    {
+        for( std::size_t i = 0; i < count; ++i )
+        {
+            projections[i] = dot( size, work.vector( i ), w );
+            coefficients[i] += projections[i];
+        }
+
+        parallel_for( size,
+                      [&]( std::size_t begin, std::size_t end ) {
+                          for( std::size_t i = 0; i < count; ++i )
+                          {
+                              value_t const *basis = work.vector( i );
+                              const value_t projection = projections[i];
+
+                              for( std::size_t k = begin; k < end; ++k )
+                              {
+                                  w[k] -= projection * basis[k];
+                              }
+                          }
+                      },
+                      count );
+    }
+}
+
+// Eigenvalues of the symmetric size x size matrix a (destroyed) into
+// values, in decreasing order, and the matching unit eigenvectors into the
+// columns of vectors, by cyclic Jacobi rotations
+void jacobi_eigen( value_t *a, value_t *vectors, value_t *values, std::size_t const &size )
+{
+    auto at = [size]( value_t *matrix, std::size_t const &i, std::size_t const &j ) -> value_t & {
+        return matrix[i * size + j];
+    };
+
+    std::fill( vectors, vectors + size * size, 0.0 );
+
+    for( std::size_t i = 0; i < size; ++i )
+    {
+        at( vectors, i, i ) = 1.0;
+    }
+
+    for( unsigned int sweep = 0; sweep < JACOBI_MAXIMUM_SWEEPS; ++sweep )
+    {
+        value_t off_diagonal = 0.0;
+        value_t total = 0.0;
+
+        for( std::size_t i = 0; i < size; ++i )
+        {
+            for( std::size_t j = 0; j < size; ++j )
+            {
+                const value_t square = at( a, i, j ) * at( a, i, j );
+
+                total += square;
+                off_diagonal += ( i != j ) ? square : 0.0;
+            }
+        }
+
+        const value_t epsilon = std::numeric_limits< value_t >::epsilon();
+
+        if( off_diagonal <= epsilon * epsilon * total )
+        {
+            break;
+        }
+
+        for( std::size_t p = 0; p + 1 < size; ++p )
+        {
+            for( std::size_t q = p + 1; q < size; ++q )
+            {
+                const value_t apq = at( a, p, q );
+
+                if( apq == 0.0 )
+                {
+                    continue;
+                }
+
+                // Rotation zeroing a(p, q), a' = J^T a J
+                const JacobiRotation rotation =
+                    jacobi_rotation( at( a, p, p ), at( a, q, q ), apq );
+                const value_t c = rotation.c;
+                const value_t s = rotation.s;
+
+                for( std::size_t k = 0; k < size; ++k )
+                {
+                    const value_t first = at( a, k, p );
+                    const value_t second = at( a, k, q );
+
+                    at( a, k, p ) = c * first - s * second;
+                    at( a, k, q ) = s * first + c * second;
+                }
+
+                for( std::size_t k = 0; k < size; ++k )
+                {
+                    const value_t first = at( a, p, k );
+                    const value_t second = at( a, q, k );
+
+                    at( a, p, k ) = c * first - s * second;
+                    at( a, q, k ) = s * first + c * second;
+                }
+
+                for( std::size_t k = 0; k < size; ++k )
+                {
+                    const value_t first = at( vectors, k, p );
+                    const value_t second = at( vectors, k, q );
+
+                    at( vectors, k, p ) = c * first - s * second;
+                    at( vectors, k, q ) = s * first + c * second;
+                }
+            }
+        }
+    }
+
+    for( std::size_t i = 0; i < size; ++i )
+    {
+        values[i] = at( a, i, i );
+    }
+
+    // Selection sort, size is the small projected dimension
+    for( std::size_t i = 0; i + 1 < size; ++i )
+    {
+        const std::size_t largest = std::max_element( values + i, values + size ) - values;
+
+        if( largest == i )
+        {
+            continue;
+        }
+
+        std::swap( values[i], values[largest] );
+
+        for( std::size_t k = 0; k < size; ++k )
+        {
+            std::swap( at( vectors, k, i ), at( vectors, k, largest ) );
+        }
+    }
+}
+
+// First kept basis vectors become the Ritz vectors V * ritz( :, i ), in
+// place: every entry only needs the basis values at the same index
+void rotate_basis( KrylovWorkspace &work,
+                   std::size_t const &size,
+                   std::size_t const &basis,
+                   value_t const *ritz,
+                   std::size_t const &kept )
+{
+    parallel_for( size,
+                  [&]( std::size_t begin, std::size_t end ) {
+                      std::vector< value_t > old( basis );
+
+                      for( std::size_t k = begin; k < end; ++k )
+                      {
+                          for( std::size_t r = 0; r < basis; ++r )
+                          {
+                              old[r] = work.vector( r )[k];
+                          }
+
+                          for( std::size_t i = 0; i < kept; ++i )
+                          {
+                              value_t sum = 0.0;
+
+                              for( std::size_t r = 0; r < basis; ++r )
+                              {
+                                  sum += ritz[r * basis + i] * old[r];
+                              }
+
+                              work.vector( i )[k] = sum;
+                          }
+                      }
+                  },
+                  basis * kept );
+}
+}
+
+EigenResult power_iteration( LinearOperator const &a,
+                             EigenOptions const &options,
+                             KrylovWorkspace *workspace )
+{
+    const std::size_t n = a.size();
+
+    if( n == 0 )
+    {
+        throw std::domain_error( "Eigenpair count should be between 1 and the operator size!" );
+    }
+
+    KrylovWorkspace local;
+    KrylovWorkspace &work = select_workspace( workspace, local );
+
+    work.reserve( n, 2 );
+
+    value_t *x = work.vector( 0 );
+    value_t *y = work.vector( 1 );
+    value_t lambda = 0.0;
+    EigenResult result;
+
+    random_vector( n, options.seed, x );
+    scale( n, 1.0 / norm( n, x ), x );
+
+    while( true )
+    {
+        a.apply( x, y );
+        ++result.iterations;
+
+        // Rayleigh quotient of the unit vector x
+        lambda = dot( n, x, y );
+
+        const value_t residual = std::sqrt(
+            parallel_reduce( n,
+                             0.0,
+                             [x, y, lambda]( std::size_t begin, std::size_t end ) -> value_t {
+                                 value_t sum = 0.0;
+
+                                 for( std::size_t i = begin; i < end; ++i )
+                                 {
+                                     const value_t difference = y[i] - lambda * x[i];
+
+                                     sum += difference * difference;
+                                 }
+
+                                 return sum;
+                             },
+                             []( value_t const &first, value_t const &second ) {
+                                 return first + second;
+                             } ) );
+
+        if( residual <= options.tolerance * std::fabs( lambda ) )
+        {
+            result.converged = true;
+            break;
+        }
+
+        if( result.iterations >= options.max_iterations )
+        {
+            break;
+        }
+
+        std::swap( x, y );
+        scale( n, 1.0 / norm( n, x ), x );
+    }
+
+    result.values.assign( 1, lambda );
+    result.vectors.reset_dimensions( 1, static_cast< position_t >( n ) );
+    std::copy( x, x + n, result.vectors[0] );
+
+    return result;
+}
+
+EigenResult lanczos( LinearOperator const &a,
+                     position_t const &count,
+                     EigenOptions const &options,
+                     KrylovWorkspace *workspace )
+{
+    const std::size_t n = a.size();
+
+    if( ( count == 0 ) || ( count > n ) )
+    {
+        throw std::domain_error( "Eigenpair count should be between 1 and the operator size!" );
+    }
+
+    const std::size_t k = count;
+    const std::size_t m =
+        std::min< std::size_t >( n,
+                                 ( options.basis_size == 0 ) ? std::max( 2 * k + 1, k + 20 )
+                                                             : options.basis_size );
+
+    if( ( m <= k ) && ( m < n ) )
+    {
+        throw std::domain_error( "Lanczos basis size should be larger than the eigenpair count!" );
+    }
+
+    KrylovWorkspace local;
+    KrylovWorkspace &work = select_workspace( workspace, local );
+
+    // m + 1 basis vectors, then the projected matrix, its eigenvectors, a
+    // copy destroyed by the rotations, Ritz values and two Gram-Schmidt
+    // buffers
+    work.reserve( n, m + 1, 3 * m * m + 3 * m );
+
+    value_t *projected = work.extra();
+    value_t *ritz = projected + m * m;
+    value_t *scratch = ritz + m * m;
+    value_t *theta = scratch + m * m;
+    value_t *projections = theta + m;
+    value_t *coefficients = projections + m;
+    // Coupling of the last basis vector to the next one, the residual
+    value_t beta = 0.0;
+    std::size_t kept = 0;
+    EigenResult result;
+
+    random_vector( n, options.seed, work.vector( 0 ) );
+    scale( n, 1.0 / norm( n, work.vector( 0 ) ), work.vector( 0 ) );
+    std::fill( projected, projected + m * m, 0.0 );
+
+    while( true )
+    {
+        for( std::size_t j = kept; j < m; ++j )
+        {
+            value_t *w = work.vector( j + 1 );
+
+            a.apply( work.vector( j ), w );
+            ++result.iterations;
+
+            const value_t applied_norm = norm( n, w );
+
+            // Full orthogonalization, the coefficients are column j of V^T A V
+            orthogonalize( work, n, j + 1, w, projections, coefficients );
+
+            for( std::size_t i = 0; i <= j; ++i )
+            {
+                projected[i * m + j] = coefficients[i];
+                projected[j * m + i] = coefficients[i];
+            }
+
+            beta = norm( n, w );
+
+            if( beta > BREAKDOWN * applied_norm )
+            {
+                scale( n, 1.0 / beta, w );
+                continue;
+            }
+
+            // Invariant subspace found: go on from a fresh direction, with
+            // no coupling to the previous ones
+            beta = 0.0;
+
+            if( j + 1 < n )
+            {
+                random_vector( n, options.seed + j + 1, w );
+                orthogonalize( work, n, j + 1, w, projections, coefficients );
+                scale( n, 1.0 / norm( n, w ), w );
+            }
+            else
+            {
+                std::fill( w, w + n, 0.0 );
+            }
+        }
+
+        std::copy( projected, projected + m * m, scratch );
+        jacobi_eigen( scratch, ritz, theta, m );
+
+        // ||A y - theta y|| = |beta * last component| for every Ritz pair
+        value_t largest = 0.0;
+
+        for( std::size_t i = 0; i < m; ++i )
+        {
+            largest = std::max( largest, std::fabs( theta[i] ) );
+        }
+
+        result.converged = true;
+
+        for( std::size_t i = 0; i < k; ++i )
+        {
+            if( std::fabs( beta * ritz[( m - 1 ) * m + i] ) > options.tolerance * largest )
+            {
+                result.converged = false;
+                break;
+            }
+        }
+
+        if( result.converged || ( result.iterations >= options.max_iterations ) )
+        {
+            break;
+        }
+
+        // Thick restart: the best Ritz vectors, then the residual direction
+        kept = std::min( k + ( m - k ) / 2, m - 1 );
+        rotate_basis( work, n, m, ritz, kept );
+        std::copy( work.vector( m ), work.vector( m ) + n, work.vector( kept ) );
+        std::fill( projected, projected + m * m, 0.0 );
+
+        for( std::size_t i = 0; i < kept; ++i )
+        {
+            projected[i * m + i] = theta[i];
+        }
+    }
+
+    rotate_basis( work, n, m, ritz, k );
+    result.values.assign( theta, theta + k );
+    result.vectors.reset_dimensions( count, static_cast< position_t >( n ) );
+
+    for( std::size_t i = 0; i < k; ++i )
+    {
+        std::copy( work.vector( i ), work.vector( i ) + n, result.vectors[i] );
+    }
+
+    return result;
+}
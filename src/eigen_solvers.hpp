@@ -0,0 +1,57 @@
+#ifndef EIGEN_SOLVERS_H
+#define EIGEN_SOLVERS_H
+
+#include <cstdint>
+#include <vector>
+
+#include "iterative_solvers.hpp"
+#include "linear_operator.hpp"
+
+struct EigenOptions
+{
+    // A pair is accepted once ||A x - lambda x|| <= tolerance * ||A||,
+    // ||A|| estimated by the largest Ritz value magnitude
+    value_t tolerance = 1e-10;
+    // Operator applications, checked at every restart
+    unsigned int max_iterations = 1000;
+    // Lanczos basis size, 0 picks min(size, max(2 * count + 1, count + 20))
+    position_t basis_size = 0;
+    // Random starting vector
+    std::uint64_t seed = 1;
+};
+
+struct EigenResult
+{
+    // Decreasing order
+    std::vector< value_t > values;
+    // Line i is the unit eigenvector of values[i]
+    Matrix vectors;
+    bool converged = false;
+    // Operator applications
+    unsigned int iterations = 0;
+};
+
+// Both solvers only need y = A * x, A symmetric, so a dense Matrix, a
+// SparseMatrix or a matrix-free callable all work. Vector updates and dot
+// products are split over the thread pool like in the linear solvers, and
+// the Krylov vectors live in the workspace: passing the same one to every
+// call keeps memory at O(size * basis_size) without reallocating.
+
+// Dominant eigenpair, largest in magnitude, by power iteration. Converges
+// at the rate |lambda_2 / lambda_1|, a single pair at the cost of two
+// vectors.
+EigenResult power_iteration( LinearOperator const &a,
+                             EigenOptions const &options = EigenOptions(),
+                             KrylovWorkspace *workspace = nullptr );
+
+// The count algebraically largest eigenpairs by thick restart Lanczos (Wu &
+// Simon), equivalent to implicit restarts for symmetric A. The basis is
+// kept orthogonal by two Gram-Schmidt passes at every step, the projected
+// problem is solved by Jacobi rotations, and every restart keeps the best
+// count + (basis_size - count) / 2 Ritz vectors.
+EigenResult lanczos( LinearOperator const &a,
+                     position_t const &count,
+                     EigenOptions const &options = EigenOptions(),
+                     KrylovWorkspace *workspace = nullptr );
+
+#endif
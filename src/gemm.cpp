@@ -0,0 +1,482 @@
+#include "gemm.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+#include "parallel.hpp"
+
+namespace
+{
+// c = a * b, line-major. Every line of c is accumulated from lines of b so
+// the innermost loop is unit stride on both b and c.
+inline void multiply_kernel( value_t const *a,
+                             value_t const *b,
+                             value_t *c,
+                             position_t const m,
+                             position_t const n,
+                             position_t const k )
+{
+    for( position_t i = 0; i < m; ++i )
+    {
+        value_t const *a_line = a + static_cast< std::size_t >( i ) * k;
+        value_t *c_line = c + static_cast< std::size_t >( i ) * n;
+
+        std::fill( c_line, c_line + n, 0.0 );
+
+        for( position_t p = 0; p < k; ++p )
+        {
+            const value_t factor = a_line[p];
+            value_t const *b_line = b + static_cast< std::size_t >( p ) * n;
+
+            for( position_t j = 0; j < n; ++j )
+            {
+                c_line[j] += factor * b_line[j];
+            }
+        }
+    }
+}
+
+// Square sizes known at compile time. c is computed in 4x4 blocks held in
+// registers over the whole k loop, so every loaded a and b value feeds 4
+// multiply-adds and c is written once. Every trip count is a constant the
+// compiler can unroll.
+template < position_t SIZE >
+void square_kernel( value_t const *a, value_t const *b, value_t *c )
+{
+    static_assert( SIZE % 4 == 0, "Square kernel sizes should be multiples of 4!" );
+
+    for( position_t i = 0; i < SIZE; i += 4 )
+    {
+        for( position_t j = 0; j < SIZE; j += 4 )
+        {
+            value_t block[4][4] = {};
+
+            for( position_t p = 0; p < SIZE; ++p )
+            {
+                value_t const *b_line = b + p * SIZE + j;
+
+                for( position_t r = 0; r < 4; ++r )
+                {
+                    const value_t factor = a[( i + r ) * SIZE + p];
+
+                    for( position_t s = 0; s < 4; ++s )
+                    {
+                        block[r][s] += factor * b_line[s];
+                    }
+                }
+            }
+
+            for( position_t r = 0; r < 4; ++r )
+            {
+                std::copy( block[r], block[r] + 4, c + ( i + r ) * SIZE + j );
+            }
+        }
+    }
+}
+
+typedef void ( *Kernel )( value_t const *, value_t const *, value_t * );
+
+Kernel select_kernel( position_t const &m, position_t const &n, position_t const &k )
+{
+    if( ( m != n ) || ( n != k ) )
+    {
+        return nullptr;
+    }
+
+    switch( m )
+    {
+        case 4:
+            return square_kernel< 4 >;
+        case 8:
+            return square_kernel< 8 >;
+        case 16:
+            return square_kernel< 16 >;
+        case 32:
+            return square_kernel< 32 >;
+        case 64:
+            return square_kernel< 64 >;
+        case 128:
+            return square_kernel< 128 >;
+        default:
+            return nullptr;
+    }
+}
+
+// Scales c lines [begin, end) by beta, 0 overwrites (NaN in c is ignored)
+void scale_lines( value_t *c,
+                  std::size_t const &begin,
+                  std::size_t const &end,
+                  position_t const &n,
+                  value_t const &beta )
+{
+    value_t *first = c + begin * n;
+    value_t *last = c + end * n;
+
+    if( beta == 0.0 )
+    {
+        std::fill( first, last, 0.0 );
+    }
+    else if( beta != 1.0 )
+    {
+        for( value_t *value = first; value != last; ++value )
+        {
+            *value *= beta;
+        }
+    }
+}
+
+// Accumulates alpha * op(a) * op(b) into c lines [begin, end). Loop order is
+// picked per case so the innermost loop is unit stride whenever possible.
+void accumulate_lines( value_t const &alpha,
+                       value_t const *a,
+                       bool const &transpose_a,
+                       value_t const *b,
+                       bool const &transpose_b,
+                       value_t *c,
+                       std::size_t const &begin,
+                       std::size_t const &end,
+                       position_t const &m,
+                       position_t const &n,
+                       position_t const &k )
+{
+    if( !transpose_a && !transpose_b )
+    {
+        // a is m x k, b is k x n
+        for( std::size_t i = begin; i < end; ++i )
+        {
+            value_t const *a_line = a + i * k;
+            value_t *c_line = c + i * n;
+
+            for( position_t p = 0; p < k; ++p )
+            {
+                const value_t factor = alpha * a_line[p];
+                value_t const *b_line = b + static_cast< std::size_t >( p ) * n;
+
+                for( position_t j = 0; j < n; ++j )
+                {
+                    c_line[j] += factor * b_line[j];
+                }
+            }
+        }
+    }
+    else if( transpose_a && !transpose_b )
+    {
+        // a is k x m, b is k x n
+        for( position_t p = 0; p < k; ++p )
+        {
+            value_t const *a_line = a + static_cast< std::size_t >( p ) * m;
+            value_t const *b_line = b + static_cast< std::size_t >( p ) * n;
+
+            for( std::size_t i = begin; i < end; ++i )
+            {
+                const value_t factor = alpha * a_line[i];
+                value_t *c_line = c + i * n;
+
+                for( position_t j = 0; j < n; ++j )
+                {
+                    c_line[j] += factor * b_line[j];
+                }
+            }
+        }
+    }
+    else if( !transpose_a && transpose_b )
+    {
+        // a is m x k, b is n x k: every entry is a dot product of two lines
+        for( std::size_t i = begin; i < end; ++i )
+        {
+            value_t const *a_line = a + i * k;
+            value_t *c_line = c + i * n;
+
+            for( position_t j = 0; j < n; ++j )
+            {
+                value_t const *b_line = b + static_cast< std::size_t >( j ) * k;
+                value_t sum = 0.0;
+
+                for( position_t p = 0; p < k; ++p )
+                {
+                    sum += a_line[p] * b_line[p];
+                }
+
+                c_line[j] += alpha * sum;
+            }
+        }
+    }
+    else
+    {
+        // a is k x m, b is n x k
+        for( std::size_t i = begin; i < end; ++i )
+        {
+            value_t *c_line = c + i * n;
+
+            for( position_t p = 0; p < k; ++p )
+            {
+                const value_t factor = alpha * a[static_cast< std::size_t >( p ) * m + i];
+
+                for( position_t j = 0; j < n; ++j )
+                {
+                    c_line[j] += factor * b[static_cast< std::size_t >( j ) * k + p];
+                }
+            }
+        }
+    }
+}
+
+template < typename Operand >
+void run_batch( std::size_t const &batch,
+                position_t const &m,
+                position_t const &n,
+                position_t const &k,
+                Operand &&operands )
+{
+    const Kernel kernel = select_kernel( m, n, k );
+    const std::size_t cost = static_cast< std::size_t >( m ) * n * k;
+
+    parallel_for( batch,
+                  [&]( std::size_t begin, std::size_t end ) {
+                      for( std::size_t i = begin; i < end; ++i )
+                      {
+                          value_t const *a;
+                          value_t const *b;
+                          value_t *c;
+
+                          operands( i, a, b, c );
+
+                          if( kernel != nullptr )
+                          {
+                              kernel( a, b, c );
+                          }
+                          else
+                          {
+                              multiply_kernel( a, b, c, m, n, k );
+                          }
+                      }
+                  },
+                  cost );
+}
+}
+
+void gemm( value_t const &alpha,
+           Matrix const &a,
+           bool const &transpose_a,
+           Matrix const &b,
+           bool const &transpose_b,
+           value_t const &beta,
+           Matrix &c )
+{
+    // Checked before c is touched: resizing c would reshape the operand
+    if( ( &c == &a ) || ( &c == &b ) || c.shares_data_with( a ) || c.shares_data_with( b ) )
+    {
+        throw std::domain_error( "Result matrix cannot share its buffer with an operand!" );
+    }
+
+    gemm( alpha,
+          transpose_a ? transposed_view( a ) : MatrixView( a ),
+          transpose_b ? transposed_view( b ) : MatrixView( b ),
+          beta,
+          c );
+}
+
+void gemm( value_t const &alpha,
+           MatrixView const &a,
+           MatrixView const &b,
+           value_t const &beta,
+           Matrix &c )
+{
+    const position_t m = a.dimensions().first;
+    const position_t k = a.dimensions().second;
+    const position_t n = b.dimensions().second;
+
+    if( k != b.dimensions().first )
+    {
+        throw std::domain_error(
+            "First matrix column count differs from second matrix lines count!" );
+    }
+
+    // Against the buffer c holds now: resizing it first could free memory
+    // the views still point to
+    value_t const *result = static_cast< Matrix const & >( c )[0];
+    const std::size_t result_count =
+        static_cast< std::size_t >( c.dimensions().first ) * c.dimensions().second;
+
+    auto overlaps = [result, result_count]( MatrixView const &view ) -> bool {
+        const std::size_t count =
+            static_cast< std::size_t >( view.dimensions().first ) * view.dimensions().second;
+
+        return ( count > 0 ) && ( result_count > 0 ) && ( view.data() < result + result_count ) &&
+               ( result < view.data() + count );
+    };
+
+    if( overlaps( a ) || overlaps( b ) )
+    {
+        throw std::domain_error( "Result matrix cannot share its buffer with an operand!" );
+    }
+
+    if( c.dimensions() != MatrixDimensions( m, n ) )
+    {
+        if( beta != 0.0 )
+        {
+            throw std::domain_error( "Result matrix dimensions do not match the product!" );
+        }
+
+        c.reset_dimensions( m, n );
+    }
+
+    // A column-major view is the transpose of its line-major buffer
+    const bool transpose_a = ( a.order() == StorageOrder::column_major );
+    const bool transpose_b = ( b.order() == StorageOrder::column_major );
+    value_t const *a_data = a.data();
+    value_t const *b_data = b.data();
+    value_t *c_data = c[0];
+
+    parallel_for( m,
+                  [&]( std::size_t begin, std::size_t end ) {
+                      scale_lines( c_data, begin, end, n, beta );
+
+                      if( alpha != 0.0 )
+                      {
+                          accumulate_lines( alpha, a_data, transpose_a, b_data, transpose_b,
+                                            c_data, begin, end, m, n, k );
+                      }
+                  },
+                  static_cast< std::size_t >( n ) * ( k + 1 ) );
+}
+
+void gemv( value_t const &alpha,
+           MatrixView const &a,
+           value_t const *x,
+           value_t const &beta,
+           value_t *y )
+{
+    const position_t m = a.dimensions().first;
+    const position_t n = a.dimensions().second;
+    value_t const *data = a.data();
+    const bool column_major = ( a.order() == StorageOrder::column_major );
+
+    parallel_for( m,
+                  [&]( std::size_t begin, std::size_t end ) {
+                      scale_lines( y, begin, end, 1, beta );
+
+                      if( alpha == 0.0 )
+                      {
+                          return;
+                      }
+
+                      if( !column_major )
+                      {
+                          for( std::size_t i = begin; i < end; ++i )
+                          {
+                              value_t const *line = data + i * n;
+                              value_t sum = 0.0;
+
+                              for( position_t j = 0; j < n; ++j )
+                              {
+                                  sum += line[j] * x[j];
+                              }
+
+                              y[i] += alpha * sum;
+                          }
+
+                          return;
+                      }
+
+                      // Every column is contiguous, accumulated over the chunk lines
+                      for( position_t j = 0; j < n; ++j )
+                      {
+                          value_t const *column = data + static_cast< std::size_t >( j ) * m;
+                          const value_t factor = alpha * x[j];
+
+                          for( std::size_t i = begin; i < end; ++i )
+                          {
+                              y[i] += factor * column[i];
+                          }
+                      }
+                  },
+                  static_cast< std::size_t >( n ) + 1 );
+}
+
+void batched_gemm( std::vector< Matrix > const &a,
+                   std::vector< Matrix > const &b,
+                   std::vector< Matrix > &c )
+{
+    if( a.size() != b.size() )
+    {
+        throw std::domain_error( "Batches should have the same number of matrixes!" );
+    }
+
+    // Resizing c would reallocate or reshape the operands before they are read
+    if( ( &c == &a ) || ( &c == &b ) )
+    {
+        throw std::domain_error( "Result batch cannot be an operand batch!" );
+    }
+
+    if( a.empty() )
+    {
+        c.clear();
+        return;
+    }
+
+    const position_t m = a[0].dimensions().first;
+    const position_t k = a[0].dimensions().second;
+    const position_t n = b[0].dimensions().second;
+
+    for( std::size_t i = 0; i < a.size(); ++i )
+    {
+        if( ( a[i].dimensions() != MatrixDimensions( m, k ) ) ||
+            ( b[i].dimensions() != MatrixDimensions( k, n ) ) )
+        {
+            throw std::domain_error( "Every product in a batch should have the same shapes!" );
+        }
+    }
+
+    c.resize( a.size() );
+
+    for( Matrix &result : c )
+    {
+        result.reset_dimensions( m, n );
+    }
+
+    // Line pointers are taken up front, mutable access may detach buffers
+    std::vector< value_t * > targets( c.size() );
+
+    for( std::size_t i = 0; i < c.size(); ++i )
+    {
+        targets[i] = c[i][0];
+    }
+
+    run_batch( a.size(), m, n, k,
+               [&]( std::size_t i, value_t const *&first, value_t const *&second, value_t *&target ) {
+                   first = a[i][0];
+                   second = b[i][0];
+                   target = targets[i];
+               } );
+}
+
+void batched_gemm_strided( value_t const *a,
+                           value_t const *b,
+                           value_t *c,
+                           position_t const &m,
+                           position_t const &n,
+                           position_t const &k,
+                           std::size_t const &batch )
+{
+    const std::size_t a_stride = static_cast< std::size_t >( m ) * k;
+    const std::size_t b_stride = static_cast< std::size_t >( k ) * n;
+    const std::size_t c_stride = static_cast< std::size_t >( m ) * n;
+    const std::size_t c_count = c_stride * batch;
+
+    auto overlaps = [c, c_count]( value_t const *operand, std::size_t const &count ) -> bool {
+        return ( count > 0 ) && ( c_count > 0 ) && ( operand < c + c_count ) &&
+               ( c < operand + count );
+    };
+
+    if( overlaps( a, a_stride * batch ) || overlaps( b, b_stride * batch ) )
+    {
+        throw std::domain_error( "Result buffer cannot overlap an operand buffer!" );
+    }
+
+    run_batch( batch, m, n, k,
+               [&]( std::size_t i, value_t const *&first, value_t const *&second, value_t *&target ) {
+                   first = a + i * a_stride;
+                   second = b + i * b_stride;
+                   target = c + i * c_stride;
+               } );
+}
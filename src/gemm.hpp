@@ -0,0 +1,61 @@
+#ifndef GEMM_H
+#define GEMM_H
+
+#include <cstddef>
+#include <vector>
+
+#include "matrix.hpp"
+#include "matrix_view.hpp"
+
+// c = alpha * op(a) * op(b) + beta * c, where op(x) is x or, when the
+// matching flag is set, x transposed (read in place, never built).
+// c must already be op(a) lines x op(b) columns unless beta is 0, in which
+// case it is resized when needed. Once c has the right dimensions its
+// buffer is reused (products past the parallel threshold still allocate
+// the task state of their chunks). c may not share its buffer with a or b.
+void gemm( value_t const &alpha,
+           Matrix const &a,
+           bool const &transpose_a,
+           Matrix const &b,
+           bool const &transpose_b,
+           value_t const &beta,
+           Matrix &c );
+
+// Same with op(a) and op(b) given as views: a column-major view (such as
+// transposed_view(x)) is read in place as the transpose of its buffer.
+void gemm( value_t const &alpha,
+           MatrixView const &a,
+           MatrixView const &b,
+           value_t const &beta,
+           Matrix &c );
+
+// y = alpha * a * x + beta * y, x holding a.dimensions().second values and
+// y a.dimensions().first. Lines of y are split over the thread pool, both
+// storage orders are read in place. y may not overlap x or a.
+void gemv( value_t const &alpha,
+           MatrixView const &a,
+           value_t const *x,
+           value_t const &beta,
+           value_t *y );
+
+// c[i] = a[i] * b[i] for every i. Every a[i] must be MxK and every b[i] KxN.
+// c is resized to the batch size and every c[i] to MxN; matrixes already
+// holding the right dimensions keep their buffers. Products are spread over
+// the thread pool along the batch dimension, square sizes 4, 8, 16, 32, 64
+// and 128 use register blocked fixed size kernels. c may not be a or b.
+void batched_gemm( std::vector< Matrix > const &a,
+                   std::vector< Matrix > const &b,
+                   std::vector< Matrix > &c );
+
+// Same as batched_gemm over raw line-major buffers: product i reads
+// a + i * m * k and b + i * k * n and writes c + i * m * n. The c buffer may
+// not overlap the a or b buffers.
+void batched_gemm_strided( value_t const *a,
+                           value_t const *b,
+                           value_t *c,
+                           position_t const &m,
+                           position_t const &n,
+                           position_t const &k,
+                           std::size_t const &batch );
+
+#endif
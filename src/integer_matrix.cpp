@@ -0,0 +1,295 @@
+#include "integer_matrix.hpp"
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace
+{
+// result = ( a * b - c * d ) / divisor, the division being exact. False on
+// overflow.
+inline bool bareiss_step( integer_t const &a,
+                          integer_t const &b,
+                          integer_t const &c,
+                          integer_t const &d,
+                          integer_t const &divisor,
+                          integer_t &result )
+{
+    integer_t first;
+    integer_t second;
+    integer_t difference;
+
+    if( __builtin_mul_overflow( a, b, &first ) || __builtin_mul_overflow( c, d, &second ) ||
+        __builtin_sub_overflow( first, second, &difference ) )
+    {
+        return false;
+    }
+
+    if( ( divisor == -1 ) && ( difference == std::numeric_limits< integer_t >::min() ) )
+    {
+        return false;
+    }
+
+    result = difference / divisor;
+
+    return true;
+}
+
+inline bool bareiss_step( big_integer_t const &a,
+                          big_integer_t const &b,
+                          big_integer_t const &c,
+                          big_integer_t const &d,
+                          big_integer_t const &divisor,
+                          big_integer_t &result )
+{
+    result = ( a * b - c * d ) / divisor;
+
+    return true;
+}
+
+// Fraction-free echelon form of a line-major buffer. Returns false on
+// overflow, leaving values partially reduced.
+template < typename Integer >
+bool bareiss( std::vector< Integer > &values,
+              position_t const &lines,
+              position_t const &columns,
+              position_t &rank,
+              int &sign,
+              Integer &last_pivot )
+{
+    Integer previous = 1;
+
+    rank = 0;
+    sign = 1;
+    last_pivot = 1;
+
+    for( position_t column = 0; ( column < columns ) && ( rank < lines ); ++column )
+    {
+        position_t pivot = rank;
+
+        while( ( pivot < lines ) &&
+               ( values[static_cast< std::size_t >( pivot ) * columns + column] == 0 ) )
+        {
+            ++pivot;
+        }
+
+        if( pivot == lines )
+        {
+            continue;
+        }
+
+        if( pivot != rank )
+        {
+            for( position_t j = column; j < columns; ++j )
+            {
+                std::swap( values[static_cast< std::size_t >( pivot ) * columns + j],
+                           values[static_cast< std::size_t >( rank ) * columns + j] );
+            }
+
+            sign = -sign;
+        }
+
+        Integer const *pivot_line = &values[static_cast< std::size_t >( rank ) * columns];
+        const Integer pivot_value = pivot_line[column];
+
+        for( position_t i = rank + 1; i < lines; ++i )
+        {
+            Integer *line = &values[static_cast< std::size_t >( i ) * columns];
+
+            for( position_t j = column + 1; j < columns; ++j )
+            {
+                if( !bareiss_step( line[j], pivot_value, line[column], pivot_line[j], previous,
+                                   line[j] ) )
+                {
+                    return false;
+                }
+            }
+
+            line[column] = 0;
+        }
+
+        previous = pivot_value;
+        last_pivot = pivot_value;
+        ++rank;
+    }
+
+    return true;
+}
+}
+
+IntegerMatrix::IntegerMatrix( void )
+    : _dimensions( 0, 0 )
+    , _used_multiprecision( false )
+{
+}
+
+IntegerMatrix::IntegerMatrix( position_t const &lines, position_t const &columns )
+    : _used_multiprecision( false )
+{
+    reset_dimensions( lines, columns );
+}
+
+IntegerMatrix::IntegerMatrix( IntegerMatrix const &other )
+    : _dimensions( other._dimensions )
+    , _values( other._values )
+    , _used_multiprecision( other.used_multiprecision() )
+{
+}
+
+IntegerMatrix::IntegerMatrix( Matrix const &matrix )
+    : _used_multiprecision( false )
+{
+    const value_t limit = std::ldexp( 1.0, 63 );
+
+    reset_dimensions( matrix.dimensions().first, matrix.dimensions().second );
+
+    for( position_t i = 0; i < _dimensions.first; ++i )
+    {
+        for( position_t j = 0; j < _dimensions.second; ++j )
+        {
+            const value_t value = matrix[i][j];
+
+            if( ( value != std::trunc( value ) ) || ( value >= limit ) || ( value < -limit ) )
+            {
+                throw std::domain_error( "Matrix element is not a 64 bit integer value!" );
+            }
+
+            element( i, j ) = static_cast< integer_t >( value );
+        }
+    }
+}
+
+void IntegerMatrix::reset_dimensions( position_t const &lines, position_t const &columns )
+{
+    _dimensions = MatrixDimensions( lines, columns );
+    _values.assign( static_cast< std::size_t >( lines ) * columns, 0 );
+}
+
+MatrixDimensions IntegerMatrix::dimensions( void ) const
+{
+    return _dimensions;
+}
+
+void IntegerMatrix::set( std::initializer_list< integer_t > values,
+                         position_t const &lines,
+                         position_t const &columns )
+{
+    if( values.size() != static_cast< std::size_t >( lines ) * columns )
+    {
+        throw std::domain_error( "Number of values differs from matrix dimensions!" );
+    }
+
+    _dimensions = MatrixDimensions( lines, columns );
+    _values.assign( values.begin(), values.end() );
+}
+
+integer_t &IntegerMatrix::element( position_t const &line, position_t const &column )
+{
+    assert_position( line, column );
+
+    return _values[static_cast< std::size_t >( line ) * _dimensions.second + column];
+}
+
+integer_t const &IntegerMatrix::element( position_t const &line, position_t const &column ) const
+{
+    assert_position( line, column );
+
+    return _values[static_cast< std::size_t >( line ) * _dimensions.second + column];
+}
+
+big_integer_t IntegerMatrix::determinant( void ) const
+{
+    if( _dimensions.first != _dimensions.second )
+    {
+        throw std::domain_error( "Matrix should be square to have a determinant!" );
+    }
+
+    int sign;
+    big_integer_t last_pivot;
+
+    if( eliminate( sign, last_pivot ) < _dimensions.first )
+    {
+        return 0;
+    }
+
+    return sign * last_pivot;
+}
+
+position_t IntegerMatrix::rank( void ) const
+{
+    int sign;
+    big_integer_t last_pivot;
+
+    return eliminate( sign, last_pivot );
+}
+
+bool IntegerMatrix::is_singular( void ) const
+{
+    if( _dimensions.first != _dimensions.second )
+    {
+        throw std::domain_error( "Matrix should be square!" );
+    }
+
+    return rank() < _dimensions.first;
+}
+
+bool IntegerMatrix::used_multiprecision( void ) const
+{
+    return _used_multiprecision;
+}
+
+IntegerMatrix &IntegerMatrix::operator=( IntegerMatrix const &other )
+{
+    _dimensions = other._dimensions;
+    _values = other._values;
+    _used_multiprecision = other.used_multiprecision();
+
+    return ( *this );
+}
+
+Matrix IntegerMatrix::to_matrix( void ) const
+{
+    Matrix result;
+
+    result.reset_dimensions( _dimensions.first, _dimensions.second );
+
+    for( position_t i = 0; i < _dimensions.first; ++i )
+    {
+        for( position_t j = 0; j < _dimensions.second; ++j )
+        {
+            result[i][j] = static_cast< value_t >( element( i, j ) );
+        }
+    }
+
+    return result;
+}
+
+position_t IntegerMatrix::eliminate( int &sign, big_integer_t &last_pivot ) const
+{
+    std::vector< integer_t > values( _values );
+    position_t rank;
+    integer_t pivot;
+
+    if( bareiss( values, _dimensions.first, _dimensions.second, rank, sign, pivot ) )
+    {
+        _used_multiprecision = false;
+        last_pivot = pivot;
+
+        return rank;
+    }
+
+    // Restarted from the original values, the partial 64 bit state is lost
+    std::vector< big_integer_t > big_values( _values.begin(), _values.end() );
+
+    bareiss( big_values, _dimensions.first, _dimensions.second, rank, sign, last_pivot );
+    _used_multiprecision = true;
+
+    return rank;
+}
+
+void IntegerMatrix::assert_position( position_t const &line, position_t const &column ) const
+{
+    if( ( line >= _dimensions.first ) || ( column >= _dimensions.second ) )
+    {
+        throw std::out_of_range( "Matrix position out of range!" );
+    }
+}
@@ -0,0 +1,64 @@
+#ifndef INTEGER_MATRIX_H
+#define INTEGER_MATRIX_H
+
+#include <atomic>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <cstdint>
+#include <vector>
+
+#include "matrix.hpp"
+
+typedef std::int64_t integer_t;
+typedef boost::multiprecision::cpp_int big_integer_t;
+
+// Matrix of exact integers. Determinant and rank use Bareiss fraction-free
+// elimination: O(n^3) operations where every intermediate value is itself
+// a minor of the matrix, so nothing is rounded and no tolerance is needed.
+// Elimination runs on 64 bit integers and restarts with arbitrary precision
+// integers if any intermediate product overflows.
+class IntegerMatrix
+{
+    public:
+    IntegerMatrix( void );
+    IntegerMatrix( position_t const &lines, position_t const &columns );
+    // Every element must be an integer value representable in 64 bits
+    explicit IntegerMatrix( Matrix const &matrix );
+    IntegerMatrix( IntegerMatrix const &other );
+
+    void reset_dimensions( position_t const &lines, position_t const &columns );
+    MatrixDimensions dimensions( void ) const;
+
+    void set( std::initializer_list< integer_t > values,
+              position_t const &lines,
+              position_t const &columns );
+
+    integer_t &element( position_t const &line, position_t const &column );
+    integer_t const &element( position_t const &line, position_t const &column ) const;
+
+    big_integer_t determinant( void ) const;
+    position_t rank( void ) const;
+    bool is_singular( void ) const;
+
+    // True when the last determinant() or rank() call had to fall back to
+    // arbitrary precision
+    bool used_multiprecision( void ) const;
+
+    Matrix to_matrix( void ) const;
+
+    IntegerMatrix &operator=( IntegerMatrix const &other );
+
+    private:
+    MatrixDimensions _dimensions;
+    std::vector< integer_t > _values;
+    // Written by const methods, atomic so concurrent calls do not race
+    mutable std::atomic< bool > _used_multiprecision;
+
+    // Reduces a copy of the matrix to echelon form, returning its rank. sign
+    // is -1 when an odd number of line swaps was done and last_pivot is the
+    // last pivot found, which is the determinant (up to sign) when the
+    // matrix is square and has full rank.
+    position_t eliminate( int &sign, big_integer_t &last_pivot ) const;
+    void assert_position( position_t const &line, position_t const &column ) const;
+};
+
+#endif
@@ -0,0 +1,434 @@
+#include "iterative_solvers.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "krylov_vectors.hpp"
+
+namespace
+{
+// z = M^-1 * r, or r itself without a preconditioner
+value_t const *precondition( SolverOptions const &options, value_t const *r, value_t *z )
+{
+    if( options.preconditioner == nullptr )
+    {
+        return r;
+    }
+
+    options.preconditioner->apply( r, z );
+
+    return z;
+}
+
+// r = b - A x
+void residual( LinearOperator const &a, value_t const *b, value_t const *x, value_t *r )
+{
+    a.apply( x, r );
+    elementwise( a.size(), [b, r]( std::size_t i ) { r[i] = b[i] - r[i]; } );
+}
+
+// Checks sizes, sets up x and returns the absolute residual norm to reach
+value_t prepare( LinearOperator const &a,
+                 std::vector< value_t > const &b,
+                 std::vector< value_t > &x,
+                 SolverOptions const &options )
+{
+    if( b.size() != a.size() )
+    {
+        throw std::domain_error( "Right hand side size differs from operator size!" );
+    }
+
+    if( x.size() != b.size() )
+    {
+        x.assign( b.size(), 0.0 );
+    }
+
+    return options.tolerance * norm( b.size(), b.data() );
+}
+
+}
+
+KrylovWorkspace::KrylovWorkspace( void )
+    : _size( 0 )
+    , _allocations( 0 )
+{
+}
+
+void KrylovWorkspace::reserve( std::size_t const &size,
+                               std::size_t const &count,
+                               std::size_t const &extra )
+{
+    _size = size;
+
+    if( _vectors.size() < size * count )
+    {
+        _vectors.resize( size * count );
+        ++_allocations;
+    }
+
+    if( _extra.size() < extra )
+    {
+        _extra.resize( extra );
+        ++_allocations;
+    }
+}
+
+value_t *KrylovWorkspace::vector( std::size_t const &index )
+{
+    return _vectors.data() + index * _size;
+}
+
+value_t *KrylovWorkspace::extra( void )
+{
+    return _extra.data();
+}
+
+std::size_t KrylovWorkspace::allocations( void ) const
+{
+    return _allocations;
+}
+
+SolverResult conjugate_gradient( LinearOperator const &a,
+                                 std::vector< value_t > const &b,
+                                 std::vector< value_t > &x,
+                                 SolverOptions const &options,
+                                 KrylovWorkspace *workspace )
+{
+    const value_t target = prepare( a, b, x, options );
+    const std::size_t n = b.size();
+    KrylovWorkspace local;
+    KrylovWorkspace &work = select_workspace( workspace, local );
+
+    work.reserve( n, 4 );
+
+    value_t *r = work.vector( 0 );
+    value_t *z = work.vector( 1 );
+    value_t *p = work.vector( 2 );
+    value_t *q = work.vector( 3 );
+    value_t *solution = x.data();
+    SolverResult result;
+
+    residual( a, b.data(), solution, r );
+    result.residual_norm = norm( n, r );
+
+    if( result.residual_norm <= target )
+    {
+        result.converged = true;
+        return result;
+    }
+
+    value_t const *preconditioned = precondition( options, r, z );
+    value_t rz = dot( n, r, preconditioned );
+
+    std::copy( preconditioned, preconditioned + n, p );
+
+    while( result.iterations < options.max_iterations )
+    {
+        a.apply( p, q );
+
+        const value_t curvature = dot( n, p, q );
+
+        if( curvature == 0.0 )
+        {
+            break;
+        }
+
+        const value_t alpha = rz / curvature;
+
+        elementwise( n, [=]( std::size_t i ) {
+            solution[i] += alpha * p[i];
+            r[i] -= alpha * q[i];
+        } );
+
+        ++result.iterations;
+        result.residual_norm = norm( n, r );
+
+        if( result.residual_norm <= target )
+        {
+            result.converged = true;
+            break;
+        }
+
+        preconditioned = precondition( options, r, z );
+
+        const value_t next_rz = dot( n, r, preconditioned );
+        const value_t beta = next_rz / rz;
+
+        rz = next_rz;
+        elementwise( n, [=]( std::size_t i ) { p[i] = preconditioned[i] + beta * p[i]; } );
+    }
+
+    return result;
+}
+
+SolverResult bicgstab( LinearOperator const &a,
+                       std::vector< value_t > const &b,
+                       std::vector< value_t > &x,
+                       SolverOptions const &options,
+                       KrylovWorkspace *workspace )
+{
+    const value_t target = prepare( a, b, x, options );
+    const std::size_t n = b.size();
+    KrylovWorkspace local;
+    KrylovWorkspace &work = select_workspace( workspace, local );
+
+    work.reserve( n, 8 );
+
+    value_t *r = work.vector( 0 );
+    value_t *shadow = work.vector( 1 );
+    value_t *p = work.vector( 2 );
+    value_t *v = work.vector( 3 );
+    value_t *s = work.vector( 4 );
+    value_t *t = work.vector( 5 );
+    value_t *p_buffer = work.vector( 6 );
+    value_t *s_buffer = work.vector( 7 );
+    value_t *solution = x.data();
+    SolverResult result;
+
+    residual( a, b.data(), solution, r );
+    result.residual_norm = norm( n, r );
+
+    if( result.residual_norm <= target )
+    {
+        result.converged = true;
+        return result;
+    }
+
+    std::copy( r, r + n, shadow );
+    std::fill( p, p + n, 0.0 );
+    std::fill( v, v + n, 0.0 );
+
+    value_t rho = 1.0;
+    value_t alpha = 1.0;
+    value_t omega = 1.0;
+
+    while( result.iterations < options.max_iterations )
+    {
+        const value_t next_rho = dot( n, shadow, r );
+
+        // Breakdown, the shadow residual became orthogonal to r
+        if( next_rho == 0.0 )
+        {
+            break;
+        }
+
+        const value_t beta = ( next_rho / rho ) * ( alpha / omega );
+
+        rho = next_rho;
+        elementwise( n, [=]( std::size_t i ) { p[i] = r[i] + beta * ( p[i] - omega * v[i] ); } );
+
+        value_t const *p_hat = precondition( options, p, p_buffer );
+
+        a.apply( p_hat, v );
+
+        const value_t projection = dot( n, shadow, v );
+
+        if( projection == 0.0 )
+        {
+            break;
+        }
+
+        alpha = rho / projection;
+        elementwise( n, [=]( std::size_t i ) { s[i] = r[i] - alpha * v[i]; } );
+        ++result.iterations;
+
+        const value_t s_norm = norm( n, s );
+
+        if( s_norm <= target )
+        {
+            elementwise( n, [=]( std::size_t i ) { solution[i] += alpha * p_hat[i]; } );
+            result.residual_norm = s_norm;
+            result.converged = true;
+            break;
+        }
+
+        value_t const *s_hat = precondition( options, s, s_buffer );
+
+        a.apply( s_hat, t );
+
+        const value_t t_norm = dot( n, t, t );
+
+        if( t_norm == 0.0 )
+        {
+            break;
+        }
+
+        omega = dot( n, t, s ) / t_norm;
+        elementwise( n, [=]( std::size_t i ) {
+            solution[i] += alpha * p_hat[i] + omega * s_hat[i];
+            r[i] = s[i] - omega * t[i];
+        } );
+
+        result.residual_norm = norm( n, r );
+
+        if( result.residual_norm <= target )
+        {
+            result.converged = true;
+            break;
+        }
+
+        if( omega == 0.0 )
+        {
+            break;
+        }
+    }
+
+    return result;
+}
+
+SolverResult gmres( LinearOperator const &a,
+                    std::vector< value_t > const &b,
+                    std::vector< value_t > &x,
+                    SolverOptions const &options,
+                    KrylovWorkspace *workspace )
+{
+    if( options.restart == 0 )
+    {
+        throw std::domain_error( "GMRES restart should be at least 1!" );
+    }
+
+    const value_t target = prepare( a, b, x, options );
+    const std::size_t n = b.size();
+    const std::size_t m = options.restart;
+    KrylovWorkspace local;
+    KrylovWorkspace &work = select_workspace( workspace, local );
+
+    // m + 1 basis vectors and one for preconditioned ones, then the
+    // Hessenberg matrix (m + 1 lines of m), rotations, rhs and solution
+    work.reserve( n, m + 2, ( m + 1 ) * m + 2 * m + ( m + 1 ) + m );
+
+    value_t *z = work.vector( m + 1 );
+    value_t *hessenberg = work.extra();
+    value_t *cosines = hessenberg + ( m + 1 ) * m;
+    value_t *sines = cosines + m;
+    value_t *g = sines + m;
+    value_t *y = g + m + 1;
+    value_t *solution = x.data();
+    SolverResult result;
+
+    auto h = [hessenberg, m]( std::size_t const &line, std::size_t const &column ) -> value_t & {
+        return hessenberg[line * m + column];
+    };
+
+    while( true )
+    {
+        value_t *first = work.vector( 0 );
+
+        residual( a, b.data(), solution, first );
+        result.residual_norm = norm( n, first );
+
+        if( result.residual_norm <= target )
+        {
+            result.converged = true;
+            break;
+        }
+
+        if( result.iterations >= options.max_iterations )
+        {
+            break;
+        }
+
+        const value_t scale = 1.0 / result.residual_norm;
+
+        elementwise( n, [=]( std::size_t i ) { first[i] *= scale; } );
+        std::fill( g, g + m + 1, 0.0 );
+        g[0] = result.residual_norm;
+
+        std::size_t columns = 0;
+
+        while( ( columns < m ) && ( result.iterations < options.max_iterations ) )
+        {
+            const std::size_t j = columns;
+            value_t *w = work.vector( j + 1 );
+
+            a.apply( precondition( options, work.vector( j ), z ), w );
+
+            // Modified Gram-Schmidt against the basis so far
+            for( std::size_t i = 0; i <= j; ++i )
+            {
+                value_t const *basis = work.vector( i );
+                const value_t projection = dot( n, w, basis );
+
+                h( i, j ) = projection;
+                elementwise( n, [=]( std::size_t k ) { w[k] -= projection * basis[k]; } );
+            }
+
+            const value_t w_norm = norm( n, w );
+
+            h( j + 1, j ) = w_norm;
+
+            if( w_norm != 0.0 )
+            {
+                const value_t inverse = 1.0 / w_norm;
+
+                elementwise( n, [=]( std::size_t k ) { w[k] *= inverse; } );
+            }
+
+            // Previous rotations, then the one zeroing h( j + 1, j )
+            for( std::size_t i = 0; i < j; ++i )
+            {
+                const value_t upper = h( i, j );
+                const value_t lower = h( i + 1, j );
+
+                h( i, j ) = cosines[i] * upper + sines[i] * lower;
+                h( i + 1, j ) = -sines[i] * upper + cosines[i] * lower;
+            }
+
+            const value_t radius = std::hypot( h( j, j ), h( j + 1, j ) );
+
+            cosines[j] = ( radius == 0.0 ) ? 1.0 : h( j, j ) / radius;
+            sines[j] = ( radius == 0.0 ) ? 0.0 : h( j + 1, j ) / radius;
+            h( j, j ) = radius;
+            h( j + 1, j ) = 0.0;
+            g[j + 1] = -sines[j] * g[j];
+            g[j] = cosines[j] * g[j];
+
+            ++columns;
+            ++result.iterations;
+            result.residual_norm = std::fabs( g[j + 1] );
+
+            // Converged, or the Krylov space became invariant
+            if( ( result.residual_norm <= target ) || ( w_norm == 0.0 ) )
+            {
+                break;
+            }
+        }
+
+        // Back substitution of the triangular system, skipping zero pivots
+        for( std::size_t i = columns; i-- > 0; )
+        {
+            value_t sum = g[i];
+
+            for( std::size_t k = i + 1; k < columns; ++k )
+            {
+                sum -= h( i, k ) * y[k];
+            }
+
+            y[i] = ( h( i, i ) == 0.0 ) ? 0.0 : sum / h( i, i );
+        }
+
+        // x += M^-1 * V y, V y is built in the last basis slot
+        value_t *update = work.vector( m );
+
+        std::fill( update, update + n, 0.0 );
+
+        for( std::size_t i = 0; i < columns; ++i )
+        {
+            value_t const *basis = work.vector( i );
+            const value_t factor = y[i];
+
+            elementwise( n, [=]( std::size_t k ) { update[k] += factor * basis[k]; } );
+        }
+
+        value_t const *correction = precondition( options, update, z );
+
+        elementwise( n, [=]( std::size_t k ) { solution[k] += correction[k]; } );
+
+        if( columns == 0 )
+        {
+            break;
+        }
+    }
+
+    return result;
+}
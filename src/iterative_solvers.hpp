@@ -0,0 +1,84 @@
+#ifndef ITERATIVE_SOLVERS_H
+#define ITERATIVE_SOLVERS_H
+
+#include <cstddef>
+#include <vector>
+
+#include "linear_operator.hpp"
+#include "preconditioners.hpp"
+
+struct SolverOptions
+{
+    // Stops once ||b - A x|| <= tolerance * ||b||
+    value_t tolerance = 1e-10;
+    unsigned int max_iterations = 1000;
+    // Krylov basis size of GMRES before restarting
+    unsigned int restart = 30;
+    // Not owned, nullptr for none
+    Preconditioner const *preconditioner = nullptr;
+};
+
+struct SolverResult
+{
+    bool converged = false;
+    unsigned int iterations = 0;
+    // Residual norm tracked by the method when it stopped
+    value_t residual_norm = 0.0;
+};
+
+// Work vectors of the iterative solvers in one contiguous buffer. Passing
+// the same workspace to every solve means the vectors are never allocated
+// again: buffers only grow, when a system is larger than any previous one.
+// Vectors past the parallel threshold still allocate the task state of
+// every chunk handed to the thread pool.
+class KrylovWorkspace
+{
+    public:
+    KrylovWorkspace( void );
+
+    // Room for count vectors of size values plus extra values
+    void reserve( std::size_t const &size, std::size_t const &count, std::size_t const &extra = 0 );
+
+    value_t *vector( std::size_t const &index );
+    value_t *extra( void );
+
+    // Number of times a buffer had to grow
+    std::size_t allocations( void ) const;
+
+    private:
+    std::size_t _size;
+    std::vector< value_t > _vectors;
+    std::vector< value_t > _extra;
+    std::size_t _allocations;
+};
+
+// Every solver starts from x (resized to zeros when it does not match b)
+// and leaves the approximation there. Matrix-vector products go through
+// the operator, vector updates and dot products are split over the thread
+// pool like the other element wise operations. Without a workspace a
+// temporary one is used.
+
+// Conjugate gradient, A (and the preconditioner) symmetric positive definite
+SolverResult conjugate_gradient( LinearOperator const &a,
+                                 std::vector< value_t > const &b,
+                                 std::vector< value_t > &x,
+                                 SolverOptions const &options = SolverOptions(),
+                                 KrylovWorkspace *workspace = nullptr );
+
+// BiCGSTAB for general A, right preconditioned
+SolverResult bicgstab( LinearOperator const &a,
+                       std::vector< value_t > const &b,
+                       std::vector< value_t > &x,
+                       SolverOptions const &options = SolverOptions(),
+                       KrylovWorkspace *workspace = nullptr );
+
+// Restarted GMRES(options.restart) for general A, right preconditioned.
+// Modified Gram-Schmidt with Givens rotations, the residual norm is known
+// at every step without forming x.
+SolverResult gmres( LinearOperator const &a,
+                    std::vector< value_t > const &b,
+                    std::vector< value_t > &x,
+                    SolverOptions const &options = SolverOptions(),
+                    KrylovWorkspace *workspace = nullptr );
+
+#endif
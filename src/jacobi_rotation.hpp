@@ -0,0 +1,33 @@
+#ifndef JACOBI_ROTATION_H
+#define JACOBI_ROTATION_H
+
+#include <cmath>
+
+#include "matrix.hpp"
+
+// Cyclic Jacobi methods (one-sided SVD, symmetric eigenproblem) converge
+// quadratically, they stop after this many sweeps whatever happens
+const unsigned int JACOBI_MAXIMUM_SWEEPS = 60;
+
+struct JacobiRotation
+{
+    value_t c;
+    value_t s;
+};
+
+// Rotation zeroing the off diagonal of the symmetric 2x2 [alpha gamma;
+// gamma beta], gamma != 0. The smaller angle is taken, |t| <= 1, which is
+// what makes the sweeps converge.
+inline JacobiRotation jacobi_rotation( value_t const &alpha,
+                                       value_t const &beta,
+                                       value_t const &gamma )
+{
+    const value_t zeta = ( beta - alpha ) / ( 2.0 * gamma );
+    const value_t t =
+        ( ( zeta >= 0.0 ) ? 1.0 : -1.0 ) / ( std::fabs( zeta ) + std::sqrt( 1.0 + zeta * zeta ) );
+    const value_t c = 1.0 / std::sqrt( 1.0 + t * t );
+
+    return JacobiRotation{c, c * t};
+}
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef KRYLOV_VECTORS_H
+#define KRYLOV_VECTORS_H
+
+#include <cmath>
+#include <cstddef>
+
+#include "iterative_solvers.hpp"
+#include "parallel.hpp"
+
+// Vector kernels shared by the Krylov methods (linear solvers and eigen
+// solvers). Vectors are raw buffers of size values, every pass is split
+// over the thread pool like the other element wise operations.
+
+// function( i ) for every i in [0, size)
+template < typename Function >
+void elementwise( std::size_t const &size, Function &&function )
+{
+    parallel_for( size, [&function]( std::size_t begin, std::size_t end ) {
+        for( std::size_t i = begin; i < end; ++i )
+        {
+            function( i );
+        }
+    } );
+}
+
+inline value_t dot( std::size_t const &size, value_t const *x, value_t const *y )
+{
+    return parallel_reduce( size,
+                            0.0,
+                            [x, y]( std::size_t begin, std::size_t end ) -> value_t {
+                                value_t sum = 0.0;
+
+                                for( std::size_t i = begin; i < end; ++i )
+                                {
+                                    sum += x[i] * y[i];
+                                }
+
+                                return sum;
+                            },
+                            []( value_t const &a, value_t const &b ) { return a + b; } );
+}
+
+inline value_t norm( std::size_t const &size, value_t const *x )
+{
+    return std::sqrt( dot( size, x, x ) );
+}
+
+// x *= factor
+inline void scale( std::size_t const &size, value_t const &factor, value_t *x )
+{
+    elementwise( size, [=]( std::size_t i ) { x[i] *= factor; } );
+}
+
+// The caller's workspace, or local when there is none
+inline KrylovWorkspace &select_workspace( KrylovWorkspace *workspace, KrylovWorkspace &local )
+{
+    return ( workspace != nullptr ) ? *workspace : local;
+}
+
+#endif
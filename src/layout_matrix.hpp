@@ -0,0 +1,434 @@
+#ifndef LAYOUT_MATRIX_H
+#define LAYOUT_MATRIX_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "matrix.hpp"
+
+// Storage layouts for LayoutMatrix. A layout maps (line, column) to an
+// offset in a flat buffer of size() values, and visit() calls
+// function(line, column, offset) for every position in storage order, which
+// is the cache friendly order to fill or read a matrix in. BLOCK is the
+// square block size that keeps blocked algorithms inside contiguous memory.
+
+// Plain line-major order, the same as Matrix
+class RowMajorLayout
+{
+    public:
+    static const position_t BLOCK = 64;
+
+    RowMajorLayout( position_t const &lines, position_t const &columns )
+        : _lines( lines )
+        , _columns( columns )
+    {
+    }
+
+    inline std::size_t size( void ) const
+    {
+        return static_cast< std::size_t >( _lines ) * _columns;
+    }
+
+    inline std::size_t offset( position_t const &line, position_t const &column ) const
+    {
+        return static_cast< std::size_t >( line ) * _columns + column;
+    }
+
+    template < typename Function >
+    void visit( Function &&function ) const
+    {
+        std::size_t offset = 0;
+
+        for( position_t i = 0; i < _lines; ++i )
+        {
+            for( position_t j = 0; j < _columns; ++j )
+            {
+                function( i, j, offset++ );
+            }
+        }
+    }
+
+    private:
+    position_t _lines;
+    position_t _columns;
+};
+
+// TILE x TILE tiles stored one after the other in line-major order, each
+// tile being line-major itself. Border tiles are padded to full size.
+// Lines and columns of a tile share the same few cache lines.
+template < position_t TILE = 64 >
+class TiledLayout
+{
+    public:
+    static const position_t BLOCK = TILE;
+
+    TiledLayout( position_t const &lines, position_t const &columns )
+        : _lines( lines )
+        , _columns( columns )
+        , _tile_lines( ( lines + TILE - 1 ) / TILE )
+        , _tile_columns( ( columns + TILE - 1 ) / TILE )
+    {
+    }
+
+    inline std::size_t size( void ) const
+    {
+        return static_cast< std::size_t >( _tile_lines ) * _tile_columns * TILE * TILE;
+    }
+
+    inline std::size_t offset( position_t const &line, position_t const &column ) const
+    {
+        const std::size_t tile =
+            static_cast< std::size_t >( line / TILE ) * _tile_columns + column / TILE;
+
+        return tile * TILE * TILE + ( line % TILE ) * TILE + ( column % TILE );
+    }
+
+    template < typename Function >
+    void visit( Function &&function ) const
+    {
+        for( position_t tile_line = 0; tile_line < _tile_lines; ++tile_line )
+        {
+            for( position_t tile_column = 0; tile_column < _tile_columns; ++tile_column )
+            {
+                const position_t first_line = tile_line * TILE;
+                const position_t first_column = tile_column * TILE;
+                const position_t last_line = std::min( first_line + TILE, _lines );
+                const position_t last_column = std::min( first_column + TILE, _columns );
+
+                for( position_t i = first_line; i < last_line; ++i )
+                {
+                    std::size_t offset = this->offset( i, first_column );
+
+                    for( position_t j = first_column; j < last_column; ++j )
+                    {
+                        function( i, j, offset++ );
+                    }
+                }
+            }
+        }
+    }
+
+    private:
+    position_t _lines;
+    position_t _columns;
+    position_t _tile_lines;
+    position_t _tile_columns;
+};
+
+// Z-order: bits of line and column are interleaved, so every aligned
+// 2^k x 2^k block is contiguous at every k and recursive algorithms get
+// locality at every level. Lines and columns are padded to powers of two;
+// the larger one is split in consecutive square Morton blocks, keeping the
+// padding under 4x the matrix size.
+class MortonLayout
+{
+    public:
+    static const position_t BLOCK = 32;
+
+    MortonLayout( position_t const &lines, position_t const &columns )
+        : _lines( lines )
+        , _columns( columns )
+        , _line_bits( bits_for( lines ) )
+        , _column_bits( bits_for( columns ) )
+        , _square_bits( std::min( _line_bits, _column_bits ) )
+    {
+    }
+
+    inline std::size_t size( void ) const
+    {
+        return std::size_t( 1 ) << ( _line_bits + _column_bits );
+    }
+
+    inline std::size_t offset( position_t const &line, position_t const &column ) const
+    {
+        const position_t mask = ( position_t( 1 ) << _square_bits ) - 1;
+        // Only one of the two is non zero
+        const std::size_t block = ( line >> _square_bits ) + ( column >> _square_bits );
+
+        return ( block << ( 2 * _square_bits ) ) |
+               ( dilate( line & mask ) << 1 ) | dilate( column & mask );
+    }
+
+    template < typename Function >
+    void visit( Function &&function ) const
+    {
+        const std::size_t block_size = std::size_t( 1 ) << ( 2 * _square_bits );
+        const std::size_t blocks = size() / block_size;
+
+        for( std::size_t block = 0; block < blocks; ++block )
+        {
+            const position_t first = static_cast< position_t >( block << _square_bits );
+            const position_t first_line = ( _line_bits > _square_bits ) ? first : 0;
+            const position_t first_column = ( _line_bits > _square_bits ) ? 0 : first;
+
+            for( std::size_t code = 0; code < block_size; ++code )
+            {
+                const position_t i = first_line + undilate( code >> 1 );
+                const position_t j = first_column + undilate( code );
+
+                if( ( i < _lines ) && ( j < _columns ) )
+                {
+                    function( i, j, block * block_size + code );
+                }
+            }
+        }
+    }
+
+    private:
+    position_t _lines;
+    position_t _columns;
+    unsigned int _line_bits;
+    unsigned int _column_bits;
+    unsigned int _square_bits;
+
+    static unsigned int bits_for( position_t const &count )
+    {
+        unsigned int bits = 0;
+
+        while( ( std::size_t( 1 ) << bits ) < count )
+        {
+            ++bits;
+        }
+
+        return bits;
+    }
+
+    // Spreads the bits of value over the even bits of the result
+    static inline std::size_t dilate( std::uint64_t value )
+    {
+        value = ( value | ( value << 16 ) ) & 0x0000FFFF0000FFFFull;
+        value = ( value | ( value << 8 ) ) & 0x00FF00FF00FF00FFull;
+        value = ( value | ( value << 4 ) ) & 0x0F0F0F0F0F0F0F0Full;
+        value = ( value | ( value << 2 ) ) & 0x3333333333333333ull;
+        value = ( value | ( value << 1 ) ) & 0x5555555555555555ull;
+
+        return static_cast< std::size_t >( value );
+    }
+
+    // Gathers the even bits of value
+    static inline position_t undilate( std::uint64_t value )
+    {
+        value &= 0x5555555555555555ull;
+        value = ( value | ( value >> 1 ) ) & 0x3333333333333333ull;
+        value = ( value | ( value >> 2 ) ) & 0x0F0F0F0F0F0F0F0Full;
+        value = ( value | ( value >> 4 ) ) & 0x00FF00FF00FF00FFull;
+        value = ( value | ( value >> 8 ) ) & 0x0000FFFF0000FFFFull;
+        value = ( value | ( value >> 16 ) ) & 0x00000000FFFFFFFFull;
+
+        return static_cast< position_t >( value );
+    }
+};
+
+// Dense matrix stored with a Layout policy. Matrix itself stays line-major
+// because its operator[] hands out raw line pointers; LayoutMatrix is the
+// type to use when column access or recursive blocking matters. Converting
+// from or to Matrix, or between layouts, walks the destination in storage
+// order.
+template < typename Layout >
+class LayoutMatrix
+{
+    public:
+    LayoutMatrix( void )
+        : _dimensions( 0, 0 )
+        , _layout( 0, 0 )
+    {
+    }
+
+    LayoutMatrix( position_t const &lines, position_t const &columns )
+        : _dimensions( lines, columns )
+        , _layout( lines, columns )
+        , _values( _layout.size(), 0.0 )
+    {
+    }
+
+    explicit LayoutMatrix( Matrix const &matrix )
+        : LayoutMatrix( matrix.dimensions().first, matrix.dimensions().second )
+    {
+        _layout.visit( [this, &matrix]( position_t const &i,
+                                        position_t const &j,
+                                        std::size_t const &offset ) {
+            _values[offset] = matrix[i][j];
+        } );
+    }
+
+    template < typename OtherLayout >
+    explicit LayoutMatrix( LayoutMatrix< OtherLayout > const &other )
+        : LayoutMatrix( other.dimensions().first, other.dimensions().second )
+    {
+        _layout.visit( [this, &other]( position_t const &i,
+                                       position_t const &j,
+                                       std::size_t const &offset ) {
+            _values[offset] = other( i, j );
+        } );
+    }
+
+    MatrixDimensions dimensions( void ) const
+    {
+        return _dimensions;
+    }
+
+    Layout const &layout( void ) const
+    {
+        return _layout;
+    }
+
+    // Unchecked access
+    inline value_t &operator()( position_t const &line, position_t const &column )
+    {
+        return _values[_layout.offset( line, column )];
+    }
+
+    inline value_t const &operator()( position_t const &line, position_t const &column ) const
+    {
+        return _values[_layout.offset( line, column )];
+    }
+
+    value_t &element( position_t const &line, position_t const &column )
+    {
+        assert_position( line, column );
+
+        return ( *this )( line, column );
+    }
+
+    value_t const &element( position_t const &line, position_t const &column ) const
+    {
+        assert_position( line, column );
+
+        return ( *this )( line, column );
+    }
+
+    std::vector< value_t > line( position_t const &position ) const
+    {
+        std::vector< value_t > values( _dimensions.second );
+
+        assert_position( position, 0 );
+
+        for( position_t j = 0; j < _dimensions.second; ++j )
+        {
+            values[j] = ( *this )( position, j );
+        }
+
+        return values;
+    }
+
+    std::vector< value_t > column( position_t const &position ) const
+    {
+        std::vector< value_t > values( _dimensions.first );
+
+        assert_position( 0, position );
+
+        for( position_t i = 0; i < _dimensions.first; ++i )
+        {
+            values[i] = ( *this )( i, position );
+        }
+
+        return values;
+    }
+
+    Matrix to_matrix( void ) const
+    {
+        Matrix result;
+
+        result.reset_dimensions( _dimensions.first, _dimensions.second );
+
+        if( _values.empty() )
+        {
+            return result;
+        }
+
+        value_t *data = result[0];
+        const position_t columns = _dimensions.second;
+
+        _layout.visit( [this, data, columns]( position_t const &i,
+                                              position_t const &j,
+                                              std::size_t const &offset ) {
+            data[static_cast< std::size_t >( i ) * columns + j] = _values[offset];
+        } );
+
+        return result;
+    }
+
+    LayoutMatrix< Layout > transposed( void ) const
+    {
+        LayoutMatrix< Layout > result( _dimensions.second, _dimensions.first );
+
+        result._layout.visit( [this, &result]( position_t const &i,
+                                                position_t const &j,
+                                                std::size_t const &offset ) {
+            result._values[offset] = ( *this )( j, i );
+        } );
+
+        return result;
+    }
+
+    // Blocked product, every block of the three operands fits in cache
+    LayoutMatrix< Layout > operator*( LayoutMatrix< Layout > const &other ) const
+    {
+        const position_t m = _dimensions.first;
+        const position_t k = _dimensions.second;
+        const position_t n = other._dimensions.second;
+        const position_t block = Layout::BLOCK;
+
+        if( k != other._dimensions.first )
+        {
+            throw std::domain_error(
+                "First matrix column count differs from second matrix lines count!" );
+        }
+
+        LayoutMatrix< Layout > result( m, n );
+
+        for( position_t line_block = 0; line_block < m; line_block += block )
+        {
+            const position_t line_end = std::min( line_block + block, m );
+
+            for( position_t inner_block = 0; inner_block < k; inner_block += block )
+            {
+                const position_t inner_end = std::min( inner_block + block, k );
+
+                for( position_t column_block = 0; column_block < n; column_block += block )
+                {
+                    const position_t column_end = std::min( column_block + block, n );
+
+                    for( position_t i = line_block; i < line_end; ++i )
+                    {
+                        for( position_t p = inner_block; p < inner_end; ++p )
+                        {
+                            const value_t factor = ( *this )( i, p );
+
+                            for( position_t j = column_block; j < column_end; ++j )
+                            {
+                                result( i, j ) += factor * other( p, j );
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        return result;
+    }
+
+    private:
+    template < typename OtherLayout >
+    friend class LayoutMatrix;
+
+    MatrixDimensions _dimensions;
+    Layout _layout;
+    std::vector< value_t > _values;
+
+    void assert_position( position_t const &line, position_t const &column ) const
+    {
+        if( ( line >= _dimensions.first ) || ( column >= _dimensions.second ) )
+        {
+            throw std::out_of_range( "Matrix position out of range!" );
+        }
+    }
+};
+
+typedef LayoutMatrix< TiledLayout<> > TiledMatrix;
+typedef LayoutMatrix< MortonLayout > MortonMatrix;
+
+#endif
@@ -0,0 +1,55 @@
+#include "linear_operator.hpp"
+#include <stdexcept>
+#include <utility>
+
+#include "gemm.hpp"
+#include "matrix_view.hpp"
+
+namespace
+{
+void assert_square( MatrixDimensions const &dimensions )
+{
+    if( dimensions.first != dimensions.second )
+    {
+        throw std::domain_error( "Operator matrix should be square!" );
+    }
+}
+}
+
+LinearOperator::LinearOperator( Matrix const &matrix )
+    : _size( matrix.dimensions().first )
+{
+    assert_square( matrix.dimensions() );
+
+    _function = [&matrix]( value_t const *x, value_t *y ) {
+        gemv( 1.0, MatrixView( matrix ), x, 0.0, y );
+    };
+}
+
+LinearOperator::LinearOperator( SparseMatrix const &matrix )
+    : _size( matrix.dimensions().first )
+{
+    assert_square( matrix.dimensions() );
+
+    _function = [&matrix]( value_t const *x, value_t *y ) { matrix.multiply( x, y ); };
+}
+
+LinearOperator::LinearOperator( position_t const &size, Function function )
+    : _size( size )
+    , _function( std::move( function ) )
+{
+    if( !_function )
+    {
+        throw std::domain_error( "Operator function is empty!" );
+    }
+}
+
+position_t LinearOperator::size( void ) const
+{
+    return _size;
+}
+
+void LinearOperator::apply( value_t const *x, value_t *y ) const
+{
+    _function( x, y );
+}
@@ -0,0 +1,31 @@
+#ifndef LINEAR_OPERATOR_H
+#define LINEAR_OPERATOR_H
+
+#include <functional>
+
+#include "matrix.hpp"
+#include "sparse_matrix.hpp"
+
+// Square operator known only through y = A * x. Built from a Matrix, a
+// SparseMatrix (both are referenced, not copied, and must outlive the
+// operator) or any callable, so iterative methods never need the matrix
+// itself.
+class LinearOperator
+{
+    public:
+    // function( x, y ) writes A * x into y, y never overlaps x
+    typedef std::function< void( value_t const *, value_t * ) > Function;
+
+    LinearOperator( Matrix const &matrix );
+    LinearOperator( SparseMatrix const &matrix );
+    LinearOperator( position_t const &size, Function function );
+
+    position_t size( void ) const;
+    void apply( value_t const *x, value_t *y ) const;
+
+    private:
+    position_t _size;
+    Function _function;
+};
+
+#endif
@@ -0,0 +1,320 @@
+#include "lu_decomposition.hpp"
+#include "condition_estimate.hpp"
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+LUDecomposition::LUDecomposition( Matrix const &matrix )
+    : LUDecomposition( matrix, nullptr )
+{
+}
+
+LUDecomposition::LUDecomposition( Matrix const &matrix,
+                                  std::function< void( position_t const & ) > const &on_step )
+    : _factors( matrix )
+    , _pivot_sign( 1 )
+    , _singular( false )
+    , _norm1( 0.0 )
+    , _max_absolute( 0.0 )
+{
+    const position_t size = matrix.dimensions().first;
+
+    if( size != matrix.dimensions().second )
+    {
+        throw std::domain_error( "LU decomposition is only defined for square matrixes!" );
+    }
+
+    _norm1 = norm1( matrix );
+    _max_absolute = matrix.reduce().linf_norm();
+
+    _pivots.resize( size );
+
+    for( position_t k = 0; k < size; ++k )
+    {
+        if( on_step )
+        {
+            on_step( k );
+        }
+
+        position_t pivot = k;
+        value_t largest = std::fabs( _factors[k][k] );
+
+        for( position_t i = k + 1; i < size; ++i )
+        {
+            if( std::fabs( _factors[i][k] ) > largest )
+            {
+                largest = std::fabs( _factors[i][k] );
+                pivot = i;
+            }
+        }
+
+        _pivots[k] = pivot;
+
+        if( pivot != k )
+        {
+            std::swap_ranges( _factors[k], _factors[k] + size, _factors[pivot] );
+            _pivot_sign = -_pivot_sign;
+        }
+
+        if( largest == 0.0 )
+        {
+            _singular = true;
+            continue;
+        }
+
+        value_t const *pivot_line = _factors[k];
+
+        for( position_t i = k + 1; i < size; ++i )
+        {
+            value_t *line = _factors[i];
+            const value_t factor = line[k] / pivot_line[k];
+
+            line[k] = factor;
+
+            for( position_t j = k + 1; j < size; ++j )
+            {
+                line[j] -= factor * pivot_line[j];
+            }
+        }
+    }
+}
+
+bool LUDecomposition::is_singular( void ) const
+{
+    return _singular;
+}
+
+value_t LUDecomposition::determinant( void ) const
+{
+    value_t result = _pivot_sign;
+
+    for( position_t i = 0; i < _pivots.size(); ++i )
+    {
+        result *= _factors[i][i];
+    }
+
+    return result;
+}
+
+std::vector< value_t > LUDecomposition::solve( std::vector< value_t > const &rhs ) const
+{
+    std::vector< value_t > result( rhs );
+
+    if( rhs.size() != _pivots.size() )
+    {
+        throw std::domain_error( "Right hand side size differs from matrix size!" );
+    }
+
+    assert_invertible();
+    solve_in_place( result.data() );
+
+    return result;
+}
+
+Matrix LUDecomposition::solve( Matrix const &rhs ) const
+{
+    const position_t size = _pivots.size();
+    const position_t columns = rhs.dimensions().second;
+    std::vector< value_t > column_values( size );
+    Matrix result;
+
+    if( rhs.dimensions().first != size )
+    {
+        throw std::domain_error( "Right hand side line count differs from matrix size!" );
+    }
+
+    assert_invertible();
+    result.reset_dimensions( size, columns );
+
+    for( position_t column = 0; column < columns; ++column )
+    {
+        for( position_t i = 0; i < size; ++i )
+        {
+            column_values[i] = rhs[i][column];
+        }
+
+        solve_in_place( column_values.data() );
+
+        for( position_t i = 0; i < size; ++i )
+        {
+            result[i][column] = column_values[i];
+        }
+    }
+
+    return result;
+}
+
+std::vector< value_t > LUDecomposition::solve_transposed( std::vector< value_t > const &rhs ) const
+{
+    std::vector< value_t > result( rhs );
+
+    if( rhs.size() != _pivots.size() )
+    {
+        throw std::domain_error( "Right hand side size differs from matrix size!" );
+    }
+
+    assert_invertible();
+    solve_transposed_in_place( result.data() );
+
+    return result;
+}
+
+Matrix LUDecomposition::inverse( void ) const
+{
+    const position_t size = _pivots.size();
+
+    return solve( Matrix::identity_matrix( size, size ) );
+}
+
+value_t LUDecomposition::condition_estimate( void ) const
+{
+    if( _singular )
+    {
+        return std::numeric_limits< value_t >::infinity();
+    }
+
+    const value_t inverse_norm =
+        estimate_inverse_norm1( _pivots.size(),
+                                [this]( value_t *values ) { solve_in_place( values ); },
+                                [this]( value_t *values ) { solve_transposed_in_place( values ); } );
+
+    return _norm1 * inverse_norm;
+}
+
+value_t LUDecomposition::reciprocal_condition( void ) const
+{
+    const value_t condition = condition_estimate();
+
+    return ( condition > 0.0 ) ? 1.0 / condition : 0.0;
+}
+
+void LUDecomposition::assert_well_conditioned( void ) const
+{
+    if( reciprocal_condition() < std::numeric_limits< value_t >::epsilon() )
+    {
+        throw std::domain_error(
+            "Matrix is singular to working precision, it is too ill-conditioned to invert!" );
+    }
+}
+
+PivotStatistics LUDecomposition::pivot_statistics( void ) const
+{
+    const position_t size = _pivots.size();
+    PivotStatistics statistics;
+    value_t largest_u = 0.0;
+
+    if( size == 0 )
+    {
+        return statistics;
+    }
+
+    statistics.smallest_pivot = std::numeric_limits< value_t >::infinity();
+
+    for( position_t i = 0; i < size; ++i )
+    {
+        value_t const *line = _factors[i];
+        const value_t pivot = std::fabs( line[i] );
+
+        statistics.smallest_pivot = std::min( statistics.smallest_pivot, pivot );
+        statistics.largest_pivot = std::max( statistics.largest_pivot, pivot );
+
+        for( position_t j = i; j < size; ++j )
+        {
+            largest_u = std::max( largest_u, std::fabs( line[j] ) );
+        }
+    }
+
+    statistics.growth_factor = ( _max_absolute > 0.0 ) ? largest_u / _max_absolute : 0.0;
+
+    return statistics;
+}
+
+Matrix const &LUDecomposition::factors( void ) const
+{
+    return _factors;
+}
+
+std::vector< position_t > const &LUDecomposition::pivots( void ) const
+{
+    return _pivots;
+}
+
+void LUDecomposition::solve_in_place( value_t *values ) const
+{
+    const position_t size = _pivots.size();
+
+    for( position_t i = 0; i < size; ++i )
+    {
+        std::swap( values[i], values[_pivots[i]] );
+    }
+
+    for( position_t i = 0; i < size; ++i )
+    {
+        value_t const *line = _factors[i];
+        value_t sum = values[i];
+
+        for( position_t j = 0; j < i; ++j )
+        {
+            sum -= line[j] * values[j];
+        }
+
+        values[i] = sum;
+    }
+
+    for( position_t i = size; i-- > 0; )
+    {
+        value_t const *line = _factors[i];
+        value_t sum = values[i];
+
+        for( position_t j = i + 1; j < size; ++j )
+        {
+            sum -= line[j] * values[j];
+        }
+
+        values[i] = sum / line[i];
+    }
+}
+
+// A^T = U^T L^T P: forward with U^T, back with the unit L^T, then undo the
+// line swaps in reverse order
+void LUDecomposition::solve_transposed_in_place( value_t *values ) const
+{
+    const position_t size = _pivots.size();
+
+    for( position_t i = 0; i < size; ++i )
+    {
+        value_t sum = values[i];
+
+        for( position_t j = 0; j < i; ++j )
+        {
+            sum -= _factors[j][i] * values[j];
+        }
+
+        values[i] = sum / _factors[i][i];
+    }
+
+    for( position_t i = size; i-- > 0; )
+    {
+        value_t sum = values[i];
+
+        for( position_t j = i + 1; j < size; ++j )
+        {
+            sum -= _factors[j][i] * values[j];
+        }
+
+        values[i] = sum;
+    }
+
+    for( position_t i = size; i-- > 0; )
+    {
+        std::swap( values[i], values[_pivots[i]] );
+    }
+}
+
+void LUDecomposition::assert_invertible( void ) const
+{
+    if( _singular )
+    {
+        throw std::domain_error( "Matrix is singular, system has no unique solution!" );
+    }
+}
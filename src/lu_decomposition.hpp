@@ -0,0 +1,65 @@
+#ifndef LU_DECOMPOSITION_H
+#define LU_DECOMPOSITION_H
+
+#include <functional>
+#include <vector>
+
+#include "matrix.hpp"
+
+struct PivotStatistics
+{
+    // max |U| / max |A|, large values mean the elimination lost accuracy
+    value_t growth_factor = 0.0;
+    // Absolute values of the diagonal of U
+    value_t smallest_pivot = 0.0;
+    value_t largest_pivot = 0.0;
+};
+
+// PA = LU factorization with partial pivoting.
+// L (unit diagonal) and U are stored together in a single matrix.
+class LUDecomposition
+{
+    public:
+    LUDecomposition( Matrix const &matrix );
+    // on_step is called before eliminating each column, it may throw to abort
+    LUDecomposition( Matrix const &matrix,
+                     std::function< void( position_t const & ) > const &on_step );
+
+    bool is_singular( void ) const;
+    value_t determinant( void ) const;
+
+    std::vector< value_t > solve( std::vector< value_t > const &rhs ) const;
+    Matrix solve( Matrix const &rhs ) const;
+    // Solves A^T x = rhs with the same factors
+    std::vector< value_t > solve_transposed( std::vector< value_t > const &rhs ) const;
+    Matrix inverse( void ) const;
+
+    // Estimate of the 1-norm condition number ||A||_1 * ||A^-1||_1 in
+    // O(n^2), infinity when singular
+    value_t condition_estimate( void ) const;
+    // 1 / condition_estimate(), 0 when singular. Values near machine
+    // epsilon mean solutions may have no correct digits.
+    value_t reciprocal_condition( void ) const;
+    // Throws std::domain_error when reciprocal_condition() is below machine
+    // epsilon, singular to working precision whatever the scaling
+    void assert_well_conditioned( void ) const;
+    PivotStatistics pivot_statistics( void ) const;
+
+    Matrix const &factors( void ) const;
+    std::vector< position_t > const &pivots( void ) const;
+
+    private:
+    Matrix _factors;
+    std::vector< position_t > _pivots;
+    int _pivot_sign;
+    bool _singular;
+    // Of the factored matrix, kept for the condition estimate and growth
+    value_t _norm1;
+    value_t _max_absolute;
+
+    void solve_in_place( value_t *values ) const;
+    void solve_transposed_in_place( value_t *values ) const;
+    void assert_invertible( void ) const;
+};
+
+#endif
@@ -0,0 +1,304 @@
+#include "maintained_inverse.hpp"
+#include "lu_decomposition.hpp"
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+MaintainedInverse::MaintainedInverse( Matrix const &matrix, DriftOptions const &options )
+    : _matrix( matrix )
+    , _determinant( 0.0 )
+    , _options( options )
+    , _updates_since_refactor( 0 )
+    , _refactorizations( 0 )
+    , _last_drift( 0.0 )
+{
+    if( _matrix.dimensions().first != _matrix.dimensions().second )
+    {
+        throw std::domain_error( "Matrix should be square to have an inverse!" );
+    }
+
+    refactor();
+
+    _refactorizations = 0;
+}
+
+Matrix const &MaintainedInverse::matrix( void ) const
+{
+    return _matrix;
+}
+
+Matrix const &MaintainedInverse::inverse( void ) const
+{
+    return _inverse;
+}
+
+value_t MaintainedInverse::determinant( void ) const
+{
+    return _determinant;
+}
+
+void MaintainedInverse::rank_one_update( std::vector< value_t > const &u,
+                                         std::vector< value_t > const &v )
+{
+    apply_rank_one( u, v, 1.0 );
+}
+
+void MaintainedInverse::rank_one_downdate( std::vector< value_t > const &u,
+                                           std::vector< value_t > const &v )
+{
+    apply_rank_one( u, v, -1.0 );
+}
+
+void MaintainedInverse::rank_k_update( Matrix const &u, Matrix const &v )
+{
+    apply_rank_k( u, v, 1.0 );
+}
+
+void MaintainedInverse::rank_k_downdate( Matrix const &u, Matrix const &v )
+{
+    apply_rank_k( u, v, -1.0 );
+}
+
+void MaintainedInverse::replace_line( position_t const &line, std::vector< value_t > const &values )
+{
+    const position_t size = _matrix.dimensions().first;
+    std::vector< value_t > u( size, 0.0 );
+    std::vector< value_t > v( values );
+
+    assert_vector_size( values );
+
+    if( line >= size )
+    {
+        throw std::out_of_range( "Line out of range!" );
+    }
+
+    u[line] = 1.0;
+
+    for( position_t j = 0; j < size; ++j )
+    {
+        v[j] -= _matrix[line][j];
+    }
+
+    apply_rank_one( u, v, 1.0 );
+}
+
+void MaintainedInverse::replace_column( position_t const &column,
+                                        std::vector< value_t > const &values )
+{
+    const position_t size = _matrix.dimensions().first;
+    std::vector< value_t > u( values );
+    std::vector< value_t > v( size, 0.0 );
+
+    assert_vector_size( values );
+
+    if( column >= size )
+    {
+        throw std::out_of_range( "Column out of range!" );
+    }
+
+    v[column] = 1.0;
+
+    for( position_t i = 0; i < size; ++i )
+    {
+        u[i] -= _matrix[i][column];
+    }
+
+    apply_rank_one( u, v, 1.0 );
+}
+
+void MaintainedInverse::refactor( void )
+{
+    LUDecomposition lu( _matrix );
+
+    if( lu.is_singular() )
+    {
+        throw std::domain_error( "Matrix is singular and has no inverse!" );
+    }
+
+    _inverse = lu.inverse();
+    _determinant = lu.determinant();
+    _updates_since_refactor = 0;
+    _last_drift = 0.0;
+    ++_refactorizations;
+}
+
+unsigned int MaintainedInverse::refactorizations( void ) const
+{
+    return _refactorizations;
+}
+
+value_t MaintainedInverse::last_drift( void ) const
+{
+    return _last_drift;
+}
+
+void MaintainedInverse::apply_rank_one( std::vector< value_t > const &u,
+                                        std::vector< value_t > const &v,
+                                        value_t const &sign )
+{
+    const position_t size = _matrix.dimensions().first;
+    value_t denominator = 0.0;
+
+    assert_vector_size( u );
+    assert_vector_size( v );
+
+    _inverse_u.assign( size, 0.0 );
+    _v_inverse.assign( size, 0.0 );
+
+    for( position_t i = 0; i < size; ++i )
+    {
+        value_t const *line = _inverse[i];
+        value_t sum = 0.0;
+
+        for( position_t j = 0; j < size; ++j )
+        {
+            sum += line[j] * u[j];
+            _v_inverse[j] += v[i] * line[j];
+        }
+
+        _inverse_u[i] = sum;
+    }
+
+    for( position_t i = 0; i < size; ++i )
+    {
+        denominator += v[i] * _inverse_u[i];
+    }
+
+    // Matrix determinant lemma: det(A + uv^T) = det(A) * (1 + v^T A^-1 u)
+    denominator = 1.0 + sign * denominator;
+
+    if( std::fabs( denominator ) <= std::numeric_limits< value_t >::epsilon() )
+    {
+        throw std::domain_error( "Update would make the matrix singular!" );
+    }
+
+    const value_t factor = sign / denominator;
+
+    for( position_t i = 0; i < size; ++i )
+    {
+        value_t *inverse_line = _inverse[i];
+        value_t *matrix_line = _matrix[i];
+        const value_t scaled_inverse_u = factor * _inverse_u[i];
+        const value_t scaled_u = sign * u[i];
+
+        for( position_t j = 0; j < size; ++j )
+        {
+            inverse_line[j] -= scaled_inverse_u * _v_inverse[j];
+            matrix_line[j] += scaled_u * v[j];
+        }
+    }
+
+    _determinant *= denominator;
+
+    after_update();
+}
+
+void MaintainedInverse::apply_rank_k( Matrix const &u, Matrix const &v, value_t const &sign )
+{
+    const position_t size = _matrix.dimensions().first;
+    const position_t rank = u.dimensions().second;
+
+    if( ( u.dimensions().first != size ) || ( v.dimensions().first != size ) ||
+        ( v.dimensions().second != rank ) )
+    {
+        throw std::domain_error( "Update matrixes should both be NxK!" );
+    }
+
+    Matrix v_transposed = v.transposed();
+    Matrix inverse_u = _inverse * u;
+    Matrix v_inverse = v_transposed * _inverse;
+
+    // Capacitance matrix: I + sign * V^T A^-1 U
+    Matrix capacitance = ( v_transposed * inverse_u ) * sign;
+
+    for( position_t i = 0; i < rank; ++i )
+    {
+        capacitance[i][i] += 1.0;
+    }
+
+    LUDecomposition lu( capacitance );
+
+    if( lu.is_singular() )
+    {
+        throw std::domain_error( "Update would make the matrix singular!" );
+    }
+
+    Matrix correction = inverse_u * lu.solve( v_inverse );
+
+    for( position_t i = 0; i < size; ++i )
+    {
+        for( position_t j = 0; j < size; ++j )
+        {
+            value_t sum = 0.0;
+
+            for( position_t k = 0; k < rank; ++k )
+            {
+                sum += u[i][k] * v[j][k];
+            }
+
+            _inverse[i][j] -= sign * correction[i][j];
+            _matrix[i][j] += sign * sum;
+        }
+    }
+
+    _determinant *= lu.determinant();
+
+    after_update();
+}
+
+void MaintainedInverse::after_update( void )
+{
+    const position_t size = _matrix.dimensions().first;
+
+    ++_updates_since_refactor;
+
+    if( ( _options.refactor_interval != 0 ) &&
+        ( _updates_since_refactor >= _options.refactor_interval ) )
+    {
+        refactor();
+        return;
+    }
+
+    if( ( _options.check_interval == 0 ) ||
+        ( ( _updates_since_refactor % _options.check_interval ) != 0 ) )
+    {
+        return;
+    }
+
+    _last_drift = probe_drift( _updates_since_refactor % size );
+
+    if( _last_drift > _options.tolerance )
+    {
+        refactor();
+    }
+}
+
+// Checks one column of A * A^-1 against the identity in O(n^2)
+value_t MaintainedInverse::probe_drift( position_t const &column ) const
+{
+    const position_t size = _matrix.dimensions().first;
+    value_t drift = 0.0;
+
+    for( position_t i = 0; i < size; ++i )
+    {
+        value_t const *line = _matrix[i];
+        value_t sum = ( i == column ) ? -1.0 : 0.0;
+
+        for( position_t j = 0; j < size; ++j )
+        {
+            sum += line[j] * _inverse[j][column];
+        }
+
+        drift = std::max( drift, std::fabs( sum ) );
+    }
+
+    return drift;
+}
+
+void MaintainedInverse::assert_vector_size( std::vector< value_t > const &values ) const
+{
+    if( values.size() != _matrix.dimensions().first )
+    {
+        throw std::domain_error( "Update vector size differs from matrix size!" );
+    }
+}
@@ -0,0 +1,70 @@
+#ifndef MAINTAINED_INVERSE_H
+#define MAINTAINED_INVERSE_H
+
+#include <vector>
+
+#include "matrix.hpp"
+
+struct DriftOptions
+{
+    // Largest accepted |A * inverse - I| entry on the probed column
+    value_t tolerance = 1e-8;
+    // Probe one column every check_interval updates (0 disables probing)
+    unsigned int check_interval = 1;
+    // Force a full refactorization after this many updates (0 disables it)
+    unsigned int refactor_interval = 0;
+};
+
+// Keeps the inverse and determinant of a square matrix up to date under
+// low rank changes, using Sherman-Morrison/Woodbury for the inverse and the
+// matrix determinant lemma for the determinant. Every update costs
+// O(n^2 * k) instead of a full O(n^3) refactorization.
+class MaintainedInverse
+{
+    public:
+    MaintainedInverse( Matrix const &matrix, DriftOptions const &options = DriftOptions() );
+
+    Matrix const &matrix( void ) const;
+    Matrix const &inverse( void ) const;
+    value_t determinant( void ) const;
+
+    // A += u * v^T
+    void rank_one_update( std::vector< value_t > const &u, std::vector< value_t > const &v );
+    // A -= u * v^T
+    void rank_one_downdate( std::vector< value_t > const &u, std::vector< value_t > const &v );
+    // A += U * V^T, with U and V being n x k
+    void rank_k_update( Matrix const &u, Matrix const &v );
+    // A -= U * V^T
+    void rank_k_downdate( Matrix const &u, Matrix const &v );
+
+    void replace_line( position_t const &line, std::vector< value_t > const &values );
+    void replace_column( position_t const &column, std::vector< value_t > const &values );
+
+    void refactor( void );
+
+    unsigned int refactorizations( void ) const;
+    value_t last_drift( void ) const;
+
+    private:
+    Matrix _matrix;
+    Matrix _inverse;
+    value_t _determinant;
+    DriftOptions _options;
+    unsigned int _updates_since_refactor;
+    unsigned int _refactorizations;
+    value_t _last_drift;
+
+    // Workspace reused between updates
+    std::vector< value_t > _inverse_u;
+    std::vector< value_t > _v_inverse;
+
+    void apply_rank_one( std::vector< value_t > const &u,
+                         std::vector< value_t > const &v,
+                         value_t const &sign );
+    void apply_rank_k( Matrix const &u, Matrix const &v, value_t const &sign );
+    void after_update( void );
+    value_t probe_drift( position_t const &column ) const;
+    void assert_vector_size( std::vector< value_t > const &values ) const;
+};
+
+#endif
@@ -1,4 +1,6 @@
 #include "matrix.hpp"
+#include "gemm.hpp"
+#include "lu_decomposition.hpp"
 #include <cmath>
 #include <stdexcept>
 
@@ -11,21 +13,25 @@ using std::endl;
 
 Matrix::Matrix( void )
     : _dimensions( std::make_pair( 0, 0 ) )
+    , _data( _inline )
+    , _copy_on_write( false )
 {
 }
 
 Matrix::Matrix( Matrix const &other )
     : _dimensions( std::make_pair( 0, 0 ) )
+    , _data( _inline )
+    , _copy_on_write( false )
 {
-    reset_dimensions( other.dimensions().first, other.dimensions().second );
+    copy_from( other );
+}
 
-    for( position_t line = 0; line < _dimensions.first; ++line )
-    {
-        for( position_t column = 0; column < _dimensions.first; ++column )
-        {
-            ( *this )[line][column] = other[line][column];
-        }
-    }
+Matrix::Matrix( Matrix &&other ) noexcept
+    : _dimensions( std::make_pair( 0, 0 ) )
+    , _data( _inline )
+    , _copy_on_write( false )
+{
+    ( *this ) = std::move( other );
 }
 
 void Matrix::set( std::initializer_list< value_t > values,
@@ -73,7 +79,22 @@ Matrix Matrix::generate_minor( position_t const &line, position_t const &column
 
 void Matrix::reset_dimensions( position_t const &lines, position_t const &columns )
 {
-    _data.reset( new value_t[lines * columns] );
+    const std::size_t count = static_cast< std::size_t >( lines ) * columns;
+
+    if( count <= INLINE_CAPACITY )
+    {
+        _heap.reset();
+        _data = _inline;
+    }
+    else if( ( _heap.use_count() == 1 ) && ( count == element_count() ) )
+    {
+        // Same size and not shared, the current buffer can be reused
+    }
+    else
+    {
+        _heap.reset( new value_t[count], std::default_delete< value_t[] >() );
+        _data = _heap.get();
+    }
 
     _dimensions.first = lines;
     _dimensions.second = columns;
@@ -84,6 +105,31 @@ MatrixDimensions Matrix::dimensions( void ) const
     return _dimensions;
 }
 
+void Matrix::set_copy_on_write( bool const &enabled )
+{
+    if( !enabled )
+    {
+        detach();
+    }
+
+    _copy_on_write = enabled;
+}
+
+bool Matrix::copy_on_write( void ) const
+{
+    return _copy_on_write;
+}
+
+bool Matrix::shares_data_with( Matrix const &other ) const
+{
+    return ( _heap != nullptr ) && ( _heap == other._heap );
+}
+
+bool Matrix::uses_inline_storage( void ) const
+{
+    return _data == _inline;
+}
+
 value_t Matrix::determinant( void ) const
 {
     value_t result = 0.0;
@@ -174,17 +220,39 @@ void Matrix::assert_dimensions_match( Matrix const &other ) const
 Matrix Matrix::transposed( void ) const
 {
     Matrix transposed;
+
     transposed.reset_dimensions( _dimensions.second, _dimensions.first );
+    transpose_buffer( _data, transposed._data, _dimensions.first, _dimensions.second );
 
-    for( position_t i = 0; i < _dimensions.first; ++i )
+    return transposed;
+}
+
+void transpose_buffer( value_t const *source,
+                       value_t *target,
+                       position_t const &lines,
+                       position_t const &columns )
+{
+    // Square blocks keep both the lines read and the lines written in cache
+    const position_t block = 32;
+
+    for( position_t line_block = 0; line_block < lines; line_block += block )
     {
-        for( position_t j = 0; j < _dimensions.second; ++j )
+        const position_t line_end = std::min( line_block + block, lines );
+
+        for( position_t column_block = 0; column_block < columns; column_block += block )
         {
-            transposed[j][i] = ( *this )[i][j];
+            const position_t column_end = std::min( column_block + block, columns );
+
+            for( position_t i = line_block; i < line_end; ++i )
+            {
+                for( position_t j = column_block; j < column_end; ++j )
+                {
+                    target[static_cast< std::size_t >( j ) * lines + i] =
+                        source[static_cast< std::size_t >( i ) * columns + j];
+                }
+            }
         }
     }
-
-    return transposed;
 }
 
 Matrix &Matrix::transpose( void )
@@ -217,27 +285,96 @@ Matrix Matrix::cofactor_matrix( void )
 
 Matrix Matrix::adjoint_matrix( void )
 {
-    return this->cofactor_matrix().transpose();
+    Matrix adjoint;
+
+    adjoint.reset_dimensions( _dimensions.second, _dimensions.first );
+
+    // Cofactors are written straight to their transposed position
+    for( position_t i = 0; i < _dimensions.first; ++i )
+    {
+        for( position_t j = 0; j < _dimensions.second; ++j )
+        {
+            const value_t minor = this->generate_minor( i, j ).determinant();
+
+            adjoint[j][i] = ( ( ( i + j ) % 2 ) == 1 ) ? -minor : minor;
+        }
+    }
+
+    return adjoint;
 }
 
 Matrix Matrix::generate_inverse( void )
 {
-    Matrix inverse_matrix;
-
     if( _dimensions.first != _dimensions.second )
     {
         throw std::domain_error( "Matrix should be square to have an inverse!" );
     }
 
-    if( is_zero( this->determinant() ) )
+    const LUDecomposition factorization( *this );
+
+    factorization.assert_well_conditioned();
+
+    return factorization.inverse();
+}
+
+Reduction< value_t > Matrix::reduce( void ) const
+{
+    value_t const *data = _data;
+
+    return parallel_reduce(
+        element_count(),
+        Reduction< value_t >(),
+        [data]( std::size_t begin, std::size_t end ) -> Reduction< value_t > {
+            Reduction< value_t > partial;
+
+            for( std::size_t i = begin; i < end; ++i )
+            {
+                partial.accumulate( data[i], i );
+            }
+
+            return partial;
+        },
+        []( Reduction< value_t > accumulated,
+            Reduction< value_t > const &partial ) -> Reduction< value_t > {
+            accumulated.merge( partial );
+            return accumulated;
+        } );
+}
+
+value_t Matrix::trace( void ) const
+{
+    const position_t diagonal = std::min( _dimensions.first, _dimensions.second );
+    value_t result = 0.0;
+
+    for( position_t i = 0; i < diagonal; ++i )
+    {
+        result += ( *this )[i][i];
+    }
+
+    return result;
+}
+
+bool Matrix::approx_equal( Matrix const &other, value_t const &tolerance ) const
+{
+    value_t const *first = _data;
+    value_t const *second = other._data;
+
+    if( ( _dimensions.first != other._dimensions.first ) ||
+        ( _dimensions.second != other._dimensions.second ) )
     {
-        throw std::domain_error(
-            "Matrix's determinant should be different than 0 to have and inverse!" );
+        return false;
     }
 
-    inverse_matrix = this->adjoint_matrix();
+    for( std::size_t i = 0; i < element_count(); ++i )
+    {
+        // Written so that NaN on either side never compares equal
+        if( !( std::fabs( first[i] - second[i] ) <= tolerance ) )
+        {
+            return false;
+        }
+    }
 
-    return inverse_matrix / this->determinant();
+    return true;
 }
 
 Matrix Matrix::identity_matrix( position_t const &lines, position_t const &columns )
@@ -266,44 +403,27 @@ Matrix Matrix::identity_matrix( position_t const &lines, position_t const &colum
 
 value_t *Matrix::operator[]( int const &line )
 {
-    return _data.get() + ( line * _dimensions.second );
+    detach();
+
+    return _data + ( line * _dimensions.second );
 }
 
 value_t const *Matrix::operator[]( int const &line ) const
 {
-    return _data.get() + ( line * _dimensions.second );
+    return _data + ( line * _dimensions.second );
 }
 
 Matrix Matrix::operator*( Matrix const &other ) const
 {
     Matrix result;
-    MatrixDimensions other_dimensions;
-    value_t sum;
-
-    other_dimensions = other.dimensions();
 
-    if( _dimensions.second != other_dimensions.first )
+    if( _dimensions.second != other.dimensions().first )
     {
         throw std::domain_error(
             "First matrix column count differs from second matrix lines count!" );
     }
 
-    result.reset_dimensions( _dimensions.first, other_dimensions.second );
-
-    for( position_t i = 0; i < _dimensions.first; ++i )
-    {
-        for( position_t j = 0; j < other_dimensions.second; ++j )
-        {
-            sum = 0.0;
-
-            for( position_t k = 0; k < other_dimensions.second; ++k )
-            {
-                sum += ( *this )[i][k] * other[k][j];
-            }
-
-            result[i][j] = sum;
-        }
-    }
+    gemm( 1.0, *this, false, other, false, 0.0, result );
 
     return result;
 }
@@ -389,15 +509,74 @@ Matrix &Matrix::operator-=( value_t const &scalar )
 
 Matrix &Matrix::operator=( Matrix const &other )
 {
-    reset_dimensions( other.dimensions().first, other.dimensions().second );
+    if( this == &other )
+    {
+        return *this;
+    }
+
+    copy_from( other );
+
+    return *this;
+}
 
-    for( position_t line = 0; line < _dimensions.first; ++line )
+Matrix &Matrix::operator=( Matrix &&other ) noexcept
+{
+    if( this == &other )
     {
-        for( position_t column = 0; column < _dimensions.first; ++column )
-        {
-            ( *this )[line][column] = other[line][column];
-        }
+        return *this;
     }
 
+    _copy_on_write = other._copy_on_write;
+
+    if( other.uses_inline_storage() )
+    {
+        reset_dimensions( other._dimensions.first, other._dimensions.second );
+        std::copy( other._inline, other._inline + element_count(), _inline );
+    }
+    else
+    {
+        _dimensions = other._dimensions;
+        _heap = std::move( other._heap );
+        _data = _heap.get();
+    }
+
+    other._heap.reset();
+    other._data = other._inline;
+    other._dimensions = std::make_pair( 0, 0 );
+
     return *this;
 }
+
+void Matrix::copy_from( Matrix const &other )
+{
+    _copy_on_write = other._copy_on_write;
+
+    if( _copy_on_write && !other.uses_inline_storage() )
+    {
+        _dimensions = other._dimensions;
+        _heap = other._heap;
+        _data = _heap.get();
+
+        return;
+    }
+
+    reset_dimensions( other.dimensions().first, other.dimensions().second );
+
+    std::copy( other._data, other._data + element_count(), _data );
+}
+
+void Matrix::detach( void )
+{
+    if( !_copy_on_write || ( _heap.use_count() <= 1 ) )
+    {
+        return;
+    }
+
+    std::shared_ptr< value_t > copy( new value_t[element_count()],
+                                     std::default_delete< value_t[] >() );
+
+    std::copy( _data, _data + element_count(), copy.get() );
+
+    _heap = copy;
+    _data = _heap.get();
+}
@@ -2,9 +2,13 @@
 #define MATRIX_H
 
 #include <algorithm>
+#include <cstddef>
 #include <memory>
 #include <utility>
 
+#include "parallel.hpp"
+#include "reduction.hpp"
+
 typedef unsigned int position_t;
 typedef double value_t;
 typedef std::pair< position_t, position_t > MatrixDimensions;
@@ -14,8 +18,23 @@ class Matrix
     public:
     Matrix( void );
     Matrix( Matrix const &other );
+    Matrix( Matrix &&other ) noexcept;
     void reset_dimensions( position_t const &lines, position_t const &columns );
     MatrixDimensions dimensions( void ) const;
+
+    // Opt-in copy-on-write: copies of such a matrix share its buffer, which
+    // is duplicated on the first mutable operator[] access of a shared copy.
+    // Line pointers obtained before a copy keep pointing at the shared buffer.
+    // Matrixes small enough for the inline buffer are always copied.
+    void set_copy_on_write( bool const &enabled );
+    bool copy_on_write( void ) const;
+    bool shares_data_with( Matrix const &other ) const;
+
+    // Matrixes with up to INLINE_CAPACITY elements keep them inside the
+    // object and never touch the allocator
+    static const position_t INLINE_CAPACITY = 16;
+    bool uses_inline_storage( void ) const;
+
     value_t determinant( void ) const;
     void set( std::initializer_list< value_t > values,
               position_t const &lines,
@@ -29,6 +48,14 @@ class Matrix
     Matrix adjoint_matrix( void );
     Matrix generate_inverse( void );
 
+    // Single pass over every element. Indexes of the minimum and maximum are
+    // line * columns + column.
+    Reduction< value_t > reduce( void ) const;
+    value_t trace( void ) const;
+    // True when both matrixes have the same dimensions and every element
+    // differs by at most tolerance, stops at the first one that does not
+    bool approx_equal( Matrix const &other, value_t const &tolerance ) const;
+
     static Matrix identity_matrix( position_t const &lines, position_t const &columns );
 
     value_t *operator[]( int const &line );
@@ -49,50 +76,64 @@ class Matrix
     Matrix &operator-=( value_t const &scalar );
 
     Matrix &operator=( Matrix const &other );
+    Matrix &operator=( Matrix &&other ) noexcept;
 
     private:
     MatrixDimensions _dimensions;
-    std::unique_ptr< value_t[] > _data;
+    value_t _inline[INLINE_CAPACITY];
+    std::shared_ptr< value_t > _heap;
+    // Points either to _inline or to the heap buffer
+    value_t *_data;
+    bool _copy_on_write;
+
+    void copy_from( Matrix const &other );
+    void detach( void );
 
     value_t inner_determinant( Matrix const &matrix ) const;
 
     bool is_zero( value_t const &value ) const;
     void assert_dimensions_match( Matrix const &other ) const;
 
+    inline std::size_t element_count( void ) const
+    {
+        return static_cast< std::size_t >( _dimensions.first ) * _dimensions.second;
+    }
+
+    // The element wise helpers below walk the contiguous buffer, split in
+    // static chunks over the thread pool once it is large enough.
     template < typename Function >
     void iterate_self( Function &&function )
     {
-        Matrix &matrix = *this;
-        MatrixDimensions dimensions;
+        detach();
 
-        dimensions = matrix.dimensions();
+        value_t *data = _data;
 
-        for( position_t i = 0; i < dimensions.first; ++i )
-        {
-            for( position_t j = 0; j < dimensions.second; ++j )
+        parallel_for( element_count(), [data, &function]( std::size_t begin, std::size_t end ) {
+            for( std::size_t i = begin; i < end; ++i )
             {
-                function( matrix[i][j] );
+                function( data[i] );
             }
-        }
+        } );
     }
 
     template < typename Function >
     Matrix iterate_with_other( Matrix const &other, Function &&function ) const
     {
         Matrix result;
-        Matrix const &matrix = *this;
-        MatrixDimensions dimensions;
 
-        dimensions = matrix.dimensions();
-        result.reset_dimensions( dimensions.first, dimensions.second );
+        result.reset_dimensions( _dimensions.first, _dimensions.second );
 
-        for( position_t i = 0; i < dimensions.first; ++i )
-        {
-            for( position_t j = 0; j < dimensions.second; ++j )
-            {
-                result[i][j] = function( matrix[i][j], other[i][j] );
-            }
-        }
+        value_t const *first = _data;
+        value_t const *second = other._data;
+        value_t *target = result._data;
+
+        parallel_for( element_count(),
+                      [first, second, target, &function]( std::size_t begin, std::size_t end ) {
+                          for( std::size_t i = begin; i < end; ++i )
+                          {
+                              target[i] = function( first[i], second[i] );
+                          }
+                      } );
 
         return result;
     }
@@ -101,21 +142,29 @@ class Matrix
     Matrix derive_from_self( Function &&function ) const
     {
         Matrix result;
-        MatrixDimensions dimensions;
 
-        dimensions = this->dimensions();
-        result.reset_dimensions( dimensions.first, dimensions.second );
+        result.reset_dimensions( _dimensions.first, _dimensions.second );
 
-        for( position_t i = 0; i < dimensions.first; ++i )
-        {
-            for( position_t j = 0; j < dimensions.second; ++j )
-            {
-                result[i][j] = function( ( *this )[i][j] );
-            }
-        }
+        value_t const *source = _data;
+        value_t *target = result._data;
+
+        parallel_for( element_count(),
+                      [source, target, &function]( std::size_t begin, std::size_t end ) {
+                          for( std::size_t i = begin; i < end; ++i )
+                          {
+                              target[i] = function( source[i] );
+                          }
+                      } );
 
         return result;
     }
 };
 
+// target = source^T, source being a lines x columns line-major buffer and
+// target columns x lines. The buffers may not overlap.
+void transpose_buffer( value_t const *source,
+                       value_t *target,
+                       position_t const &lines,
+                       position_t const &columns );
+
 #endif
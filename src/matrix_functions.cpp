@@ -0,0 +1,195 @@
+#include "matrix_functions.hpp"
+#include "gemm.hpp"
+#include "lu_decomposition.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+const unsigned int PADE_DEGREE = 6;
+
+void set_identity( Matrix &matrix, position_t const &size )
+{
+    matrix.reset_dimensions( size, size );
+
+    value_t *data = matrix[0];
+
+    std::fill( data, data + static_cast< std::size_t >( size ) * size, 0.0 );
+
+    for( position_t i = 0; i < size; ++i )
+    {
+        data[static_cast< std::size_t >( i ) * size + i] = 1.0;
+    }
+}
+
+// target = source in a buffer of its own. A copy-on-write copy would share
+// the source buffer, and gemm rejects outputs sharing an operand buffer.
+void copy_values( Matrix const &source, Matrix &target )
+{
+    const MatrixDimensions dimensions = source.dimensions();
+    const std::size_t count = static_cast< std::size_t >( dimensions.first ) * dimensions.second;
+
+    // A shared buffer is replaced, so turning copy-on-write off copies nothing
+    target.reset_dimensions( dimensions.first, dimensions.second );
+    target.set_copy_on_write( false );
+
+    std::copy( source[0], source[0] + count, target[0] );
+}
+
+// target += factor * source, both with the same dimensions
+void add_scaled( Matrix &target, Matrix const &source, value_t const &factor )
+{
+    const std::size_t count =
+        static_cast< std::size_t >( source.dimensions().first ) * source.dimensions().second;
+    value_t *destination = target[0];
+    value_t const *values = source[0];
+
+    for( std::size_t i = 0; i < count; ++i )
+    {
+        destination[i] += factor * values[i];
+    }
+}
+
+value_t infinity_norm( Matrix const &matrix )
+{
+    value_t norm = 0.0;
+
+    for( position_t i = 0; i < matrix.dimensions().first; ++i )
+    {
+        value_t const *line = matrix[i];
+        value_t sum = 0.0;
+
+        for( position_t j = 0; j < matrix.dimensions().second; ++j )
+        {
+            sum += std::fabs( line[j] );
+        }
+
+        norm = std::max( norm, sum );
+    }
+
+    return norm;
+}
+}
+
+MatrixFunctions::MatrixFunctions( void )
+    : _multiplications( 0 )
+{
+}
+
+void MatrixFunctions::power( Matrix const &a, unsigned long const &exponent, Matrix &result )
+{
+    assert_square( a );
+
+    const position_t size = a.dimensions().first;
+    unsigned long remaining = exponent;
+
+    _multiplications = 0;
+    // Copied first, result may be a
+    copy_values( a, _base );
+    set_identity( result, size );
+
+    while( remaining > 0 )
+    {
+        if( remaining & 1 )
+        {
+            multiply_into( result, _base, result );
+        }
+
+        remaining >>= 1;
+
+        if( remaining > 0 )
+        {
+            multiply_into( _base, _base, _base );
+        }
+    }
+}
+
+void MatrixFunctions::exponential( Matrix const &a, Matrix &result )
+{
+    assert_square( a );
+
+    const position_t size = a.dimensions().first;
+    const value_t norm = infinity_norm( a );
+    int squarings = 0;
+
+    _multiplications = 0;
+
+    if( norm > 0.5 )
+    {
+        // norm / 0.5 = fraction * 2^exponent, fraction in [0.5, 1)
+        std::frexp( norm / 0.5, &squarings );
+    }
+
+    copy_values( a, _base );
+    _base *= std::ldexp( 1.0, -squarings );
+
+    // N = sum c_k X^k and D = sum c_k (-X)^k
+    set_identity( _numerator, size );
+    set_identity( _denominator, size );
+    copy_values( _base, _term );
+
+    value_t coefficient = 1.0;
+
+    for( unsigned int k = 1; k <= PADE_DEGREE; ++k )
+    {
+        coefficient *= static_cast< value_t >( PADE_DEGREE - k + 1 ) /
+                       static_cast< value_t >( k * ( 2 * PADE_DEGREE - k + 1 ) );
+
+        if( k > 1 )
+        {
+            multiply_into( _base, _term, _term );
+        }
+
+        add_scaled( _numerator, _term, coefficient );
+        add_scaled( _denominator, _term, ( k % 2 == 0 ) ? coefficient : -coefficient );
+    }
+
+    result = LUDecomposition( _denominator ).solve( _numerator );
+
+    for( int i = 0; i < squarings; ++i )
+    {
+        multiply_into( result, result, result );
+    }
+}
+
+unsigned int MatrixFunctions::multiplications( void ) const
+{
+    return _multiplications;
+}
+
+void MatrixFunctions::multiply_into( Matrix const &first, Matrix const &second, Matrix &target )
+{
+    // The swap can hand _scratch a copy-on-write buffer still shared with an
+    // operand, it gets one of its own before gemm writes to it
+    _scratch.set_copy_on_write( false );
+    gemm( 1.0, first, false, second, false, 0.0, _scratch );
+    std::swap( target, _scratch );
+    ++_multiplications;
+}
+
+void MatrixFunctions::assert_square( Matrix const &a ) const
+{
+    if( a.dimensions().first != a.dimensions().second )
+    {
+        throw std::domain_error( "Matrix should be square!" );
+    }
+}
+
+Matrix matrix_power( Matrix const &a, unsigned long const &exponent )
+{
+    Matrix result;
+
+    MatrixFunctions().power( a, exponent, result );
+
+    return result;
+}
+
+Matrix matrix_exponential( Matrix const &a )
+{
+    Matrix result;
+
+    MatrixFunctions().exponential( a, result );
+
+    return result;
+}
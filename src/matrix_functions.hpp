@@ -0,0 +1,43 @@
+#ifndef MATRIX_FUNCTIONS_H
+#define MATRIX_FUNCTIONS_H
+
+#include "matrix.hpp"
+
+// Powers and exponential of square matrixes. Intermediate products are
+// computed with gemm into buffers kept between calls, so repeated calls on
+// matrixes of the same size do not allocate for the products.
+class MatrixFunctions
+{
+    public:
+    MatrixFunctions( void );
+
+    // result = a^exponent by repeated squaring, O(log exponent) products.
+    // a^0 is the identity. result may be a itself.
+    void power( Matrix const &a, unsigned long const &exponent, Matrix &result );
+
+    // result = e^a, degree 6 Pade approximant with scaling and squaring.
+    // a is scaled by 2^-s until its infinity norm is at most 0.5, the
+    // approximant is solved through an LU factorization and squared s times.
+    // result may be a itself.
+    void exponential( Matrix const &a, Matrix &result );
+
+    // Products done by the last call
+    unsigned int multiplications( void ) const;
+
+    private:
+    Matrix _base;
+    Matrix _scratch;
+    Matrix _term;
+    Matrix _numerator;
+    Matrix _denominator;
+    unsigned int _multiplications;
+
+    // target = first * second, then swap target and into
+    void multiply_into( Matrix const &first, Matrix const &second, Matrix &target );
+    void assert_square( Matrix const &a ) const;
+};
+
+Matrix matrix_power( Matrix const &a, unsigned long const &exponent );
+Matrix matrix_exponential( Matrix const &a );
+
+#endif
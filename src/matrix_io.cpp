@@ -0,0 +1,664 @@
+#include "matrix_io.hpp"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <vector>
+
+#include "parallel.hpp"
+
+namespace
+{
+inline bool is_blank( char const &character )
+{
+    return ( character == ' ' ) || ( character == '\t' ) || ( character == '\r' );
+}
+
+// Start of the line after the one holding position, or end
+inline char const *next_line( char const *position, char const *end )
+{
+    void const *found = std::memchr( position, '\n', end - position );
+
+    return ( found != nullptr ) ? static_cast< char const * >( found ) + 1 : end;
+}
+
+inline char const *line_end( char const *position, char const *end )
+{
+    void const *found = std::memchr( position, '\n', end - position );
+
+    return ( found != nullptr ) ? static_cast< char const * >( found ) : end;
+}
+
+inline char const *skip_blanks( char const *position, char const *end )
+{
+    while( ( position < end ) && is_blank( *position ) )
+    {
+        ++position;
+    }
+
+    return position;
+}
+
+// Not only blanks, and not a comment when comment is set
+inline bool is_data_line( char const *begin, char const *end, char const &comment )
+{
+    begin = skip_blanks( begin, end );
+
+    return ( begin < end ) && ( ( comment == '\0' ) || ( *begin != comment ) );
+}
+
+[[noreturn]] void parse_error( std::string const &problem, std::size_t const &line )
+{
+    throw std::domain_error( problem + " in data line " + std::to_string( line + 1 ) + "!" );
+}
+
+value_t parse_value( char const *&position, char const *end, std::size_t const &line )
+{
+    position = skip_blanks( position, end );
+
+    // from_chars takes no explicit plus sign
+    if( ( position < end ) && ( *position == '+' ) )
+    {
+        ++position;
+    }
+
+    value_t value = 0.0;
+    const std::from_chars_result parsed = std::from_chars( position, end, value );
+
+    if( parsed.ec != std::errc() )
+    {
+        parse_error( "Invalid number", line );
+    }
+
+    position = parsed.ptr;
+
+    return value;
+}
+
+std::size_t parse_count( char const *&position, char const *end, std::size_t const &line )
+{
+    position = skip_blanks( position, end );
+
+    unsigned long long value = 0;
+    const std::from_chars_result parsed = std::from_chars( position, end, value );
+
+    if( parsed.ec != std::errc() )
+    {
+        parse_error( "Invalid integer", line );
+    }
+
+    position = parsed.ptr;
+
+    return static_cast< std::size_t >( value );
+}
+
+position_t parse_dimension( char const *&position, char const *end, std::size_t const &line )
+{
+    const std::size_t value = parse_count( position, end, line );
+
+    if( value > std::numeric_limits< position_t >::max() )
+    {
+        parse_error( "Dimension out of range", line );
+    }
+
+    return static_cast< position_t >( value );
+}
+
+void expect_line_end( char const *position, char const *end, std::size_t const &line )
+{
+    if( skip_blanks( position, end ) != end )
+    {
+        parse_error( "Unexpected trailing characters", line );
+    }
+}
+
+// A text buffer split in chunks that start on line starts. Construction
+// counts the data lines of every chunk in parallel, for_each() then hands
+// every data line to function( index, begin, end ) with its global index,
+// chunks running concurrently.
+class LineChunks
+{
+    public:
+    LineChunks( char const *begin, char const *end, char const &comment )
+        : _comment( comment )
+    {
+        const std::size_t bytes = end - begin;
+        const std::size_t chunks = parallel_chunk_count( bytes );
+
+        _bounds.resize( chunks + 1 );
+        _bounds[0] = begin;
+        _bounds[chunks] = end;
+
+        for( std::size_t chunk = 1; chunk < chunks; ++chunk )
+        {
+            char const *bound = begin + chunk * ( bytes / chunks );
+
+            if( bound[-1] != '\n' )
+            {
+                bound = next_line( bound, end );
+            }
+
+            _bounds[chunk] = std::max( bound, _bounds[chunk - 1] );
+        }
+
+        _first_line.assign( chunks + 1, 0 );
+
+        run( [this]( std::size_t chunk ) {
+            std::size_t count = 0;
+
+            for( char const *line = _bounds[chunk]; line < _bounds[chunk + 1];
+                 line = next_line( line, _bounds[chunk + 1] ) )
+            {
+                if( is_data_line( line, line_end( line, _bounds[chunk + 1] ), _comment ) )
+                {
+                    ++count;
+                }
+            }
+
+            _first_line[chunk + 1] = count;
+        } );
+
+        for( std::size_t chunk = 0; chunk < chunks; ++chunk )
+        {
+            _first_line[chunk + 1] += _first_line[chunk];
+        }
+    }
+
+    std::size_t lines( void ) const
+    {
+        return _first_line.back();
+    }
+
+    template < typename Function >
+    void for_each( Function &&function ) const
+    {
+        run( [this, &function]( std::size_t chunk ) {
+            std::size_t index = _first_line[chunk];
+            char const *chunk_end = _bounds[chunk + 1];
+
+            for( char const *line = _bounds[chunk]; line < chunk_end;
+                 line = next_line( line, chunk_end ) )
+            {
+                char const *last = line_end( line, chunk_end );
+
+                if( is_data_line( line, last, _comment ) )
+                {
+                    function( index++, line, last );
+                }
+            }
+        } );
+    }
+
+    private:
+    char _comment;
+    std::vector< char const * > _bounds;
+    std::vector< std::size_t > _first_line;
+
+    template < typename Function >
+    void run( Function &&function ) const
+    {
+        const std::size_t chunks = _bounds.size() - 1;
+        const std::size_t bytes = _bounds.back() - _bounds.front();
+
+        parallel_for( chunks,
+                      [&function]( std::size_t begin, std::size_t end ) {
+                          for( std::size_t chunk = begin; chunk < end; ++chunk )
+                          {
+                              function( chunk );
+                          }
+                      },
+                      bytes / std::max< std::size_t >( chunks, 1 ) );
+    }
+};
+
+std::vector< char > read_file( std::string const &path )
+{
+    std::ifstream file( path, std::ios::binary | std::ios::ate );
+
+    if( !file )
+    {
+        throw MatrixFileError( "Cannot open " + path + "!" );
+    }
+
+    const std::streamsize size = std::max< std::streamsize >( file.tellg(), 0 );
+    std::vector< char > contents( static_cast< std::size_t >( size ) );
+
+    file.seekg( 0 );
+
+    if( !file.read( contents.data(), size ) )
+    {
+        throw MatrixFileError( "Cannot read " + path + "!" );
+    }
+
+    return contents;
+}
+
+void resize_if_needed( Matrix &result, position_t const &lines, position_t const &columns )
+{
+    if( result.dimensions() != MatrixDimensions( lines, columns ) )
+    {
+        result.reset_dimensions( lines, columns );
+    }
+}
+
+enum class MarketFormat
+{
+    array,
+    coordinate
+};
+
+enum class MarketSymmetry
+{
+    general,
+    symmetric,
+    skew_symmetric
+};
+
+struct MarketHeader
+{
+    MarketFormat format;
+    bool pattern;
+    MarketSymmetry symmetry;
+    position_t lines;
+    position_t columns;
+    std::size_t entries;
+    // First character after the size line
+    char const *data;
+};
+
+std::string lowercase_word( char const *&position, char const *end )
+{
+    std::string word;
+
+    position = skip_blanks( position, end );
+
+    while( ( position < end ) && !is_blank( *position ) && ( *position != '\n' ) )
+    {
+        word += static_cast< char >( std::tolower( static_cast< unsigned char >( *position ) ) );
+        ++position;
+    }
+
+    return word;
+}
+
+MarketHeader parse_market_header( char const *begin, char const *end )
+{
+    MarketHeader header;
+    char const *position = begin;
+    char const *last = line_end( begin, end );
+
+    if( lowercase_word( position, last ) != "%%matrixmarket" )
+    {
+        throw std::domain_error( "Missing Matrix Market banner!" );
+    }
+
+    const std::string object = lowercase_word( position, last );
+    const std::string format = lowercase_word( position, last );
+    const std::string field = lowercase_word( position, last );
+    const std::string symmetry = lowercase_word( position, last );
+
+    if( object != "matrix" )
+    {
+        throw std::domain_error( "Only Matrix Market matrixes are supported!" );
+    }
+
+    if( ( format != "array" ) && ( format != "coordinate" ) )
+    {
+        throw std::domain_error( "Unknown Matrix Market format!" );
+    }
+
+    if( ( field != "real" ) && ( field != "integer" ) && ( field != "double" ) &&
+        ( field != "pattern" ) )
+    {
+        throw std::domain_error( "Unsupported Matrix Market field!" );
+    }
+
+    if( ( symmetry != "general" ) && ( symmetry != "symmetric" ) &&
+        ( symmetry != "skew-symmetric" ) )
+    {
+        throw std::domain_error( "Unsupported Matrix Market symmetry!" );
+    }
+
+    header.format = ( format == "array" ) ? MarketFormat::array : MarketFormat::coordinate;
+    header.pattern = ( field == "pattern" );
+    header.symmetry = ( symmetry == "general" )
+                          ? MarketSymmetry::general
+                          : ( ( symmetry == "symmetric" ) ? MarketSymmetry::symmetric
+                                                          : MarketSymmetry::skew_symmetric );
+
+    if( header.pattern && ( header.format == MarketFormat::array ) )
+    {
+        throw std::domain_error( "Pattern Matrix Market files must use the coordinate format!" );
+    }
+
+    // Comments and blank lines, then the size line
+    position = next_line( begin, end );
+
+    while( ( position < end ) && !is_data_line( position, line_end( position, end ), '%' ) )
+    {
+        position = next_line( position, end );
+    }
+
+    if( position == end )
+    {
+        throw std::domain_error( "Missing Matrix Market size line!" );
+    }
+
+    last = line_end( position, end );
+    header.lines = parse_dimension( position, last, 0 );
+    header.columns = parse_dimension( position, last, 0 );
+
+    if( header.format == MarketFormat::coordinate )
+    {
+        header.entries = parse_count( position, last, 0 );
+    }
+    else
+    {
+        const std::size_t n = header.columns;
+
+        switch( header.symmetry )
+        {
+            case MarketSymmetry::general:
+                header.entries = static_cast< std::size_t >( header.lines ) * n;
+                break;
+            case MarketSymmetry::symmetric:
+                header.entries = n * ( n + 1 ) / 2;
+                break;
+            case MarketSymmetry::skew_symmetric:
+                header.entries = ( n > 0 ) ? n * ( n - 1 ) / 2 : 0;
+                break;
+        }
+    }
+
+    expect_line_end( position, last, 0 );
+
+    if( ( header.symmetry != MarketSymmetry::general ) && ( header.lines != header.columns ) )
+    {
+        throw std::domain_error( "Symmetric Matrix Market matrixes must be square!" );
+    }
+
+    header.data = next_line( position, end );
+
+    return header;
+}
+
+void check_entry_count( LineChunks const &chunks, MarketHeader const &header )
+{
+    if( chunks.lines() != header.entries )
+    {
+        throw std::domain_error( "Matrix Market entry count differs from the size line!" );
+    }
+}
+
+// Coordinate entries, 0-based, with the mirrored half of symmetric files
+std::vector< SparseEntry > parse_market_entries( MarketHeader const &header, char const *end )
+{
+    LineChunks chunks( header.data, end, '%' );
+    std::vector< SparseEntry > entries;
+
+    check_entry_count( chunks, header );
+    entries.resize( header.entries );
+
+    chunks.for_each( [&entries, &header]( std::size_t index, char const *line, char const *last ) {
+        SparseEntry &entry = entries[index];
+        const std::size_t i = parse_count( line, last, index );
+        const std::size_t j = parse_count( line, last, index );
+
+        if( ( i == 0 ) || ( j == 0 ) || ( i > header.lines ) || ( j > header.columns ) )
+        {
+            parse_error( "Entry position out of range", index );
+        }
+
+        entry.line = static_cast< position_t >( i - 1 );
+        entry.column = static_cast< position_t >( j - 1 );
+        entry.value = header.pattern ? 1.0 : parse_value( line, last, index );
+        expect_line_end( line, last, index );
+    } );
+
+    if( header.symmetry != MarketSymmetry::general )
+    {
+        const value_t sign = ( header.symmetry == MarketSymmetry::symmetric ) ? 1.0 : -1.0;
+        const std::size_t stored = entries.size();
+
+        for( std::size_t k = 0; k < stored; ++k )
+        {
+            if( entries[k].line != entries[k].column )
+            {
+                entries.push_back( {entries[k].column, entries[k].line, sign * entries[k].value} );
+            }
+        }
+    }
+
+    return entries;
+}
+
+// Array values, column after column as stored in the file
+void parse_market_array( MarketHeader const &header, char const *end, Matrix &result )
+{
+    LineChunks chunks( header.data, end, '%' );
+
+    // Checked before allocating, entries comes from the size line
+    check_entry_count( chunks, header );
+
+    std::vector< value_t > values( header.entries );
+
+    chunks.for_each( [&values]( std::size_t index, char const *line, char const *last ) {
+        values[index] = parse_value( line, last, index );
+        expect_line_end( line, last, index );
+    } );
+
+    const position_t m = header.lines;
+    const position_t n = header.columns;
+
+    resize_if_needed( result, m, n );
+
+    if( ( m == 0 ) || ( n == 0 ) )
+    {
+        return;
+    }
+
+    value_t *data = result[0];
+
+    if( header.symmetry == MarketSymmetry::general )
+    {
+        parallel_for( m,
+                      [&values, data, m, n]( std::size_t begin, std::size_t end ) {
+                          for( std::size_t i = begin; i < end; ++i )
+                          {
+                              for( position_t j = 0; j < n; ++j )
+                              {
+                                  data[i * n + j] = values[static_cast< std::size_t >( j ) * m + i];
+                              }
+                          }
+                      },
+                      n );
+        return;
+    }
+
+    // Lower triangle column after column, the diagonal is skipped when skew
+    const bool skew = ( header.symmetry == MarketSymmetry::skew_symmetric );
+    std::size_t k = 0;
+
+    for( position_t j = 0; j < n; ++j )
+    {
+        if( skew )
+        {
+            data[static_cast< std::size_t >( j ) * n + j] = 0.0;
+        }
+
+        for( position_t i = skew ? j + 1 : j; i < n; ++i, ++k )
+        {
+            data[static_cast< std::size_t >( i ) * n + j] = values[k];
+            data[static_cast< std::size_t >( j ) * n + i] = skew ? -values[k] : values[k];
+        }
+    }
+}
+}
+
+MatrixFileError::MatrixFileError( std::string const &message )
+    : std::runtime_error( message )
+{
+}
+
+void parse_delimited( char const *begin,
+                      char const *end,
+                      Matrix &result,
+                      DelimitedOptions const &options )
+{
+    for( position_t i = 0; ( i < options.skip_lines ) && ( begin < end ); ++i )
+    {
+        begin = next_line( begin, end );
+    }
+
+    const char delimiter = options.delimiter;
+    const bool by_blanks = is_blank( delimiter );
+    LineChunks chunks( begin, end, '\0' );
+
+    if( chunks.lines() == 0 )
+    {
+        resize_if_needed( result, 0, 0 );
+        return;
+    }
+
+    // The first data line gives the column count
+    char const *first = begin;
+
+    while( !is_data_line( first, line_end( first, end ), '\0' ) )
+    {
+        first = next_line( first, end );
+    }
+
+    char const *first_end = line_end( first, end );
+    position_t columns = 0;
+
+    while( true )
+    {
+        parse_value( first, first_end, 0 );
+        ++columns;
+        first = skip_blanks( first, first_end );
+
+        if( first == first_end )
+        {
+            break;
+        }
+
+        if( !by_blanks )
+        {
+            if( *first != delimiter )
+            {
+                parse_error( "Missing delimiter", 0 );
+            }
+
+            ++first;
+        }
+    }
+
+    resize_if_needed( result, static_cast< position_t >( chunks.lines() ), columns );
+
+    value_t *data = result[0];
+
+    chunks.for_each( [data, columns, delimiter, by_blanks]( std::size_t index,
+                                                            char const *line,
+                                                            char const *last ) {
+            value_t *target = data + index * columns;
+
+            for( position_t j = 0; j < columns; ++j )
+            {
+                if( ( j > 0 ) && !by_blanks )
+                {
+                    line = skip_blanks( line, last );
+
+                    if( ( line == last ) || ( *line != delimiter ) )
+                    {
+                        parse_error( "Missing field", index );
+                    }
+
+                    ++line;
+                }
+
+                target[j] = parse_value( line, last, index );
+            }
+
+            expect_line_end( line, last, index );
+        } );
+}
+
+void read_delimited( std::string const &path, Matrix &result, DelimitedOptions const &options )
+{
+    const std::vector< char > contents = read_file( path );
+
+    parse_delimited( contents.data(), contents.data() + contents.size(), result, options );
+}
+
+Matrix read_delimited( std::string const &path, DelimitedOptions const &options )
+{
+    Matrix result;
+
+    read_delimited( path, result, options );
+
+    return result;
+}
+
+void parse_matrix_market( char const *begin, char const *end, Matrix &result )
+{
+    const MarketHeader header = parse_market_header( begin, end );
+
+    if( header.format == MarketFormat::array )
+    {
+        parse_market_array( header, end, result );
+        return;
+    }
+
+    const std::vector< SparseEntry > entries = parse_market_entries( header, end );
+
+    const std::size_t columns = header.columns;
+
+    resize_if_needed( result, header.lines, header.columns );
+
+    if( ( header.lines == 0 ) || ( columns == 0 ) )
+    {
+        return;
+    }
+
+    value_t *data = result[0];
+
+    std::fill( data, data + header.lines * columns, 0.0 );
+
+    // Repeated positions are summed, like SparseMatrix does
+    for( SparseEntry const &entry : entries )
+    {
+        data[entry.line * columns + entry.column] += entry.value;
+    }
+}
+
+void parse_matrix_market( char const *begin, char const *end, SparseMatrix &result )
+{
+    const MarketHeader header = parse_market_header( begin, end );
+
+    if( header.format == MarketFormat::array )
+    {
+        Matrix dense;
+
+        parse_market_array( header, end, dense );
+        result = SparseMatrix( dense );
+        return;
+    }
+
+    result = SparseMatrix( header.lines, header.columns, parse_market_entries( header, end ) );
+}
+
+void read_matrix_market( std::string const &path, Matrix &result )
+{
+    const std::vector< char > contents = read_file( path );
+
+    parse_matrix_market( contents.data(), contents.data() + contents.size(), result );
+}
+
+void read_matrix_market( std::string const &path, SparseMatrix &result )
+{
+    const std::vector< char > contents = read_file( path );
+
+    parse_matrix_market( contents.data(), contents.data() + contents.size(), result );
+}
@@ -0,0 +1,54 @@
+#ifndef MATRIX_IO_H
+#define MATRIX_IO_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+#include "matrix.hpp"
+#include "sparse_matrix.hpp"
+
+// Readers for dense delimited text and Matrix Market files. The whole
+// file is read in one go and split in chunks aligned on line starts; a
+// first parallel pass counts the lines of every chunk, so the second one
+// knows where each line lands and parses the chunks concurrently with
+// std::from_chars straight into the destination. Parse errors throw
+// std::domain_error naming the data line (1-based, blank lines excluded),
+// files that cannot be read throw MatrixFileError.
+
+class MatrixFileError : public std::runtime_error
+{
+    public:
+    explicit MatrixFileError( std::string const &message );
+};
+
+struct DelimitedOptions
+{
+    // ',' for CSV, ' ' for fields separated by any run of spaces and tabs
+    char delimiter = ',';
+    // Lines skipped before the data, such as a header
+    position_t skip_lines = 0;
+};
+
+// Every non blank line is a matrix line and all must have the same number
+// of fields. result keeps its buffer when it already has the dimensions of
+// the data.
+void parse_delimited( char const *begin,
+                      char const *end,
+                      Matrix &result,
+                      DelimitedOptions const &options = DelimitedOptions() );
+void read_delimited( std::string const &path,
+                     Matrix &result,
+                     DelimitedOptions const &options = DelimitedOptions() );
+Matrix read_delimited( std::string const &path,
+                       DelimitedOptions const &options = DelimitedOptions() );
+
+// Matrix Market: array or coordinate format, real, integer or pattern
+// (read as 1) fields, general, symmetric or skew-symmetric. Both formats
+// can be read into either kind of matrix.
+void parse_matrix_market( char const *begin, char const *end, Matrix &result );
+void parse_matrix_market( char const *begin, char const *end, SparseMatrix &result );
+void read_matrix_market( std::string const &path, Matrix &result );
+void read_matrix_market( std::string const &path, SparseMatrix &result );
+
+#endif
@@ -0,0 +1,105 @@
+#include "matrix_view.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+MatrixView::MatrixView( void )
+    : _data( nullptr )
+    , _dimensions( 0, 0 )
+    , _order( StorageOrder::line_major )
+{
+}
+
+MatrixView::MatrixView( value_t const *data,
+                        position_t const &lines,
+                        position_t const &columns,
+                        StorageOrder const &order )
+    : _data( data )
+    , _dimensions( lines, columns )
+    , _order( order )
+{
+}
+
+MatrixView::MatrixView( Matrix const &matrix )
+    : _data( matrix[0] )
+    , _dimensions( matrix.dimensions() )
+    , _order( StorageOrder::line_major )
+{
+}
+
+MatrixDimensions MatrixView::dimensions( void ) const
+{
+    return _dimensions;
+}
+
+value_t const *MatrixView::data( void ) const
+{
+    return _data;
+}
+
+StorageOrder MatrixView::order( void ) const
+{
+    return _order;
+}
+
+value_t MatrixView::operator()( position_t const &line, position_t const &column ) const
+{
+    if( _order == StorageOrder::line_major )
+    {
+        return _data[static_cast< std::size_t >( line ) * _dimensions.second + column];
+    }
+
+    return _data[static_cast< std::size_t >( column ) * _dimensions.first + line];
+}
+
+value_t const *MatrixView::operator[]( int const &line ) const
+{
+    if( _order != StorageOrder::line_major )
+    {
+        throw std::domain_error( "Line pointers need a line-major view!" );
+    }
+
+    return _data + ( static_cast< std::size_t >( line ) * _dimensions.second );
+}
+
+MatrixView MatrixView::transposed( void ) const
+{
+    return MatrixView( _data,
+                       _dimensions.second,
+                       _dimensions.first,
+                       ( _order == StorageOrder::line_major ) ? StorageOrder::column_major :
+                                                                 StorageOrder::line_major );
+}
+
+Matrix MatrixView::to_matrix( void ) const
+{
+    const position_t lines = _dimensions.first;
+    const position_t columns = _dimensions.second;
+    const std::size_t count = static_cast< std::size_t >( lines ) * columns;
+    Matrix result;
+
+    result.reset_dimensions( lines, columns );
+
+    if( count == 0 )
+    {
+        return result;
+    }
+
+    value_t *target = result[0];
+
+    if( _order == StorageOrder::line_major )
+    {
+        std::copy( _data, _data + count, target );
+
+        return result;
+    }
+
+    // The column-major buffer is the line-major buffer of the transpose
+    transpose_buffer( _data, target, columns, lines );
+
+    return result;
+}
+
+MatrixView transposed_view( Matrix const &matrix )
+{
+    return MatrixView( matrix ).transposed();
+}
@@ -0,0 +1,53 @@
+#ifndef MATRIX_VIEW_H
+#define MATRIX_VIEW_H
+
+#include <cstdint>
+
+#include "matrix.hpp"
+
+// How the viewed buffer is ordered. A column-major view of a buffer is the
+// transpose of the line-major view of the same buffer.
+enum class StorageOrder : std::uint32_t
+{
+    line_major = 0,
+    column_major = 1
+};
+
+// Read-only, non-owning view of a dense buffer of values, in either
+// storage order. The buffer must outlive the view.
+class MatrixView
+{
+    public:
+    MatrixView( void );
+    // lines and columns are the dimensions of the viewed matrix
+    MatrixView( value_t const *data,
+                position_t const &lines,
+                position_t const &columns,
+                StorageOrder const &order = StorageOrder::line_major );
+    // Views the matrix buffer, invalidated by any mutable access to matrix
+    explicit MatrixView( Matrix const &matrix );
+
+    MatrixDimensions dimensions( void ) const;
+    value_t const *data( void ) const;
+    StorageOrder order( void ) const;
+
+    value_t operator()( position_t const &line, position_t const &column ) const;
+    // Line pointer, only for line-major views
+    value_t const *operator[]( int const &line ) const;
+
+    // Same buffer with swapped dimensions and storage order, O(1)
+    MatrixView transposed( void ) const;
+
+    // Copies the viewed values into a new (line-major) matrix
+    Matrix to_matrix( void ) const;
+
+    private:
+    value_t const *_data;
+    MatrixDimensions _dimensions;
+    StorageOrder _order;
+};
+
+// O(1) transpose of a matrix, nothing is copied until to_matrix()
+MatrixView transposed_view( Matrix const &matrix );
+
+#endif
@@ -0,0 +1,33 @@
+#include "parallel.hpp"
+#include <atomic>
+
+namespace
+{
+std::atomic< std::size_t > threshold( 1 << 16 );
+}
+
+std::size_t parallel_threshold( void )
+{
+    return threshold;
+}
+
+void set_parallel_threshold( std::size_t const &value )
+{
+    threshold = value;
+}
+
+std::size_t parallel_chunk_count( std::size_t const &count, std::size_t const &cost )
+{
+    const std::size_t minimum = std::max< std::size_t >( threshold, 1 );
+    const std::size_t work = count * std::max< std::size_t >( cost, 1 );
+
+    if( ( work < minimum ) || ThreadPool::is_worker_thread() )
+    {
+        return 1;
+    }
+
+    // The calling thread takes one chunk, the pool workers the others
+    const std::size_t workers = ThreadPool::instance().thread_count() + 1;
+
+    return std::min( std::min( workers, count ), work / minimum );
+}
@@ -0,0 +1,150 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <future>
+#include <vector>
+
+#include "thread_pool.hpp"
+
+// Element count below which parallel_for and parallel_reduce stay serial
+std::size_t parallel_threshold( void );
+void set_parallel_threshold( std::size_t const &threshold );
+
+// How many contiguous chunks a range of count items, each worth cost
+// elements of work, is split into. Returns 1 for small ranges and when
+// already running inside a worker, which keeps nested calls from waiting on
+// their own pool.
+std::size_t parallel_chunk_count( std::size_t const &count, std::size_t const &cost = 1 );
+
+// Calls function( begin, end ) over static, equally sized contiguous chunks
+// of [0, count). Chunk i always covers the same range, so repeated passes
+// over one buffer touch memory in the same pattern. The calling thread
+// processes the first chunk itself.
+template < typename Function >
+void parallel_for( std::size_t const &count, Function &&function, std::size_t const &cost = 1 )
+{
+    const std::size_t chunks = parallel_chunk_count( count, cost );
+
+    if( chunks <= 1 )
+    {
+        function( std::size_t( 0 ), count );
+        return;
+    }
+
+    const std::size_t chunk_size = ( count + chunks - 1 ) / chunks;
+    std::vector< std::future< void > > pending;
+
+    pending.reserve( chunks - 1 );
+
+    for( std::size_t chunk = 1; chunk < chunks; ++chunk )
+    {
+        const std::size_t begin = std::min( count, chunk * chunk_size );
+        const std::size_t end = std::min( count, begin + chunk_size );
+
+        pending.push_back( ThreadPool::instance().async(
+            [&function, begin, end]( void ) -> void { function( begin, end ); } ) );
+    }
+
+    // Every chunk must finish before leaving, they reference function
+    std::exception_ptr failure;
+
+    try
+    {
+        function( std::size_t( 0 ), std::min( count, chunk_size ) );
+    }
+    catch( ... )
+    {
+        failure = std::current_exception();
+    }
+
+    for( std::future< void > &chunk : pending )
+    {
+        try
+        {
+            chunk.get();
+        }
+        catch( ... )
+        {
+            if( !failure )
+            {
+                failure = std::current_exception();
+            }
+        }
+    }
+
+    if( failure )
+    {
+        std::rethrow_exception( failure );
+    }
+}
+
+// Maps every chunk to a partial result with map( begin, end ) and folds the
+// partials, in chunk order, with merge( accumulated, partial ).
+template < typename Result, typename Map, typename Merge >
+Result parallel_reduce( std::size_t const &count, Result identity, Map &&map, Merge &&merge )
+{
+    const std::size_t chunks = parallel_chunk_count( count );
+
+    if( chunks <= 1 )
+    {
+        return merge( identity, map( std::size_t( 0 ), count ) );
+    }
+
+    const std::size_t chunk_size = ( count + chunks - 1 ) / chunks;
+    std::vector< std::future< Result > > pending;
+
+    pending.reserve( chunks - 1 );
+
+    for( std::size_t chunk = 1; chunk < chunks; ++chunk )
+    {
+        const std::size_t begin = std::min( count, chunk * chunk_size );
+        const std::size_t end = std::min( count, begin + chunk_size );
+
+        pending.push_back( ThreadPool::instance().async(
+            [&map, begin, end]( void ) -> Result { return map( begin, end ); } ) );
+    }
+
+    Result result = identity;
+    std::exception_ptr failure;
+
+    try
+    {
+        result = merge( result, map( std::size_t( 0 ), std::min( count, chunk_size ) ) );
+    }
+    catch( ... )
+    {
+        failure = std::current_exception();
+    }
+
+    for( std::future< Result > &chunk : pending )
+    {
+        try
+        {
+            Result partial = chunk.get();
+
+            if( !failure )
+            {
+                result = merge( result, partial );
+            }
+        }
+        catch( ... )
+        {
+            if( !failure )
+            {
+                failure = std::current_exception();
+            }
+        }
+    }
+
+    if( failure )
+    {
+        std::rethrow_exception( failure );
+    }
+
+    return result;
+}
+
+#endif
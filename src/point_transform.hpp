@@ -0,0 +1,304 @@
+#ifndef POINT_TRANSFORM_H
+#define POINT_TRANSFORM_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+
+#include "matrix.hpp"
+#include "parallel.hpp"
+#include "vector.hpp"
+#include "vector_array.hpp"
+
+// 4x4 homogeneous transform applied in bulk to point buffers. A chain of
+// transforms is composed once into a single matrix, then every point costs
+// one pass: 12 multiply-adds for an affine transform, 16 and the
+// perspective divide for a projective one. Coefficients are held in
+// locals and coordinates read through get<>(), so the inner loops have no
+// bounds checks or indirections left for the compiler to vectorize.
+// Buffers are split over the thread pool like the parallel element wise
+// operations.
+template < typename Scalar >
+class PointTransform
+{
+    static_assert( std::is_floating_point< Scalar >::value,
+                   "PointTransform only supports floating point scalars!" );
+
+    public:
+    typedef Vector< 3, Scalar > Point;
+    typedef Vector< 4, Scalar > HomogeneousPoint;
+
+    // Identity
+    PointTransform( void )
+        : _values{1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1}
+    {
+    }
+
+    // From a 4x4 matrix acting on column vectors, p' = M * p
+    explicit PointTransform( Matrix const &matrix )
+    {
+        if( matrix.dimensions() != MatrixDimensions( 4, 4 ) )
+        {
+            throw std::domain_error( "Point transform matrix should be 4x4!" );
+        }
+
+        for( position_t i = 0; i < 4; ++i )
+        {
+            for( position_t j = 0; j < 4; ++j )
+            {
+                _values[i * 4 + j] = static_cast< Scalar >( matrix[i][j] );
+            }
+        }
+    }
+
+    // Applies the transforms in order, the first one first
+    static PointTransform< Scalar > chain( std::initializer_list< PointTransform< Scalar > > steps )
+    {
+        PointTransform< Scalar > result;
+
+        for( PointTransform< Scalar > const &step : steps )
+        {
+            result = result.then( step );
+        }
+
+        return result;
+    }
+
+    // This transform followed by next, next * this
+    PointTransform< Scalar > then( PointTransform< Scalar > const &next ) const
+    {
+        PointTransform< Scalar > result;
+
+        for( position_t i = 0; i < 4; ++i )
+        {
+            for( position_t j = 0; j < 4; ++j )
+            {
+                Scalar sum = 0;
+
+                for( position_t k = 0; k < 4; ++k )
+                {
+                    sum += next._values[i * 4 + k] * _values[k * 4 + j];
+                }
+
+                result._values[i * 4 + j] = sum;
+            }
+        }
+
+        return result;
+    }
+
+    Scalar operator()( position_t const &line, position_t const &column ) const
+    {
+        if( ( line >= 4 ) || ( column >= 4 ) )
+        {
+            throw std::out_of_range( "Matrix position out of range!" );
+        }
+
+        return _values[line * 4 + column];
+    }
+
+    Matrix to_matrix( void ) const
+    {
+        Matrix result;
+
+        result.reset_dimensions( 4, 4 );
+
+        for( position_t i = 0; i < 4; ++i )
+        {
+            for( position_t j = 0; j < 4; ++j )
+            {
+                result[i][j] = _values[i * 4 + j];
+            }
+        }
+
+        return result;
+    }
+
+    // Last line is 0 0 0 1: w stays 1 and no divide is needed
+    bool is_affine( void ) const
+    {
+        return ( _values[12] == 0 ) && ( _values[13] == 0 ) && ( _values[14] == 0 ) &&
+               ( _values[15] == 1 );
+    }
+
+    Point apply( Point const &point ) const
+    {
+        Point result;
+
+        apply( &point, &result, 1 );
+
+        return result;
+    }
+
+    HomogeneousPoint apply( HomogeneousPoint const &point, bool const &divide = false ) const
+    {
+        HomogeneousPoint result;
+
+        apply( &point, &result, 1, divide );
+
+        return result;
+    }
+
+    // output[i] = transform of input[i], w = 1. Projective transforms
+    // divide by the resulting w. output may be input (in place), but may
+    // not partially overlap it.
+    void apply( Point const *input, Point *output, std::size_t const &count ) const
+    {
+        if( is_affine() )
+        {
+            run( count, [this, input, output]( std::size_t begin, std::size_t end ) {
+                transform_affine( input, output, begin, end );
+            } );
+        }
+        else
+        {
+            run( count, [this, input, output]( std::size_t begin, std::size_t end ) {
+                transform_projective( input, output, begin, end );
+            } );
+        }
+    }
+
+    // Same on homogeneous points. With divide every result is scaled by
+    // 1 / w, giving (x/w, y/w, z/w, 1).
+    void apply( HomogeneousPoint const *input,
+                HomogeneousPoint *output,
+                std::size_t const &count,
+                bool const &divide = false ) const
+    {
+        run( count, [this, input, output, divide]( std::size_t begin, std::size_t end ) {
+            transform_homogeneous( input, output, begin, end, divide );
+        } );
+    }
+
+    // In place over a structure-of-arrays buffer
+    void apply( VectorArray< 3, Scalar > &points ) const
+    {
+        apply( points, points );
+    }
+
+    // output is resized to input.size() when needed, it may be input
+    void apply( VectorArray< 3, Scalar > const &input, VectorArray< 3, Scalar > &output ) const
+    {
+        const std::size_t count = input.size();
+
+        if( output.size() != count )
+        {
+            output.resize( count );
+        }
+
+        Scalar const *x = input.component( 0 );
+        Scalar const *y = input.component( 1 );
+        Scalar const *z = input.component( 2 );
+        Scalar *out_x = output.component( 0 );
+        Scalar *out_y = output.component( 1 );
+        Scalar *out_z = output.component( 2 );
+        const bool affine = is_affine();
+        Scalar const *m = _values;
+
+        run( count, [=]( std::size_t begin, std::size_t end ) {
+            const Scalar m00 = m[0], m01 = m[1], m02 = m[2], m03 = m[3];
+            const Scalar m10 = m[4], m11 = m[5], m12 = m[6], m13 = m[7];
+            const Scalar m20 = m[8], m21 = m[9], m22 = m[10], m23 = m[11];
+            const Scalar m30 = m[12], m31 = m[13], m32 = m[14], m33 = m[15];
+
+            for( std::size_t i = begin; i < end; ++i )
+            {
+                const Scalar px = x[i];
+                const Scalar py = y[i];
+                const Scalar pz = z[i];
+                const Scalar scale =
+                    affine ? Scalar( 1 ) : Scalar( 1 ) / ( m30 * px + m31 * py + m32 * pz + m33 );
+
+                out_x[i] = ( m00 * px + m01 * py + m02 * pz + m03 ) * scale;
+                out_y[i] = ( m10 * px + m11 * py + m12 * pz + m13 ) * scale;
+                out_z[i] = ( m20 * px + m21 * py + m22 * pz + m23 ) * scale;
+            }
+        } );
+    }
+
+    private:
+    // Line-major
+    Scalar _values[16];
+
+    template < typename Function >
+    static void run( std::size_t const &count, Function &&function )
+    {
+        // Up to 16 multiply-adds per point
+        parallel_for( count, function, 16 );
+    }
+
+    void transform_affine( Point const *input,
+                           Point *output,
+                           std::size_t const &begin,
+                           std::size_t const &end ) const
+    {
+        const Scalar m00 = _values[0], m01 = _values[1], m02 = _values[2], m03 = _values[3];
+        const Scalar m10 = _values[4], m11 = _values[5], m12 = _values[6], m13 = _values[7];
+        const Scalar m20 = _values[8], m21 = _values[9], m22 = _values[10], m23 = _values[11];
+
+        for( std::size_t i = begin; i < end; ++i )
+        {
+            // Read before writing, input may be output
+            const Scalar x = input[i].template get< 0 >();
+            const Scalar y = input[i].template get< 1 >();
+            const Scalar z = input[i].template get< 2 >();
+
+            output[i].template get< 0 >() = m00 * x + m01 * y + m02 * z + m03;
+            output[i].template get< 1 >() = m10 * x + m11 * y + m12 * z + m13;
+            output[i].template get< 2 >() = m20 * x + m21 * y + m22 * z + m23;
+        }
+    }
+
+    void transform_projective( Point const *input,
+                               Point *output,
+                               std::size_t const &begin,
+                               std::size_t const &end ) const
+    {
+        const Scalar m00 = _values[0], m01 = _values[1], m02 = _values[2], m03 = _values[3];
+        const Scalar m10 = _values[4], m11 = _values[5], m12 = _values[6], m13 = _values[7];
+        const Scalar m20 = _values[8], m21 = _values[9], m22 = _values[10], m23 = _values[11];
+        const Scalar m30 = _values[12], m31 = _values[13], m32 = _values[14], m33 = _values[15];
+
+        for( std::size_t i = begin; i < end; ++i )
+        {
+            const Scalar x = input[i].template get< 0 >();
+            const Scalar y = input[i].template get< 1 >();
+            const Scalar z = input[i].template get< 2 >();
+            const Scalar scale = Scalar( 1 ) / ( m30 * x + m31 * y + m32 * z + m33 );
+
+            output[i].template get< 0 >() = ( m00 * x + m01 * y + m02 * z + m03 ) * scale;
+            output[i].template get< 1 >() = ( m10 * x + m11 * y + m12 * z + m13 ) * scale;
+            output[i].template get< 2 >() = ( m20 * x + m21 * y + m22 * z + m23 ) * scale;
+        }
+    }
+
+    void transform_homogeneous( HomogeneousPoint const *input,
+                                HomogeneousPoint *output,
+                                std::size_t const &begin,
+                                std::size_t const &end,
+                                bool const &divide ) const
+    {
+        const Scalar m00 = _values[0], m01 = _values[1], m02 = _values[2], m03 = _values[3];
+        const Scalar m10 = _values[4], m11 = _values[5], m12 = _values[6], m13 = _values[7];
+        const Scalar m20 = _values[8], m21 = _values[9], m22 = _values[10], m23 = _values[11];
+        const Scalar m30 = _values[12], m31 = _values[13], m32 = _values[14], m33 = _values[15];
+
+        for( std::size_t i = begin; i < end; ++i )
+        {
+            const Scalar x = input[i].template get< 0 >();
+            const Scalar y = input[i].template get< 1 >();
+            const Scalar z = input[i].template get< 2 >();
+            const Scalar w = input[i].template get< 3 >();
+            const Scalar result_w = m30 * x + m31 * y + m32 * z + m33 * w;
+            const Scalar scale = divide ? Scalar( 1 ) / result_w : Scalar( 1 );
+
+            output[i].template get< 0 >() = ( m00 * x + m01 * y + m02 * z + m03 * w ) * scale;
+            output[i].template get< 1 >() = ( m10 * x + m11 * y + m12 * z + m13 * w ) * scale;
+            output[i].template get< 2 >() = ( m20 * x + m21 * y + m22 * z + m23 * w ) * scale;
+            output[i].template get< 3 >() = divide ? Scalar( 1 ) : result_w;
+        }
+    }
+};
+
+#endif
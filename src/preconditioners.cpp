@@ -0,0 +1,150 @@
+#include "preconditioners.hpp"
+#include <stdexcept>
+#include <utility>
+
+#include "parallel.hpp"
+
+JacobiPreconditioner::JacobiPreconditioner( Matrix const &matrix )
+{
+    if( matrix.dimensions().first != matrix.dimensions().second )
+    {
+        throw std::domain_error( "Operator matrix should be square!" );
+    }
+
+    std::vector< value_t > diagonal( matrix.dimensions().first );
+
+    for( position_t i = 0; i < diagonal.size(); ++i )
+    {
+        diagonal[i] = matrix[i][i];
+    }
+
+    invert( std::move( diagonal ) );
+}
+
+JacobiPreconditioner::JacobiPreconditioner( SparseMatrix const &matrix )
+{
+    if( matrix.dimensions().first != matrix.dimensions().second )
+    {
+        throw std::domain_error( "Operator matrix should be square!" );
+    }
+
+    invert( matrix.diagonal() );
+}
+
+void JacobiPreconditioner::invert( std::vector< value_t > diagonal )
+{
+    for( value_t &value : diagonal )
+    {
+        if( value == 0.0 )
+        {
+            throw std::domain_error( "Jacobi preconditioner needs a non zero diagonal!" );
+        }
+
+        value = 1.0 / value;
+    }
+
+    _inverse_diagonal = std::move( diagonal );
+}
+
+void JacobiPreconditioner::apply( value_t const *r, value_t *z ) const
+{
+    value_t const *inverse = _inverse_diagonal.data();
+
+    parallel_for( _inverse_diagonal.size(), [r, z, inverse]( std::size_t begin, std::size_t end ) {
+        for( std::size_t i = begin; i < end; ++i )
+        {
+            z[i] = r[i] * inverse[i];
+        }
+    } );
+}
+
+ILU0Preconditioner::ILU0Preconditioner( SparseMatrix const &matrix )
+    : _size( matrix.dimensions().first )
+    , _line_offsets( matrix.line_offsets() )
+    , _column_indexes( matrix.column_indexes() )
+    , _values( matrix.values() )
+    , _diagonal( _size )
+{
+    if( matrix.dimensions().first != matrix.dimensions().second )
+    {
+        throw std::domain_error( "Operator matrix should be square!" );
+    }
+
+    // Position of every column of the current line in _values, or NONE
+    const std::size_t NONE = _values.size();
+    std::vector< std::size_t > position( _size, NONE );
+
+    for( position_t i = 0; i < _size; ++i )
+    {
+        const std::size_t first = _line_offsets[i];
+        const std::size_t last = _line_offsets[i + 1];
+
+        for( std::size_t k = first; k < last; ++k )
+        {
+            position[_column_indexes[k]] = k;
+        }
+
+        std::size_t k = first;
+
+        // Eliminates with every previous line j < i the pattern references
+        for( ; ( k < last ) && ( _column_indexes[k] < i ); ++k )
+        {
+            const position_t j = _column_indexes[k];
+
+            _values[k] /= _values[_diagonal[j]];
+
+            const value_t factor = _values[k];
+
+            for( std::size_t u = _diagonal[j] + 1; u < _line_offsets[j + 1]; ++u )
+            {
+                const std::size_t target = position[_column_indexes[u]];
+
+                if( target != NONE )
+                {
+                    _values[target] -= factor * _values[u];
+                }
+            }
+        }
+
+        if( ( k == last ) || ( _column_indexes[k] != i ) || ( _values[k] == 0.0 ) )
+        {
+            throw std::domain_error( "ILU(0) needs a non zero diagonal!" );
+        }
+
+        _diagonal[i] = k;
+
+        for( std::size_t p = first; p < last; ++p )
+        {
+            position[_column_indexes[p]] = NONE;
+        }
+    }
+}
+
+void ILU0Preconditioner::apply( value_t const *r, value_t *z ) const
+{
+    // L y = r, unit diagonal
+    for( position_t i = 0; i < _size; ++i )
+    {
+        value_t sum = r[i];
+
+        for( std::size_t k = _line_offsets[i]; k < _diagonal[i]; ++k )
+        {
+            sum -= _values[k] * z[_column_indexes[k]];
+        }
+
+        z[i] = sum;
+    }
+
+    // U z = y
+    for( position_t i = _size; i-- > 0; )
+    {
+        value_t sum = z[i];
+
+        for( std::size_t k = _diagonal[i] + 1; k < _line_offsets[i + 1]; ++k )
+        {
+            sum -= _values[k] * z[_column_indexes[k]];
+        }
+
+        z[i] = sum / _values[_diagonal[i]];
+    }
+}
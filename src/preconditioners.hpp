@@ -0,0 +1,56 @@
+#ifndef PRECONDITIONERS_H
+#define PRECONDITIONERS_H
+
+#include <cstddef>
+#include <vector>
+
+#include "matrix.hpp"
+#include "sparse_matrix.hpp"
+
+// Approximate inverse M^-1 of an operator, applied once per iteration by
+// the iterative solvers. apply() must not allocate.
+class Preconditioner
+{
+    public:
+    virtual ~Preconditioner( void )
+    {
+    }
+
+    // z = M^-1 * r, z never overlaps r
+    virtual void apply( value_t const *r, value_t *z ) const = 0;
+};
+
+// M = diag(A)
+class JacobiPreconditioner : public Preconditioner
+{
+    public:
+    explicit JacobiPreconditioner( Matrix const &matrix );
+    explicit JacobiPreconditioner( SparseMatrix const &matrix );
+
+    void apply( value_t const *r, value_t *z ) const override;
+
+    private:
+    std::vector< value_t > _inverse_diagonal;
+
+    void invert( std::vector< value_t > diagonal );
+};
+
+// Incomplete LU with no fill: L (unit diagonal) and U keep the sparsity
+// pattern of A, stored together in CSR order like the matrix.
+class ILU0Preconditioner : public Preconditioner
+{
+    public:
+    explicit ILU0Preconditioner( SparseMatrix const &matrix );
+
+    void apply( value_t const *r, value_t *z ) const override;
+
+    private:
+    position_t _size;
+    std::vector< std::size_t > _line_offsets;
+    std::vector< position_t > _column_indexes;
+    std::vector< value_t > _values;
+    // Position of the diagonal entry of every line
+    std::vector< std::size_t > _diagonal;
+};
+
+#endif
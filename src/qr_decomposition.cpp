@@ -0,0 +1,219 @@
+#include "qr_decomposition.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "parallel.hpp"
+
+QRDecomposition::QRDecomposition( Matrix const &matrix )
+    : _factors( matrix )
+{
+    const position_t m = matrix.dimensions().first;
+    const position_t n = matrix.dimensions().second;
+    const position_t steps = std::min( m, n );
+    std::vector< value_t > reflector;
+    std::vector< value_t > product;
+
+    _tau.assign( steps, 0.0 );
+
+    for( position_t k = 0; k < steps; ++k )
+    {
+        value_t tail = 0.0;
+
+        for( position_t i = k + 1; i < m; ++i )
+        {
+            tail += _factors[i][k] * _factors[i][k];
+        }
+
+        const value_t head = _factors[k][k];
+
+        // Nothing below the diagonal, H_k is the identity
+        if( tail == 0.0 )
+        {
+            continue;
+        }
+
+        const value_t norm = std::sqrt( head * head + tail );
+        const value_t beta = ( head >= 0.0 ) ? -norm : norm;
+        const value_t scale = 1.0 / ( head - beta );
+
+        _tau[k] = ( beta - head ) / beta;
+        _factors[k][k] = beta;
+
+        for( position_t i = k + 1; i < m; ++i )
+        {
+            _factors[i][k] *= scale;
+        }
+
+        apply_reflector( k, _factors, k + 1, reflector, product );
+    }
+}
+
+void QRDecomposition::apply_reflector( position_t const &k,
+                                       Matrix &target,
+                                       position_t const &first_column,
+                                       std::vector< value_t > &reflector,
+                                       std::vector< value_t > &product ) const
+{
+    const position_t m = _factors.dimensions().first;
+    const position_t columns = target.dimensions().second;
+    const value_t tau = _tau[k];
+
+    if( ( tau == 0.0 ) || ( first_column >= columns ) )
+    {
+        return;
+    }
+
+    const std::size_t width = columns - first_column;
+
+    reflector.resize( m - k );
+    reflector[0] = 1.0;
+
+    for( position_t i = k + 1; i < m; ++i )
+    {
+        reflector[i - k] = _factors[i][k];
+    }
+
+    // product = v^T target, one pass over the lines
+    product.assign( width, 0.0 );
+
+    for( position_t i = k; i < m; ++i )
+    {
+        value_t const *line = static_cast< Matrix const & >( target )[i] + first_column;
+        const value_t factor = reflector[i - k];
+
+        for( std::size_t j = 0; j < width; ++j )
+        {
+            product[j] += factor * line[j];
+        }
+    }
+
+    // target -= tau v product
+    value_t *data = target[0] + first_column;
+    value_t const *v = reflector.data();
+    value_t const *w = product.data();
+
+    parallel_for( m - k,
+                  [=]( std::size_t begin, std::size_t end ) {
+                      for( std::size_t i = begin; i < end; ++i )
+                      {
+                          value_t *line = data + ( k + i ) * columns;
+                          const value_t factor = tau * v[i];
+
+                          for( std::size_t j = 0; j < width; ++j )
+                          {
+                              line[j] -= factor * w[j];
+                          }
+                      }
+                  },
+                  width );
+}
+
+Matrix QRDecomposition::thin_q( void ) const
+{
+    const position_t m = _factors.dimensions().first;
+    const position_t p = static_cast< position_t >( _tau.size() );
+    Matrix q = Matrix::identity_matrix( m, p );
+    std::vector< value_t > reflector;
+    std::vector< value_t > product;
+
+    // Q = H_0 ... H_(p-1) applied to the first p columns of the identity
+    for( position_t k = p; k-- > 0; )
+    {
+        apply_reflector( k, q, k, reflector, product );
+    }
+
+    return q;
+}
+
+Matrix QRDecomposition::r( void ) const
+{
+    const position_t p = static_cast< position_t >( _tau.size() );
+    const position_t n = _factors.dimensions().second;
+    Matrix result;
+
+    result.reset_dimensions( p, n );
+
+    for( position_t i = 0; i < p; ++i )
+    {
+        value_t const *source = _factors[i];
+        value_t *line = result[i];
+
+        std::fill( line, line + i, 0.0 );
+        std::copy( source + i, source + n, line + i );
+    }
+
+    return result;
+}
+
+Matrix QRDecomposition::solve( Matrix const &rhs ) const
+{
+    const position_t m = _factors.dimensions().first;
+    const position_t n = _factors.dimensions().second;
+
+    if( m < n )
+    {
+        throw std::domain_error( "Least squares needs at least as many lines as columns!" );
+    }
+
+    if( rhs.dimensions().first != m )
+    {
+        throw std::domain_error( "Right hand side lines count differs from matrix lines count!" );
+    }
+
+    Matrix work( rhs );
+    std::vector< value_t > reflector;
+    std::vector< value_t > product;
+    const position_t columns = rhs.dimensions().second;
+
+    // Q^T rhs
+    for( position_t k = 0; k < n; ++k )
+    {
+        apply_reflector( k, work, 0, reflector, product );
+    }
+
+    // Pivots negligible next to the largest one mean dependent columns
+    value_t largest = 0.0;
+
+    for( position_t i = 0; i < n; ++i )
+    {
+        largest = std::max( largest, std::fabs( _factors[i][i] ) );
+    }
+
+    const value_t negligible = largest * std::numeric_limits< value_t >::epsilon() * m;
+    Matrix result;
+
+    result.reset_dimensions( n, columns );
+
+    for( position_t i = n; i-- > 0; )
+    {
+        value_t const *r_line = _factors[i];
+        value_t *line = result[i];
+
+        if( std::fabs( r_line[i] ) <= negligible )
+        {
+            throw std::domain_error( "Matrix is rank deficient!" );
+        }
+
+        std::copy( work[i], work[i] + columns, line );
+
+        for( position_t k = i + 1; k < n; ++k )
+        {
+            value_t const *known = result[k];
+            const value_t factor = r_line[k];
+
+            for( position_t j = 0; j < columns; ++j )
+            {
+                line[j] -= factor * known[j];
+            }
+        }
+
+        for( position_t j = 0; j < columns; ++j )
+        {
+            line[j] /= r_line[i];
+        }
+    }
+
+    return result;
+}
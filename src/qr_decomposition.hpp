@@ -0,0 +1,39 @@
+#ifndef QR_DECOMPOSITION_H
+#define QR_DECOMPOSITION_H
+
+#include <vector>
+
+#include "matrix.hpp"
+
+// A = QR by Householder reflections, for any lines x columns matrix.
+// R is stored above the diagonal and the reflector vectors (leading 1
+// implied) below it, as LAPACK does. Reflections are applied line by line,
+// so every update walks unit stride memory, and their lines are split over
+// the thread pool.
+class QRDecomposition
+{
+    public:
+    QRDecomposition( Matrix const &matrix );
+
+    // lines x min(lines, columns), orthonormal columns
+    Matrix thin_q( void ) const;
+    // min(lines, columns) x columns, upper triangular
+    Matrix r( void ) const;
+
+    // Least squares solution of A X = rhs, needs lines >= columns and a
+    // full rank A
+    Matrix solve( Matrix const &rhs ) const;
+
+    private:
+    Matrix _factors;
+    std::vector< value_t > _tau;
+
+    // H_k * target for lines [k, lines) of target, columns [first_column, end)
+    void apply_reflector( position_t const &k,
+                          Matrix &target,
+                          position_t const &first_column,
+                          std::vector< value_t > &reflector,
+                          std::vector< value_t > &product ) const;
+};
+
+#endif
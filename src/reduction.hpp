@@ -0,0 +1,93 @@
+#ifndef REDUCTION_H
+#define REDUCTION_H
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+// Statistics gathered in a single pass over a set of values. Partial
+// reductions over disjoint ranges can be combined with merge().
+template < typename Scalar >
+struct Reduction
+{
+    std::size_t count = 0;
+    Scalar sum = 0.0;
+    Scalar sum_of_squares = 0.0;
+    Scalar absolute_sum = 0.0;
+    Scalar max_absolute = 0.0;
+    Scalar minimum = std::numeric_limits< Scalar >::infinity();
+    Scalar maximum = -std::numeric_limits< Scalar >::infinity();
+    // Positions of the first minimum and maximum found
+    std::size_t minimum_index = 0;
+    std::size_t maximum_index = 0;
+
+    constexpr void accumulate( Scalar const &value, std::size_t const &index )
+    {
+        const Scalar absolute = ( value < 0 ) ? -value : value;
+
+        ++count;
+        sum += value;
+        sum_of_squares += value * value;
+        absolute_sum += absolute;
+
+        if( absolute > max_absolute )
+        {
+            max_absolute = absolute;
+        }
+
+        if( value < minimum )
+        {
+            minimum = value;
+            minimum_index = index;
+        }
+
+        if( value > maximum )
+        {
+            maximum = value;
+            maximum_index = index;
+        }
+    }
+
+    // other must cover positions after the ones already accumulated
+    constexpr void merge( Reduction< Scalar > const &other )
+    {
+        count += other.count;
+        sum += other.sum;
+        sum_of_squares += other.sum_of_squares;
+        absolute_sum += other.absolute_sum;
+
+        if( other.max_absolute > max_absolute )
+        {
+            max_absolute = other.max_absolute;
+        }
+
+        if( other.minimum < minimum )
+        {
+            minimum = other.minimum;
+            minimum_index = other.minimum_index;
+        }
+
+        if( other.maximum > maximum )
+        {
+            maximum = other.maximum;
+            maximum_index = other.maximum_index;
+        }
+    }
+
+    constexpr Scalar l1_norm( void ) const
+    {
+        return absolute_sum;
+    }
+
+    Scalar l2_norm( void ) const
+    {
+        return std::sqrt( sum_of_squares );
+    }
+
+    constexpr Scalar linf_norm( void ) const
+    {
+        return max_absolute;
+    }
+};
+
+#endif
@@ -0,0 +1,310 @@
+#include "shared_matrix.hpp"
+#include <atomic>
+#include <cerrno>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <system_error>
+#include <unistd.h>
+
+static_assert( ATOMIC_LLONG_LOCK_FREE == 2, "Shared segments need lock free 64 bit atomics!" );
+
+namespace
+{
+const std::uint32_t MAGIC = 0x4d545831;
+const std::uint32_t FORMAT_VERSION = 1;
+const std::size_t BUFFER_ALIGNMENT = 64;
+}
+
+struct SharedMatrixHeader
+{
+    struct Slot
+    {
+        std::atomic< std::uint32_t > lines;
+        std::atomic< std::uint32_t > columns;
+        std::atomic< std::uint32_t > layout;
+    };
+
+    // Written last by the creator, readers reject the segment until then
+    std::atomic< std::uint32_t > magic;
+    std::uint32_t format;
+    std::uint64_t capacity;
+    // Last published sequence, its matrix is in slot sequence % 2
+    std::atomic< std::uint64_t > published;
+    // Sequence being written, equal to published when the writer is idle
+    std::atomic< std::uint64_t > writing;
+    Slot slots[2];
+};
+
+namespace
+{
+std::size_t buffers_offset( void )
+{
+    return ( ( sizeof( SharedMatrixHeader ) + BUFFER_ALIGNMENT - 1 ) / BUFFER_ALIGNMENT ) *
+           BUFFER_ALIGNMENT;
+}
+
+std::size_t segment_size( std::size_t const &capacity )
+{
+    return buffers_offset() + 2 * capacity * sizeof( value_t );
+}
+
+[[noreturn]] void throw_system_error( char const *what )
+{
+    throw std::system_error( errno, std::generic_category(), what );
+}
+
+void assert_name( std::string const &name )
+{
+    if( ( name.size() < 2 ) || ( name[0] != '/' ) )
+    {
+        throw std::domain_error( "Shared segment name should start with '/'!" );
+    }
+}
+}
+
+SharedMatrixWriter::SharedMatrixWriter( std::string const &name, std::size_t const &capacity )
+    : _name( name )
+    , _capacity( capacity )
+    , _size( segment_size( capacity ) )
+{
+    assert_name( name );
+
+    const int descriptor = shm_open( name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600 );
+
+    if( descriptor < 0 )
+    {
+        throw_system_error( "shm_open" );
+    }
+
+    if( ftruncate( descriptor, static_cast< off_t >( _size ) ) < 0 )
+    {
+        const int error = errno;
+
+        close( descriptor );
+        shm_unlink( name.c_str() );
+        throw std::system_error( error, std::generic_category(), "ftruncate" );
+    }
+
+    _mapping = mmap( nullptr, _size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0 );
+    close( descriptor );
+
+    if( _mapping == MAP_FAILED )
+    {
+        const int error = errno;
+
+        shm_unlink( name.c_str() );
+        throw std::system_error( error, std::generic_category(), "mmap" );
+    }
+
+    // The new segment is zero filled, atomics of zero are valid objects
+    _header = static_cast< SharedMatrixHeader * >( _mapping );
+    _buffers = reinterpret_cast< value_t * >( static_cast< char * >( _mapping ) + buffers_offset() );
+
+    _header->format = FORMAT_VERSION;
+    _header->capacity = capacity;
+    _header->published.store( 0 );
+    _header->writing.store( 0 );
+    _header->magic.store( MAGIC, std::memory_order_release );
+}
+
+SharedMatrixWriter::~SharedMatrixWriter( void )
+{
+    munmap( _mapping, _size );
+    shm_unlink( _name.c_str() );
+}
+
+std::string const &SharedMatrixWriter::name( void ) const
+{
+    return _name;
+}
+
+std::size_t SharedMatrixWriter::capacity( void ) const
+{
+    return _capacity;
+}
+
+std::uint64_t SharedMatrixWriter::sequence( void ) const
+{
+    return _header->published.load( std::memory_order_relaxed );
+}
+
+value_t *SharedMatrixWriter::prepare( position_t const &lines,
+                                     position_t const &columns,
+                                     StorageOrder const &order )
+{
+    if( static_cast< std::size_t >( lines ) * columns > _capacity )
+    {
+        throw std::domain_error( "Matrix does not fit in the shared segment!" );
+    }
+
+    const std::uint64_t next = _header->published.load( std::memory_order_relaxed ) + 1;
+    SharedMatrixHeader::Slot &slot = _header->slots[next % 2];
+
+    // Readers of sequence next - 2 see this before any value changes
+    _header->writing.store( next, std::memory_order_relaxed );
+    std::atomic_thread_fence( std::memory_order_release );
+
+    slot.lines.store( lines, std::memory_order_relaxed );
+    slot.columns.store( columns, std::memory_order_relaxed );
+    slot.layout.store( static_cast< std::uint32_t >( order ), std::memory_order_relaxed );
+
+    return _buffers + ( next % 2 ) * _capacity;
+}
+
+void SharedMatrixWriter::publish( void )
+{
+    const std::uint64_t next = _header->writing.load( std::memory_order_relaxed );
+
+    if( next == _header->published.load( std::memory_order_relaxed ) )
+    {
+        throw std::domain_error( "Nothing was prepared to be published!" );
+    }
+
+    _header->published.store( next, std::memory_order_release );
+}
+
+void SharedMatrixWriter::publish( Matrix const &matrix )
+{
+    const MatrixDimensions dimensions = matrix.dimensions();
+    value_t *target = prepare( dimensions.first, dimensions.second );
+    const std::size_t count = static_cast< std::size_t >( dimensions.first ) * dimensions.second;
+
+    if( count > 0 )
+    {
+        std::copy( matrix[0], matrix[0] + count, target );
+    }
+
+    publish();
+}
+
+SharedMatrixReader::SharedMatrixReader( std::string const &name )
+{
+    assert_name( name );
+
+    const int descriptor = shm_open( name.c_str(), O_RDONLY, 0 );
+    struct stat status;
+
+    if( descriptor < 0 )
+    {
+        throw_system_error( "shm_open" );
+    }
+
+    if( fstat( descriptor, &status ) < 0 )
+    {
+        const int error = errno;
+
+        close( descriptor );
+        throw std::system_error( error, std::generic_category(), "fstat" );
+    }
+
+    _size = static_cast< std::size_t >( status.st_size );
+
+    if( _size < buffers_offset() )
+    {
+        close( descriptor );
+        throw std::domain_error( "Shared segment is not a matrix segment!" );
+    }
+
+    _mapping = mmap( nullptr, _size, PROT_READ, MAP_SHARED, descriptor, 0 );
+    close( descriptor );
+
+    if( _mapping == MAP_FAILED )
+    {
+        throw_system_error( "mmap" );
+    }
+
+    _header = static_cast< SharedMatrixHeader const * >( _mapping );
+    _buffers = reinterpret_cast< value_t const * >( static_cast< char const * >( _mapping ) +
+                                                    buffers_offset() );
+
+    if( ( _header->magic.load( std::memory_order_acquire ) != MAGIC ) ||
+        ( _header->format != FORMAT_VERSION ) || ( segment_size( _header->capacity ) > _size ) )
+    {
+        munmap( _mapping, _size );
+        throw std::domain_error( "Shared segment is not a matrix segment!" );
+    }
+}
+
+SharedMatrixReader::~SharedMatrixReader( void )
+{
+    munmap( _mapping, _size );
+}
+
+std::size_t SharedMatrixReader::capacity( void ) const
+{
+    return _header->capacity;
+}
+
+std::uint64_t SharedMatrixReader::sequence( void ) const
+{
+    return _header->published.load( std::memory_order_acquire );
+}
+
+bool SharedMatrixReader::acquire( SharedMatrixSnapshot &snapshot ) const
+{
+    // Dimensions are read again when the writer started reusing the slot
+    // meanwhile, so the view never points past the buffer
+    for( ;; )
+    {
+        const std::uint64_t sequence = _header->published.load( std::memory_order_acquire );
+
+        if( sequence == 0 )
+        {
+            return false;
+        }
+
+        SharedMatrixHeader::Slot const &slot = _header->slots[sequence % 2];
+        const std::uint32_t layout = slot.layout.load( std::memory_order_relaxed );
+        const position_t lines = slot.lines.load( std::memory_order_relaxed );
+        const position_t columns = slot.columns.load( std::memory_order_relaxed );
+
+        snapshot.sequence = sequence;
+
+        if( !is_valid( snapshot ) )
+        {
+            continue;
+        }
+
+        if( ( layout != static_cast< std::uint32_t >( StorageOrder::line_major ) ) &&
+            ( layout != static_cast< std::uint32_t >( StorageOrder::column_major ) ) )
+        {
+            throw std::domain_error( "Unsupported shared matrix layout!" );
+        }
+
+        snapshot.view = MatrixView( _buffers + ( sequence % 2 ) * _header->capacity,
+                                    lines,
+                                    columns,
+                                    static_cast< StorageOrder >( layout ) );
+
+        return true;
+    }
+}
+
+bool SharedMatrixReader::is_valid( SharedMatrixSnapshot const &snapshot ) const
+{
+    std::atomic_thread_fence( std::memory_order_acquire );
+
+    return _header->writing.load( std::memory_order_relaxed ) < snapshot.sequence + 2;
+}
+
+Matrix SharedMatrixReader::latest( void ) const
+{
+    SharedMatrixSnapshot snapshot;
+
+    for( ;; )
+    {
+        if( !acquire( snapshot ) )
+        {
+            throw std::domain_error( "No matrix was published yet!" );
+        }
+
+        Matrix result = snapshot.view.to_matrix();
+
+        if( is_valid( snapshot ) )
+        {
+            return result;
+        }
+    }
+}
@@ -0,0 +1,95 @@
+#ifndef SHARED_MATRIX_H
+#define SHARED_MATRIX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "matrix.hpp"
+#include "matrix_view.hpp"
+
+// Layout of a named POSIX shared memory segment, defined in the source
+struct SharedMatrixHeader;
+
+// A published matrix seen by a reader, pointing straight into the segment
+struct SharedMatrixSnapshot
+{
+    MatrixView view;
+    // Publication number, starting at 1
+    std::uint64_t sequence = 0;
+};
+
+// Producer side of a shared memory segment holding matrixes of up to
+// capacity elements. The segment has a small header (dimensions, layout and
+// publication sequence) and two buffers: a matrix is written into the one
+// readers are not looking at and made visible by a single atomic store of
+// its sequence number, so readers never see a half written matrix and no
+// lock is taken on either side. There must be a single writer per segment.
+//
+// The writer creates the segment (which must not exist yet) and removes it
+// when destroyed; readers already attached keep their mapping.
+class SharedMatrixWriter
+{
+    public:
+    // name must start with '/', as required by shm_open
+    SharedMatrixWriter( std::string const &name, std::size_t const &capacity );
+    ~SharedMatrixWriter( void );
+
+    SharedMatrixWriter( SharedMatrixWriter const & ) = delete;
+    SharedMatrixWriter &operator=( SharedMatrixWriter const & ) = delete;
+
+    std::string const &name( void ) const;
+    std::size_t capacity( void ) const;
+    // Sequence of the last published matrix, 0 before the first one
+    std::uint64_t sequence( void ) const;
+
+    // Buffer to write the next lines x columns matrix into, in the given
+    // order. Nothing is visible to readers until publish().
+    value_t *prepare( position_t const &lines,
+                      position_t const &columns,
+                      StorageOrder const &order = StorageOrder::line_major );
+    void publish( void );
+    // prepare(), one bulk copy of matrix and publish()
+    void publish( Matrix const &matrix );
+
+    private:
+    std::string _name;
+    std::size_t _capacity;
+    std::size_t _size;
+    void *_mapping;
+    SharedMatrixHeader *_header;
+    value_t *_buffers;
+};
+
+// Consumer side, attaches read-only to a segment created by a
+// SharedMatrixWriter, possibly in another process.
+class SharedMatrixReader
+{
+    public:
+    explicit SharedMatrixReader( std::string const &name );
+    ~SharedMatrixReader( void );
+
+    SharedMatrixReader( SharedMatrixReader const & ) = delete;
+    SharedMatrixReader &operator=( SharedMatrixReader const & ) = delete;
+
+    std::size_t capacity( void ) const;
+    std::uint64_t sequence( void ) const;
+
+    // Zero copy view of the latest published matrix, false when nothing was
+    // published yet. The view stays intact until the writer starts the
+    // second publication after it.
+    bool acquire( SharedMatrixSnapshot &snapshot ) const;
+    // True when the writer has not started overwriting the snapshot buffer.
+    // Checking after reading the values guarantees they were consistent.
+    bool is_valid( SharedMatrixSnapshot const &snapshot ) const;
+    // Copy of the latest published matrix, retried until consistent
+    Matrix latest( void ) const;
+
+    private:
+    std::size_t _size;
+    void *_mapping;
+    SharedMatrixHeader const *_header;
+    value_t const *_buffers;
+};
+
+#endif
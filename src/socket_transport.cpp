@@ -0,0 +1,494 @@
+#include "socket_transport.hpp"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/un.h>
+#include <system_error>
+#include <unistd.h>
+
+namespace
+{
+struct MessageHeader
+{
+    std::int32_t tag;
+    std::uint64_t count;
+};
+
+[[noreturn]] void throw_system_error( char const *what )
+{
+    throw std::system_error( errno, std::generic_category(), what );
+}
+
+// False when the connection was closed or failed
+bool write_all( int const &socket, void const *data, std::size_t size )
+{
+    char const *bytes = static_cast< char const * >( data );
+
+    while( size > 0 )
+    {
+        const ssize_t written = ::send( socket, bytes, size, MSG_NOSIGNAL );
+
+        if( written < 0 )
+        {
+            if( errno == EINTR )
+            {
+                continue;
+            }
+
+            return false;
+        }
+
+        bytes += written;
+        size -= static_cast< std::size_t >( written );
+    }
+
+    return true;
+}
+
+bool read_all( int const &socket, void *data, std::size_t size )
+{
+    char *bytes = static_cast< char * >( data );
+
+    while( size > 0 )
+    {
+        const ssize_t received = ::recv( socket, bytes, size, 0 );
+
+        if( received < 0 )
+        {
+            if( errno == EINTR )
+            {
+                continue;
+            }
+
+            return false;
+        }
+
+        if( received == 0 )
+        {
+            return false;
+        }
+
+        bytes += received;
+        size -= static_cast< std::size_t >( received );
+    }
+
+    return true;
+}
+}
+
+std::unique_ptr< SocketTransport > SocketTransport::unix_domain( std::string const &directory,
+                                                                 int const &rank,
+                                                                 int const &size,
+                                                                 Timeout const &timeout )
+{
+    auto path_of = [directory]( int const &peer ) -> std::string {
+        return directory + "/rank_" + std::to_string( peer ) + ".sock";
+    };
+
+    Addressing addressing = [path_of]( int const &peer, sockaddr_storage &storage ) -> socklen_t {
+        const std::string path = path_of( peer );
+        sockaddr_un *address = reinterpret_cast< sockaddr_un * >( &storage );
+
+        if( path.size() >= sizeof( address->sun_path ) )
+        {
+            throw std::domain_error( "Unix socket path is too long!" );
+        }
+
+        std::memset( &storage, 0, sizeof( storage ) );
+        address->sun_family = AF_UNIX;
+        std::strcpy( address->sun_path, path.c_str() );
+
+        return sizeof( sockaddr_un );
+    };
+
+    return std::unique_ptr< SocketTransport >(
+        new SocketTransport( AF_UNIX, addressing, path_of( rank ), rank, size, timeout ) );
+}
+
+std::unique_ptr< SocketTransport > SocketTransport::tcp( std::string const &address,
+                                                         unsigned short const &base_port,
+                                                         int const &rank,
+                                                         int const &size,
+                                                         Timeout const &timeout )
+{
+    in_addr host;
+
+    if( inet_pton( AF_INET, address.c_str(), &host ) != 1 )
+    {
+        throw std::domain_error( "Invalid IPv4 address!" );
+    }
+
+    Addressing addressing = [host, base_port]( int const &peer,
+                                               sockaddr_storage &storage ) -> socklen_t {
+        sockaddr_in *address = reinterpret_cast< sockaddr_in * >( &storage );
+
+        std::memset( &storage, 0, sizeof( storage ) );
+        address->sin_family = AF_INET;
+        address->sin_addr = host;
+        address->sin_port = htons( static_cast< unsigned short >( base_port + peer ) );
+
+        return sizeof( sockaddr_in );
+    };
+
+    return std::unique_ptr< SocketTransport >(
+        new SocketTransport( AF_INET, addressing, std::string(), rank, size, timeout ) );
+}
+
+std::unique_ptr< SocketTransport > SocketTransport::tcp( std::string const &address,
+                                                         PortPublisher const &publish,
+                                                         PortLookup const &port_of,
+                                                         int const &rank,
+                                                         int const &size,
+                                                         Timeout const &timeout )
+{
+    in_addr host;
+
+    if( inet_pton( AF_INET, address.c_str(), &host ) != 1 )
+    {
+        throw std::domain_error( "Invalid IPv4 address!" );
+    }
+
+    // Port 0 for our own listener, an unknown peer port fails to connect
+    // and is asked again on the next attempt
+    Addressing addressing = [host, rank, port_of]( int const &peer,
+                                                   sockaddr_storage &storage ) -> socklen_t {
+        sockaddr_in *address = reinterpret_cast< sockaddr_in * >( &storage );
+
+        std::memset( &storage, 0, sizeof( storage ) );
+        address->sin_family = AF_INET;
+        address->sin_addr = host;
+        address->sin_port = htons( ( peer == rank ) ? 0 : port_of( peer ) );
+
+        return sizeof( sockaddr_in );
+    };
+
+    Listening listening = [publish, rank]( int const &listener ) {
+        sockaddr_in bound;
+        socklen_t length = sizeof( bound );
+
+        if( ::getsockname( listener, reinterpret_cast< sockaddr * >( &bound ), &length ) < 0 )
+        {
+            throw_system_error( "getsockname" );
+        }
+
+        publish( rank, ntohs( bound.sin_port ) );
+    };
+
+    return std::unique_ptr< SocketTransport >(
+        new SocketTransport( AF_INET, addressing, std::string(), rank, size, timeout, listening ) );
+}
+
+SocketTransport::SocketTransport( int const &domain,
+                                  Addressing const &addressing,
+                                  std::string const &unix_path,
+                                  int const &rank,
+                                  int const &size,
+                                  Timeout const &timeout,
+                                  Listening const &listening )
+    : _rank( rank )
+    , _size( size )
+    , _listener( -1 )
+    , _unix_path( unix_path )
+    , _sockets( size, -1 )
+{
+    if( ( size < 1 ) || ( rank < 0 ) || ( rank >= size ) )
+    {
+        throw std::out_of_range( "Rank out of range!" );
+    }
+
+    for( int i = 0; i < size; ++i )
+    {
+        _send_mutexes.emplace_back( new std::mutex() );
+    }
+
+    try
+    {
+        connect_mesh( domain, addressing, listening, timeout );
+    }
+    catch( ... )
+    {
+        close_all();
+        throw;
+    }
+
+    for( int peer = 0; peer < size; ++peer )
+    {
+        if( peer != rank )
+        {
+            _readers.emplace_back( &SocketTransport::read_from, this, peer );
+        }
+    }
+}
+
+SocketTransport::~SocketTransport( void )
+{
+    // Stop sending, then wait for every peer to do the same
+    for( int socket : _sockets )
+    {
+        if( socket >= 0 )
+        {
+            ::shutdown( socket, SHUT_WR );
+        }
+    }
+
+    for( std::thread &reader : _readers )
+    {
+        reader.join();
+    }
+
+    close_all();
+}
+
+int SocketTransport::rank( void ) const
+{
+    return _rank;
+}
+
+int SocketTransport::size( void ) const
+{
+    return _size;
+}
+
+void SocketTransport::send( int const &destination,
+                            int const &tag,
+                            std::vector< value_t > const &data )
+{
+    if( ( destination < 0 ) || ( destination >= _size ) )
+    {
+        throw std::out_of_range( "Rank out of range!" );
+    }
+
+    if( destination == _rank )
+    {
+        _mailbox.deliver( _rank, tag, std::vector< value_t >( data ) );
+        return;
+    }
+
+    if( data.size() > MAXIMUM_MESSAGE_VALUES )
+    {
+        throw std::domain_error( "Message is too large for a socket transport!" );
+    }
+
+    // Value initialized, the padding bytes go on the wire too
+    MessageHeader header{};
+
+    header.tag = tag;
+    header.count = data.size();
+
+    std::lock_guard< std::mutex > lock( *_send_mutexes[destination] );
+
+    if( !write_all( _sockets[destination], &header, sizeof( header ) ) ||
+        !write_all( _sockets[destination], data.data(), data.size() * sizeof( value_t ) ) )
+    {
+        throw TransportClosed();
+    }
+}
+
+std::vector< value_t > SocketTransport::receive( int const &source, int const &tag )
+{
+    if( ( source < 0 ) || ( source >= _size ) )
+    {
+        throw std::out_of_range( "Rank out of range!" );
+    }
+
+    return _mailbox.take( source, tag );
+}
+
+void SocketTransport::connect_mesh( int const &domain,
+                                    Addressing const &addressing,
+                                    Listening const &listening,
+                                    Timeout const &timeout )
+{
+    sockaddr_storage storage;
+    socklen_t length = addressing( _rank, storage );
+    const int enabled = 1;
+
+    _listener = ::socket( domain, SOCK_STREAM, 0 );
+
+    if( _listener < 0 )
+    {
+        throw_system_error( "socket" );
+    }
+
+    if( domain == AF_UNIX )
+    {
+        ::unlink( _unix_path.c_str() );
+    }
+    else
+    {
+        ::setsockopt( _listener, SOL_SOCKET, SO_REUSEADDR, &enabled, sizeof( enabled ) );
+    }
+
+    if( ::bind( _listener, reinterpret_cast< sockaddr * >( &storage ), length ) < 0 )
+    {
+        throw_system_error( "bind" );
+    }
+
+    if( ::listen( _listener, _size ) < 0 )
+    {
+        throw_system_error( "listen" );
+    }
+
+    if( listening )
+    {
+        listening( _listener );
+    }
+
+    const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + timeout;
+
+    // Lower ranks may not be listening yet, connecting is retried until the
+    // deadline
+    for( int peer = 0; peer < _rank; ++peer )
+    {
+        for( ;; )
+        {
+            length = addressing( peer, storage );
+
+            const int socket = ::socket( domain, SOCK_STREAM, 0 );
+
+            if( socket < 0 )
+            {
+                throw_system_error( "socket" );
+            }
+
+            if( ::connect( socket, reinterpret_cast< sockaddr * >( &storage ), length ) == 0 )
+            {
+                _sockets[peer] = socket;
+                break;
+            }
+
+            ::close( socket );
+
+            if( std::chrono::steady_clock::now() >= deadline )
+            {
+                throw std::runtime_error( "Timed out connecting to rank " + std::to_string( peer ) +
+                                          "!" );
+            }
+
+            std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+        }
+
+        const std::int32_t identity = _rank;
+
+        if( !write_all( _sockets[peer], &identity, sizeof( identity ) ) )
+        {
+            throw TransportClosed();
+        }
+    }
+
+    // Higher ranks connect to us and introduce themselves, accept() only
+    // runs once poll() reports a pending connection before the deadline
+    for( int accepted = _rank + 1; accepted < _size; ++accepted )
+    {
+        pollfd pending{};
+
+        pending.fd = _listener;
+        pending.events = POLLIN;
+
+        for( ;; )
+        {
+            const auto remaining = std::chrono::duration_cast< std::chrono::milliseconds >(
+                deadline - std::chrono::steady_clock::now() );
+
+            if( remaining.count() <= 0 )
+            {
+                throw std::runtime_error( "Timed out waiting for higher ranks to connect!" );
+            }
+
+            const int ready = ::poll( &pending, 1, static_cast< int >( remaining.count() ) );
+
+            if( ready > 0 )
+            {
+                break;
+            }
+
+            if( ( ready < 0 ) && ( errno != EINTR ) )
+            {
+                throw_system_error( "poll" );
+            }
+        }
+
+        const int socket = ::accept( _listener, nullptr, nullptr );
+        std::int32_t identity;
+
+        if( socket < 0 )
+        {
+            throw_system_error( "accept" );
+        }
+
+        if( !read_all( socket, &identity, sizeof( identity ) ) || ( identity <= _rank ) ||
+            ( identity >= _size ) || ( _sockets[identity] >= 0 ) )
+        {
+            ::close( socket );
+            throw std::runtime_error( "Unexpected peer connection!" );
+        }
+
+        _sockets[identity] = socket;
+    }
+
+    if( domain == AF_INET )
+    {
+        for( int socket : _sockets )
+        {
+            if( socket >= 0 )
+            {
+                ::setsockopt( socket, IPPROTO_TCP, TCP_NODELAY, &enabled, sizeof( enabled ) );
+            }
+        }
+    }
+}
+
+void SocketTransport::read_from( int const &peer )
+{
+    MessageHeader header{};
+
+    // Nothing may escape this thread, an exception would terminate the
+    // process: a corrupt header or a failed allocation drops the peer instead
+    try
+    {
+        while( read_all( _sockets[peer], &header, sizeof( header ) ) &&
+               ( header.count <= MAXIMUM_MESSAGE_VALUES ) )
+        {
+            std::vector< value_t > data( header.count );
+
+            if( !read_all( _sockets[peer], data.data(), data.size() * sizeof( value_t ) ) )
+            {
+                break;
+            }
+
+            _mailbox.deliver( peer, header.tag, std::move( data ) );
+        }
+    }
+    catch( std::exception const & )
+    {
+    }
+
+    _mailbox.close( peer );
+}
+
+void SocketTransport::close_all( void )
+{
+    for( int &socket : _sockets )
+    {
+        if( socket >= 0 )
+        {
+            ::close( socket );
+            socket = -1;
+        }
+    }
+
+    if( _listener >= 0 )
+    {
+        ::close( _listener );
+        _listener = -1;
+
+        if( !_unix_path.empty() )
+        {
+            ::unlink( _unix_path.c_str() );
+        }
+    }
+}
@@ -0,0 +1,104 @@
+#ifndef SOCKET_TRANSPORT_H
+#define SOCKET_TRANSPORT_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <vector>
+
+#include "transport.hpp"
+
+// Transport over a full mesh of stream sockets, one connection per pair of
+// ranks. Each rank listens on its own address, connects to every lower rank
+// and accepts every higher one, so all ranks must be started with the same
+// size and addressing (as separate processes or threads). One reader thread
+// per peer drains its socket into a Mailbox, which keeps send() from
+// blocking on a peer that is itself sending.
+//
+// Destroying a transport closes its sending side and waits until every peer
+// has done the same, so no message in flight is lost.
+//
+// Message sizes come off the wire: a peer announcing more than
+// MAXIMUM_MESSAGE_VALUES values, or whose message cannot be allocated, is
+// treated as closed (receive() from it throws TransportClosed).
+class SocketTransport : public Transport
+{
+    public:
+    typedef std::chrono::milliseconds Timeout;
+    // publish( rank, port ) reports the port the kernel gave to a rank
+    typedef std::function< void( int const &, unsigned short const & ) > PortPublisher;
+    // port_of( rank ) returns the port published by a rank, 0 while unknown
+    typedef std::function< unsigned short( int const & ) > PortLookup;
+
+    // 2 GiB of values, larger messages are refused by send()
+    static const std::uint64_t MAXIMUM_MESSAGE_VALUES = std::uint64_t( 1 ) << 28;
+
+    // Rank r listens on the Unix socket directory/rank_<r>.sock
+    static std::unique_ptr< SocketTransport > unix_domain( std::string const &directory,
+                                                           int const &rank,
+                                                           int const &size,
+                                                           Timeout const &timeout = Timeout( 10000 ) );
+    // Rank r listens on the IPv4 address at port base_port + r
+    static std::unique_ptr< SocketTransport > tcp( std::string const &address,
+                                                   unsigned short const &base_port,
+                                                   int const &rank,
+                                                   int const &size,
+                                                   Timeout const &timeout = Timeout( 10000 ) );
+    // Rank r listens on a port picked by the kernel (no collisions between
+    // concurrent runs) and hands it to publish. port_of is only asked about
+    // lower ranks and is polled, like connecting, until the deadline.
+    static std::unique_ptr< SocketTransport > tcp( std::string const &address,
+                                                   PortPublisher const &publish,
+                                                   PortLookup const &port_of,
+                                                   int const &rank,
+                                                   int const &size,
+                                                   Timeout const &timeout = Timeout( 10000 ) );
+
+    ~SocketTransport( void );
+
+    SocketTransport( SocketTransport const & ) = delete;
+    SocketTransport &operator=( SocketTransport const & ) = delete;
+
+    int rank( void ) const override;
+    int size( void ) const override;
+
+    void send( int const &destination, int const &tag, std::vector< value_t > const &data ) override;
+    std::vector< value_t > receive( int const &source, int const &tag ) override;
+
+    private:
+    // Fills the socket address of a rank, returning its length
+    typedef std::function< socklen_t( int const &, sockaddr_storage & ) > Addressing;
+    // Called once the listening socket is bound, with its descriptor
+    typedef std::function< void( int const & ) > Listening;
+
+    int _rank;
+    int _size;
+    int _listener;
+    std::string _unix_path;
+    std::vector< int > _sockets;
+    std::vector< std::unique_ptr< std::mutex > > _send_mutexes;
+    std::vector< std::thread > _readers;
+    Mailbox _mailbox;
+
+    SocketTransport( int const &domain,
+                     Addressing const &addressing,
+                     std::string const &unix_path,
+                     int const &rank,
+                     int const &size,
+                     Timeout const &timeout,
+                     Listening const &listening = Listening() );
+
+    void connect_mesh( int const &domain,
+                       Addressing const &addressing,
+                       Listening const &listening,
+                       Timeout const &timeout );
+    void read_from( int const &peer );
+    void close_all( void );
+};
+
+#endif
@@ -0,0 +1,189 @@
+#include "sparse_matrix.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+#include "parallel.hpp"
+
+SparseMatrix::SparseMatrix( void )
+    : _dimensions( 0, 0 )
+    , _line_offsets( 1, 0 )
+{
+}
+
+SparseMatrix::SparseMatrix( position_t const &lines,
+                            position_t const &columns,
+                            std::vector< SparseEntry > entries )
+    : _dimensions( lines, columns )
+    , _line_offsets( static_cast< std::size_t >( lines ) + 1, 0 )
+{
+    for( SparseEntry const &entry : entries )
+    {
+        if( ( entry.line >= lines ) || ( entry.column >= columns ) )
+        {
+            throw std::out_of_range( "Matrix position out of range!" );
+        }
+    }
+
+    std::sort( entries.begin(), entries.end(), []( SparseEntry const &a, SparseEntry const &b ) {
+        return ( a.line < b.line ) || ( ( a.line == b.line ) && ( a.column < b.column ) );
+    } );
+
+    _column_indexes.reserve( entries.size() );
+    _values.reserve( entries.size() );
+
+    for( std::size_t i = 0; i < entries.size(); ++i )
+    {
+        const bool repeated = ( i > 0 ) && ( entries[i].line == entries[i - 1].line ) &&
+                              ( entries[i].column == entries[i - 1].column );
+
+        if( repeated )
+        {
+            _values.back() += entries[i].value;
+            continue;
+        }
+
+        _column_indexes.push_back( entries[i].column );
+        _values.push_back( entries[i].value );
+        ++_line_offsets[entries[i].line + 1];
+    }
+
+    for( position_t i = 0; i < lines; ++i )
+    {
+        _line_offsets[i + 1] += _line_offsets[i];
+    }
+}
+
+SparseMatrix::SparseMatrix( Matrix const &matrix )
+    : _dimensions( matrix.dimensions() )
+    , _line_offsets( static_cast< std::size_t >( matrix.dimensions().first ) + 1, 0 )
+{
+    for( position_t i = 0; i < _dimensions.first; ++i )
+    {
+        value_t const *line = matrix[i];
+
+        for( position_t j = 0; j < _dimensions.second; ++j )
+        {
+            if( line[j] != 0.0 )
+            {
+                _column_indexes.push_back( j );
+                _values.push_back( line[j] );
+            }
+        }
+
+        _line_offsets[i + 1] = _values.size();
+    }
+}
+
+MatrixDimensions SparseMatrix::dimensions( void ) const
+{
+    return _dimensions;
+}
+
+std::size_t SparseMatrix::non_zeros( void ) const
+{
+    return _values.size();
+}
+
+std::vector< std::size_t > const &SparseMatrix::line_offsets( void ) const
+{
+    return _line_offsets;
+}
+
+std::vector< position_t > const &SparseMatrix::column_indexes( void ) const
+{
+    return _column_indexes;
+}
+
+std::vector< value_t > const &SparseMatrix::values( void ) const
+{
+    return _values;
+}
+
+value_t SparseMatrix::get( position_t const &line, position_t const &column ) const
+{
+    if( ( line >= _dimensions.first ) || ( column >= _dimensions.second ) )
+    {
+        throw std::out_of_range( "Matrix position out of range!" );
+    }
+
+    const auto first = _column_indexes.begin() + _line_offsets[line];
+    const auto last = _column_indexes.begin() + _line_offsets[line + 1];
+    const auto found = std::lower_bound( first, last, column );
+
+    if( ( found == last ) || ( *found != column ) )
+    {
+        return 0.0;
+    }
+
+    return _values[found - _column_indexes.begin()];
+}
+
+std::vector< value_t > SparseMatrix::diagonal( void ) const
+{
+    const position_t size = std::min( _dimensions.first, _dimensions.second );
+    std::vector< value_t > values( size, 0.0 );
+
+    for( position_t i = 0; i < size; ++i )
+    {
+        values[i] = get( i, i );
+    }
+
+    return values;
+}
+
+Matrix SparseMatrix::to_matrix( void ) const
+{
+    Matrix result;
+
+    result.reset_dimensions( _dimensions.first, _dimensions.second );
+
+    for( position_t i = 0; i < _dimensions.first; ++i )
+    {
+        value_t *line = result[i];
+
+        std::fill( line, line + _dimensions.second, 0.0 );
+
+        for( std::size_t k = _line_offsets[i]; k < _line_offsets[i + 1]; ++k )
+        {
+            line[_column_indexes[k]] = _values[k];
+        }
+    }
+
+    return result;
+}
+
+void SparseMatrix::multiply( value_t const *x, value_t *y ) const
+{
+    // Average entries per line as the per line cost
+    const std::size_t cost = _values.size() / std::max< position_t >( _dimensions.first, 1 ) + 1;
+
+    parallel_for( _dimensions.first,
+                  [this, x, y]( std::size_t begin, std::size_t end ) {
+                      for( std::size_t i = begin; i < end; ++i )
+                      {
+                          value_t sum = 0.0;
+
+                          for( std::size_t k = _line_offsets[i]; k < _line_offsets[i + 1]; ++k )
+                          {
+                              sum += _values[k] * x[_column_indexes[k]];
+                          }
+
+                          y[i] = sum;
+                      }
+                  },
+                  cost );
+}
+
+std::vector< value_t > SparseMatrix::multiply( std::vector< value_t > const &x ) const
+{
+    if( x.size() != _dimensions.second )
+    {
+        throw std::domain_error( "Vector size differs from matrix column count!" );
+    }
+
+    std::vector< value_t > y( _dimensions.first );
+
+    multiply( x.data(), y.data() );
+
+    return y;
+}
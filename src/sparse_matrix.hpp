@@ -0,0 +1,55 @@
+#ifndef SPARSE_MATRIX_H
+#define SPARSE_MATRIX_H
+
+#include <cstddef>
+#include <vector>
+
+#include "matrix.hpp"
+
+struct SparseEntry
+{
+    position_t line;
+    position_t column;
+    value_t value;
+};
+
+// Compressed sparse lines (CSR): the values of line i are
+// values()[line_offsets()[i] .. line_offsets()[i + 1]), their columns in
+// column_indexes(), sorted. Only the stored entries are touched by
+// multiply(), so a product costs O(non_zeros) instead of O(lines * columns).
+class SparseMatrix
+{
+    public:
+    SparseMatrix( void );
+    // Entries may come in any order, repeated positions are summed
+    SparseMatrix( position_t const &lines,
+                  position_t const &columns,
+                  std::vector< SparseEntry > entries );
+    // Keeps the non zero elements
+    explicit SparseMatrix( Matrix const &matrix );
+
+    MatrixDimensions dimensions( void ) const;
+    std::size_t non_zeros( void ) const;
+
+    std::vector< std::size_t > const &line_offsets( void ) const;
+    std::vector< position_t > const &column_indexes( void ) const;
+    std::vector< value_t > const &values( void ) const;
+
+    // 0 for positions that are not stored
+    value_t get( position_t const &line, position_t const &column ) const;
+    std::vector< value_t > diagonal( void ) const;
+    Matrix to_matrix( void ) const;
+
+    // y = A * x, lines split over the thread pool. x holds columns values,
+    // y lines values and may not overlap x.
+    void multiply( value_t const *x, value_t *y ) const;
+    std::vector< value_t > multiply( std::vector< value_t > const &x ) const;
+
+    private:
+    MatrixDimensions _dimensions;
+    std::vector< std::size_t > _line_offsets;
+    std::vector< position_t > _column_indexes;
+    std::vector< value_t > _values;
+};
+
+#endif
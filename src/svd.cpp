@@ -0,0 +1,381 @@
+#include "svd.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+
+#include "gemm.hpp"
+#include "jacobi_rotation.hpp"
+#include "qr_decomposition.hpp"
+
+namespace
+{
+// Lines of Psi generated at once when finishing a streaming sketch
+const position_t TEST_BLOCK_LINES = 4096;
+
+Matrix gaussian_matrix( position_t const &lines,
+                        position_t const &columns,
+                        std::uint64_t const &seed )
+{
+    std::mt19937_64 generator( seed );
+    std::normal_distribution< value_t > distribution;
+    Matrix result;
+
+    result.reset_dimensions( lines, columns );
+
+    for( position_t i = 0; i < lines; ++i )
+    {
+        value_t *line = result[i];
+
+        for( position_t j = 0; j < columns; ++j )
+        {
+            line[j] = distribution( generator );
+        }
+    }
+
+    return result;
+}
+
+// Counter based: the value at any index is known without generating the
+// previous ones
+inline std::uint64_t split_mix( std::uint64_t value )
+{
+    value += 0x9E3779B97F4A7C15ull;
+    value = ( value ^ ( value >> 30 ) ) * 0xBF58476D1CE4E5B9ull;
+    value = ( value ^ ( value >> 27 ) ) * 0x94D049BB133111EBull;
+
+    return value ^ ( value >> 31 );
+}
+
+// First count columns of matrix
+Matrix first_columns( Matrix const &matrix, position_t const &count )
+{
+    const position_t lines = matrix.dimensions().first;
+    Matrix result;
+
+    result.reset_dimensions( lines, count );
+
+    for( position_t i = 0; i < lines; ++i )
+    {
+        std::copy( matrix[i], matrix[i] + count, result[i] );
+    }
+
+    return result;
+}
+
+SingularValueDecomposition truncate( SingularValueDecomposition const &full,
+                                     position_t const &rank )
+{
+    SingularValueDecomposition result;
+    const position_t columns = full.vt.dimensions().second;
+
+    result.u = first_columns( full.u, rank );
+    result.singular_values.assign( full.singular_values.begin(),
+                                   full.singular_values.begin() + rank );
+    result.vt.reset_dimensions( rank, columns );
+
+    for( position_t i = 0; i < rank; ++i )
+    {
+        std::copy( full.vt[i], full.vt[i] + columns, result.vt[i] );
+    }
+
+    return result;
+}
+
+// u = q * (svd of the projection).u, truncated
+SingularValueDecomposition lift( Matrix const &q, Matrix const &projection, position_t const &rank )
+{
+    SingularValueDecomposition small = jacobi_svd( projection );
+    Matrix lifted;
+
+    gemm( 1.0, q, false, small.u, false, 0.0, lifted );
+    small.u = std::move( lifted );
+
+    return truncate( small, rank );
+}
+
+void assert_rank( position_t const &rank, position_t const &lines, position_t const &columns )
+{
+    if( ( rank == 0 ) || ( rank > std::min( lines, columns ) ) )
+    {
+        throw std::domain_error( "Rank should be between 1 and the smallest dimension!" );
+    }
+}
+}
+
+SingularValueDecomposition jacobi_svd( Matrix const &matrix )
+{
+    const position_t m = matrix.dimensions().first;
+    const position_t n = matrix.dimensions().second;
+
+    if( m < n )
+    {
+        // A^T = U S V^T gives A = V S U^T
+        SingularValueDecomposition transposed = jacobi_svd( matrix.transposed() );
+        SingularValueDecomposition result;
+
+        result.u = transposed.vt.transposed();
+        result.singular_values = std::move( transposed.singular_values );
+        result.vt = transposed.u.transposed();
+
+        return result;
+    }
+
+    // Columns of A are the lines of work, so rotations are unit stride
+    Matrix work = matrix.transposed();
+    Matrix rotations = Matrix::identity_matrix( n, n );
+    const value_t tolerance = std::numeric_limits< value_t >::epsilon() * std::max( m, 1u );
+
+    for( unsigned int sweep = 0; sweep < JACOBI_MAXIMUM_SWEEPS; ++sweep )
+    {
+        bool rotated = false;
+
+        for( position_t p = 0; p + 1 < n; ++p )
+        {
+            for( position_t q = p + 1; q < n; ++q )
+            {
+                value_t *first = work[p];
+                value_t *second = work[q];
+                value_t alpha = 0.0;
+                value_t beta = 0.0;
+                value_t gamma = 0.0;
+
+                for( position_t i = 0; i < m; ++i )
+                {
+                    alpha += first[i] * first[i];
+                    beta += second[i] * second[i];
+                    gamma += first[i] * second[i];
+                }
+
+                if( std::fabs( gamma ) <= tolerance * std::sqrt( alpha * beta ) )
+                {
+                    continue;
+                }
+
+                // Rotation making columns p and q orthogonal
+                const JacobiRotation rotation = jacobi_rotation( alpha, beta, gamma );
+                const value_t c = rotation.c;
+                const value_t s = rotation.s;
+
+                rotated = true;
+
+                for( position_t i = 0; i < m; ++i )
+                {
+                    const value_t a = first[i];
+                    const value_t b = second[i];
+
+                    first[i] = c * a - s * b;
+                    second[i] = s * a + c * b;
+                }
+
+                value_t *first_rotation = rotations[p];
+                value_t *second_rotation = rotations[q];
+
+                for( position_t i = 0; i < n; ++i )
+                {
+                    const value_t a = first_rotation[i];
+                    const value_t b = second_rotation[i];
+
+                    first_rotation[i] = c * a - s * b;
+                    second_rotation[i] = s * a + c * b;
+                }
+            }
+        }
+
+        if( !rotated )
+        {
+            break;
+        }
+    }
+
+    // Column norms are the singular values, sorted in decreasing order
+    std::vector< value_t > norms( n );
+    std::vector< position_t > order( n );
+
+    for( position_t p = 0; p < n; ++p )
+    {
+        value_t const *line = work[p];
+
+        norms[p] = std::sqrt( std::inner_product( line, line + m, line, 0.0 ) );
+    }
+
+    std::iota( order.begin(), order.end(), 0 );
+    std::stable_sort( order.begin(),
+                      order.end(),
+                      [&norms]( position_t const &a, position_t const &b ) {
+                          return norms[a] > norms[b];
+                      } );
+
+    SingularValueDecomposition result;
+
+    result.singular_values.resize( n );
+    result.u.reset_dimensions( m, n );
+    result.vt.reset_dimensions( n, n );
+
+    for( position_t k = 0; k < n; ++k )
+    {
+        const position_t p = order[k];
+        const value_t sigma = norms[p];
+        const value_t inverse = ( sigma > 0.0 ) ? 1.0 / sigma : 0.0;
+        value_t const *column = work[p];
+
+        result.singular_values[k] = sigma;
+
+        for( position_t i = 0; i < m; ++i )
+        {
+            result.u[i][k] = column[i] * inverse;
+        }
+
+        std::copy( rotations[p], rotations[p] + n, result.vt[k] );
+    }
+
+    return result;
+}
+
+SingularValueDecomposition randomized_svd( Matrix const &matrix,
+                                           position_t const &rank,
+                                           RandomizedSvdOptions const &options )
+{
+    const position_t m = matrix.dimensions().first;
+    const position_t n = matrix.dimensions().second;
+
+    assert_rank( rank, m, n );
+
+    const position_t samples = std::min( rank + options.oversampling, std::min( m, n ) );
+    Matrix range;
+    Matrix corange;
+
+    gemm( 1.0, matrix, false, gaussian_matrix( n, samples, options.seed ), false, 0.0, range );
+
+    Matrix q = QRDecomposition( range ).thin_q();
+
+    for( unsigned int iteration = 0; iteration < options.power_iterations; ++iteration )
+    {
+        gemm( 1.0, matrix, true, q, false, 0.0, corange );
+        gemm( 1.0, matrix, false, QRDecomposition( corange ).thin_q(), false, 0.0, range );
+        q = QRDecomposition( range ).thin_q();
+    }
+
+    // B = Q^T A, samples x columns
+    Matrix projection;
+
+    gemm( 1.0, q, true, matrix, false, 0.0, projection );
+
+    return lift( q, projection, rank );
+}
+
+StreamingSvd::StreamingSvd( position_t const &columns,
+                            position_t const &rank,
+                            RandomizedSvdOptions const &options )
+    : _columns( columns )
+    , _rank( rank )
+    , _range_size( std::min( rank + options.oversampling, columns ) )
+    , _corange_size( 2 * _range_size + 1 )
+    , _seed( options.seed )
+    , _omega( gaussian_matrix( columns, _range_size, options.seed ) )
+    , _lines( 0 )
+{
+    assert_rank( rank, rank, columns );
+    _corange.reset_dimensions( _corange_size, columns );
+
+    for( position_t i = 0; i < _corange_size; ++i )
+    {
+        std::fill( _corange[i], _corange[i] + columns, 0.0 );
+    }
+}
+
+Matrix StreamingSvd::corange_test_lines( position_t const &first, position_t const &count ) const
+{
+    Matrix result;
+
+    result.reset_dimensions( count, _corange_size );
+
+    // Random signs, entry ( line, j ) depends only on the seed and position
+    const std::uint64_t origin = split_mix( _seed ^ 0xC0FFEEull );
+
+    for( position_t i = 0; i < count; ++i )
+    {
+        value_t *line = result[i];
+        const std::uint64_t base =
+            origin + static_cast< std::uint64_t >( first + i ) * _corange_size;
+
+        for( position_t j = 0; j < _corange_size; ++j )
+        {
+            line[j] = ( split_mix( base + j ) & 1u ) ? 1.0 : -1.0;
+        }
+    }
+
+    return result;
+}
+
+void StreamingSvd::add_lines( Matrix const &block )
+{
+    const position_t count = block.dimensions().first;
+
+    if( block.dimensions().second != _columns )
+    {
+        throw std::domain_error( "Block column count differs from the matrix column count!" );
+    }
+
+    if( count == 0 )
+    {
+        return;
+    }
+
+    Matrix sketch;
+
+    // Y lines of the block, then W += Psi( :, block lines ) * block
+    gemm( 1.0, block, false, _omega, false, 0.0, sketch );
+    _range.insert( _range.end(),
+                   sketch[0],
+                   sketch[0] + static_cast< std::size_t >( count ) * _range_size );
+    gemm( 1.0, corange_test_lines( _lines, count ), true, block, false, 1.0, _corange );
+
+    _lines += count;
+}
+
+position_t StreamingSvd::lines( void ) const
+{
+    return _lines;
+}
+
+SingularValueDecomposition StreamingSvd::finish( void ) const
+{
+    if( _lines < _rank )
+    {
+        throw std::domain_error( "Rank should be between 1 and the smallest dimension!" );
+    }
+
+    Matrix range;
+
+    range.reset_dimensions( _lines, _range_size );
+    std::copy( _range.begin(), _range.end(), range[0] );
+
+    const Matrix q = QRDecomposition( range ).thin_q();
+    const position_t basis = q.dimensions().second;
+
+    // Psi * Q, regenerating Psi a block of lines at a time
+    Matrix sketched_basis;
+    Matrix q_block;
+
+    sketched_basis.reset_dimensions( _corange_size, basis );
+
+    for( position_t i = 0; i < _corange_size; ++i )
+    {
+        std::fill( sketched_basis[i], sketched_basis[i] + basis, 0.0 );
+    }
+
+    for( position_t first = 0; first < _lines; first += TEST_BLOCK_LINES )
+    {
+        const position_t count = std::min( TEST_BLOCK_LINES, _lines - first );
+
+        q_block.reset_dimensions( count, basis );
+        std::copy( q[first], q[first] + static_cast< std::size_t >( count ) * basis, q_block[0] );
+        gemm( 1.0, corange_test_lines( first, count ), true, q_block, false, 1.0, sketched_basis );
+    }
+
+    // B minimizes || Psi Q B - W ||, Psi Q being taller than wide
+    return lift( q, QRDecomposition( sketched_basis ).solve( _corange ), _rank );
+}
@@ -0,0 +1,81 @@
+#ifndef SVD_H
+#define SVD_H
+
+#include <cstdint>
+#include <vector>
+
+#include "matrix.hpp"
+
+// A ~= u * diag(singular_values) * vt, singular values in decreasing order
+struct SingularValueDecomposition
+{
+    Matrix u;
+    std::vector< value_t > singular_values;
+    Matrix vt;
+};
+
+// Thin SVD of a small dense matrix by one-sided Jacobi rotations: r =
+// min(lines, columns) singular values, u is lines x r and vt r x columns.
+// Accurate to working precision, even for tiny singular values, but
+// O(lines * columns * r) per sweep: meant for the projected problems of
+// the randomized methods below. Columns of u for null singular values are
+// zero.
+SingularValueDecomposition jacobi_svd( Matrix const &matrix );
+
+struct RandomizedSvdOptions
+{
+    // Extra sampled directions beyond the rank, they make the captured
+    // range accurate with high probability
+    position_t oversampling = 10;
+    // Each one costs two more passes over A and sharpens a slowly decaying
+    // spectrum. With none, A is read exactly twice.
+    unsigned int power_iterations = 0;
+    std::uint64_t seed = 1;
+};
+
+// Truncated SVD of rank singular triplets (Halko, Martinsson & Tropp):
+// A is multiplied by a Gaussian test matrix, the range of the product is
+// orthonormalized by QR (re-orthonormalized between power iterations),
+// and the SVD of the small projection Q^T A gives the triplets. Every
+// product with A goes through gemm.
+SingularValueDecomposition randomized_svd( Matrix const &matrix,
+                                           position_t const &rank,
+                                           RandomizedSvdOptions const &options =
+                                               RandomizedSvdOptions() );
+
+// Single pass variant for matrixes read from disk a block of lines at a
+// time (Tropp, Yurtsever, Udell & Cevher sketch): every block updates the
+// range sketch Y = A * Omega and the co-range sketch W = Psi * A, then is
+// dropped. Memory is O((lines + columns) * (rank + oversampling)), A is
+// never held. power_iterations is ignored, a single pass cannot iterate.
+class StreamingSvd
+{
+    public:
+    StreamingSvd( position_t const &columns,
+                  position_t const &rank,
+                  RandomizedSvdOptions const &options = RandomizedSvdOptions() );
+
+    // Next lines of A, in order, each of columns values
+    void add_lines( Matrix const &block );
+    position_t lines( void ) const;
+
+    SingularValueDecomposition finish( void ) const;
+
+    private:
+    position_t _columns;
+    position_t _rank;
+    position_t _range_size;
+    position_t _corange_size;
+    std::uint64_t _seed;
+    Matrix _omega;
+    // Y lines, appended block after block
+    std::vector< value_t > _range;
+    // W = Psi * A, accumulated
+    Matrix _corange;
+    position_t _lines;
+
+    // Psi columns for lines [first, first + count), as count x corange_size
+    Matrix corange_test_lines( position_t const &first, position_t const &count ) const;
+};
+
+#endif
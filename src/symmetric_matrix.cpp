@@ -0,0 +1,310 @@
+#include "symmetric_matrix.hpp"
+#include "condition_estimate.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+SymmetricMatrix::SymmetricMatrix( void )
+    : _size( 0 )
+{
+}
+
+SymmetricMatrix::SymmetricMatrix( position_t const &size )
+    : _size( size )
+    , _data( static_cast< std::size_t >( size ) * ( size + 1 ) / 2, 0.0 )
+{
+}
+
+SymmetricMatrix::SymmetricMatrix( Matrix const &matrix )
+    : SymmetricMatrix( matrix.dimensions().first )
+{
+    if( matrix.dimensions().first != matrix.dimensions().second )
+    {
+        throw std::domain_error( "Symmetric matrixes should be square!" );
+    }
+
+    for( position_t line = 0; line < _size; ++line )
+    {
+        value_t *packed = _data.data() + offset( line, 0 );
+
+        std::copy( matrix[line], matrix[line] + line + 1, packed );
+    }
+}
+
+position_t SymmetricMatrix::size( void ) const
+{
+    return _size;
+}
+
+value_t &SymmetricMatrix::element( position_t const &line, position_t const &column )
+{
+    assert_position( line, column );
+
+    return _data[offset( line, column )];
+}
+
+value_t SymmetricMatrix::get( position_t const &line, position_t const &column ) const
+{
+    assert_position( line, column );
+
+    return _data[offset( line, column )];
+}
+
+SymmetricMatrix &SymmetricMatrix::rank_k_update( value_t const &alpha,
+                                                 Matrix const &matrix,
+                                                 bool const &transposed,
+                                                 value_t const &beta )
+{
+    const MatrixDimensions dimensions = matrix.dimensions();
+    const position_t order = transposed ? dimensions.second : dimensions.first;
+
+    if( order != _size )
+    {
+        throw std::domain_error( "Rank k update matrix does not match symmetric matrix size!" );
+    }
+
+    if( beta == 0.0 )
+    {
+        std::fill( _data.begin(), _data.end(), 0.0 );
+    }
+    else if( beta != 1.0 )
+    {
+        for( value_t &value : _data )
+        {
+            value *= beta;
+        }
+    }
+
+    if( transposed )
+    {
+        // C(i, j) += alpha * sum_k A(k, i) * A(k, j), streaming A line by line
+        for( position_t k = 0; k < dimensions.first; ++k )
+        {
+            value_t const *line = matrix[k];
+
+            for( position_t i = 0; i < _size; ++i )
+            {
+                const value_t scaled = alpha * line[i];
+                value_t *packed = _data.data() + offset( i, 0 );
+
+                for( position_t j = 0; j <= i; ++j )
+                {
+                    packed[j] += scaled * line[j];
+                }
+            }
+        }
+    }
+    else
+    {
+        // C(i, j) += alpha * (line i of A) . (line j of A)
+        for( position_t i = 0; i < _size; ++i )
+        {
+            value_t const *first = matrix[i];
+            value_t *packed = _data.data() + offset( i, 0 );
+
+            for( position_t j = 0; j <= i; ++j )
+            {
+                value_t const *second = matrix[j];
+                value_t sum = 0.0;
+
+                for( position_t k = 0; k < dimensions.second; ++k )
+                {
+                    sum += first[k] * second[k];
+                }
+
+                packed[j] += alpha * sum;
+            }
+        }
+    }
+
+    return *this;
+}
+
+SymmetricMatrix SymmetricMatrix::gram( Matrix const &matrix )
+{
+    SymmetricMatrix result( matrix.dimensions().second );
+
+    result.rank_k_update( 1.0, matrix, true, 0.0 );
+
+    return result;
+}
+
+// Every stored value is read once and used for both of its positions
+std::vector< value_t > SymmetricMatrix::multiply( std::vector< value_t > const &values ) const
+{
+    std::vector< value_t > result( _size, 0.0 );
+
+    if( values.size() != _size )
+    {
+        throw std::domain_error( "Vector size differs from matrix size!" );
+    }
+
+    for( position_t i = 0; i < _size; ++i )
+    {
+        value_t const *packed = _data.data() + offset( i, 0 );
+        const value_t x_i = values[i];
+        value_t sum = 0.0;
+
+        for( position_t j = 0; j < i; ++j )
+        {
+            sum += packed[j] * values[j];
+            result[j] += packed[j] * x_i;
+        }
+
+        result[i] += sum + packed[i] * x_i;
+    }
+
+    return result;
+}
+
+Matrix SymmetricMatrix::operator*( Matrix const &other ) const
+{
+    const position_t columns = other.dimensions().second;
+    Matrix result;
+
+    if( other.dimensions().first != _size )
+    {
+        throw std::domain_error(
+            "First matrix column count differs from second matrix lines count!" );
+    }
+
+    result.reset_dimensions( _size, columns );
+    std::fill( result[0], result[0] + static_cast< std::size_t >( _size ) * columns, 0.0 );
+
+    for( position_t i = 0; i < _size; ++i )
+    {
+        value_t const *packed = _data.data() + offset( i, 0 );
+        value_t *result_i = result[i];
+        value_t const *other_i = other[i];
+
+        for( position_t j = 0; j < i; ++j )
+        {
+            const value_t a_ij = packed[j];
+            value_t *result_j = result[j];
+            value_t const *other_j = other[j];
+
+            for( position_t k = 0; k < columns; ++k )
+            {
+                result_i[k] += a_ij * other_j[k];
+                result_j[k] += a_ij * other_i[k];
+            }
+        }
+
+        for( position_t k = 0; k < columns; ++k )
+        {
+            result_i[k] += packed[i] * other_i[k];
+        }
+    }
+
+    return result;
+}
+
+TriangularMatrix SymmetricMatrix::cholesky( void ) const
+{
+    TriangularMatrix factor( _size, Triangle::lower );
+
+    for( position_t i = 0; i < _size; ++i )
+    {
+        value_t const *packed = _data.data() + offset( i, 0 );
+        value_t *factor_i = &factor.element( i, 0 );
+
+        for( position_t j = 0; j <= i; ++j )
+        {
+            value_t const *factor_j = &factor.element( j, 0 );
+            value_t sum = packed[j];
+
+            for( position_t k = 0; k < j; ++k )
+            {
+                sum -= factor_i[k] * factor_j[k];
+            }
+
+            if( i == j )
+            {
+                if( sum <= 0.0 )
+                {
+                    throw std::domain_error( "Matrix is not positive definite!" );
+                }
+
+                factor_i[i] = std::sqrt( sum );
+            }
+            else
+            {
+                factor_i[j] = sum / factor_j[j];
+            }
+        }
+    }
+
+    return factor;
+}
+
+std::vector< value_t > SymmetricMatrix::solve( std::vector< value_t > const &rhs ) const
+{
+    TriangularMatrix factor = cholesky();
+    std::vector< value_t > result = factor.solve( rhs );
+
+    factor.solve_transposed_in_place( result.data() );
+
+    return result;
+}
+
+value_t SymmetricMatrix::condition_estimate( TriangularMatrix const &cholesky_factor ) const
+{
+    if( ( cholesky_factor.size() != _size ) || ( cholesky_factor.triangle() != Triangle::lower ) )
+    {
+        throw std::domain_error( "Cholesky factor does not match symmetric matrix!" );
+    }
+
+    // A^-1 = L^-T L^-1 is symmetric, so both solves are the same
+    auto solve = [&cholesky_factor]( value_t *values ) {
+        cholesky_factor.solve_in_place( values );
+        cholesky_factor.solve_transposed_in_place( values );
+    };
+    value_t norm = 0.0;
+
+    for( position_t j = 0; j < _size; ++j )
+    {
+        value_t sum = 0.0;
+
+        for( position_t i = 0; i < _size; ++i )
+        {
+            sum += std::fabs( _data[offset( i, j )] );
+        }
+
+        norm = std::max( norm, sum );
+    }
+
+    return norm * estimate_inverse_norm1( _size, solve, solve );
+}
+
+Matrix SymmetricMatrix::to_matrix( void ) const
+{
+    Matrix result;
+
+    result.reset_dimensions( _size, _size );
+
+    for( position_t i = 0; i < _size; ++i )
+    {
+        for( position_t j = 0; j <= i; ++j )
+        {
+            result[i][j] = _data[offset( i, j )];
+            result[j][i] = _data[offset( i, j )];
+        }
+    }
+
+    return result;
+}
+
+std::size_t SymmetricMatrix::offset( position_t const &line, position_t const &column ) const
+{
+    const std::size_t high = std::max( line, column );
+
+    return high * ( high + 1 ) / 2 + std::min( line, column );
+}
+
+void SymmetricMatrix::assert_position( position_t const &line, position_t const &column ) const
+{
+    if( ( line >= _size ) || ( column >= _size ) )
+    {
+        throw std::out_of_range( "Position out of range!" );
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef SYMMETRIC_MATRIX_H
+#define SYMMETRIC_MATRIX_H
+
+#include <cstddef>
+#include <vector>
+
+#include "matrix.hpp"
+#include "triangular_matrix.hpp"
+
+// Symmetric square matrix, only the lower triangle is stored (packed line by
+// line), which halves both memory and memory traffic of the dense layout.
+class SymmetricMatrix
+{
+    public:
+    SymmetricMatrix( void );
+    SymmetricMatrix( position_t const &size );
+    // Takes the lower triangle of the given matrix
+    SymmetricMatrix( Matrix const &matrix );
+
+    position_t size( void ) const;
+
+    // (line, column) and (column, line) refer to the same stored value
+    value_t &element( position_t const &line, position_t const &column );
+    value_t get( position_t const &line, position_t const &column ) const;
+
+    // this = alpha * A^T * A + beta * this when transposed is true,
+    // this = alpha * A * A^T + beta * this otherwise (SYRK)
+    SymmetricMatrix &rank_k_update( value_t const &alpha,
+                                    Matrix const &matrix,
+                                    bool const &transposed,
+                                    value_t const &beta );
+
+    // A^T * A, without building the transposed matrix
+    static SymmetricMatrix gram( Matrix const &matrix );
+
+    std::vector< value_t > multiply( std::vector< value_t > const &values ) const;
+    Matrix operator*( Matrix const &other ) const;
+
+    // A = L * L^T, throws std::domain_error if the matrix is not positive definite
+    TriangularMatrix cholesky( void ) const;
+    std::vector< value_t > solve( std::vector< value_t > const &rhs ) const;
+    // Estimate of the 1-norm condition number in O(n^2), reusing a factor
+    // returned by cholesky()
+    value_t condition_estimate( TriangularMatrix const &cholesky_factor ) const;
+
+    Matrix to_matrix( void ) const;
+
+    private:
+    position_t _size;
+    std::vector< value_t > _data;
+
+    std::size_t offset( position_t const &line, position_t const &column ) const;
+    void assert_position( position_t const &line, position_t const &column ) const;
+};
+
+#endif
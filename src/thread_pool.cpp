@@ -0,0 +1,85 @@
+#include "thread_pool.hpp"
+
+namespace
+{
+thread_local bool inside_worker = false;
+}
+
+ThreadPool::ThreadPool( unsigned int const &threads )
+    : _stopping( false )
+{
+    const unsigned int count = ( threads > 0 ) ? threads : 1;
+
+    for( unsigned int i = 0; i < count; ++i )
+    {
+        _workers.emplace_back( [this]( void ) -> void { work(); } );
+    }
+}
+
+ThreadPool::~ThreadPool( void )
+{
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        _stopping = true;
+    }
+
+    _condition.notify_all();
+
+    for( std::thread &worker : _workers )
+    {
+        worker.join();
+    }
+}
+
+ThreadPool &ThreadPool::instance( void )
+{
+    static ThreadPool pool( std::thread::hardware_concurrency() );
+
+    return pool;
+}
+
+bool ThreadPool::is_worker_thread( void )
+{
+    return inside_worker;
+}
+
+unsigned int ThreadPool::thread_count( void ) const
+{
+    return _workers.size();
+}
+
+void ThreadPool::submit( std::function< void( void ) > task )
+{
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        _tasks.push_back( std::move( task ) );
+    }
+
+    _condition.notify_one();
+}
+
+void ThreadPool::work( void )
+{
+    inside_worker = true;
+
+    for( ;; )
+    {
+        std::function< void( void ) > task;
+
+        {
+            std::unique_lock< std::mutex > lock( _mutex );
+
+            _condition.wait( lock, [this]( void ) -> bool { return _stopping || !_tasks.empty(); } );
+
+            if( _tasks.empty() )
+            {
+                return;
+            }
+
+            task = std::move( _tasks.front() );
+            _tasks.pop_front();
+        }
+
+        task();
+    }
+}
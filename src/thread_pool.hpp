@@ -0,0 +1,57 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Fixed size pool of worker threads consuming a FIFO task queue.
+// ThreadPool::instance() is the library wide executor.
+class ThreadPool
+{
+    public:
+    explicit ThreadPool( unsigned int const &threads );
+    ~ThreadPool( void );
+
+    ThreadPool( ThreadPool const & ) = delete;
+    ThreadPool &operator=( ThreadPool const & ) = delete;
+
+    static ThreadPool &instance( void );
+    // True when called from a worker of any pool
+    static bool is_worker_thread( void );
+
+    unsigned int thread_count( void ) const;
+
+    void submit( std::function< void( void ) > task );
+
+    template < typename Function >
+    std::future< typename std::result_of< Function() >::type > async( Function &&function )
+    {
+        typedef typename std::result_of< Function() >::type Result;
+
+        auto task =
+            std::make_shared< std::packaged_task< Result() > >( std::forward< Function >( function ) );
+        std::future< Result > result = task->get_future();
+
+        submit( [task]( void ) -> void { ( *task )(); } );
+
+        return result;
+    }
+
+    private:
+    std::vector< std::thread > _workers;
+    std::deque< std::function< void( void ) > > _tasks;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    bool _stopping;
+
+    void work( void );
+};
+
+#endif
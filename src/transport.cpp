@@ -0,0 +1,129 @@
+#include "transport.hpp"
+#include <algorithm>
+
+TransportClosed::TransportClosed( void )
+    : std::runtime_error( "Transport connection was closed!" )
+{
+}
+
+Transport::~Transport( void )
+{
+}
+
+Mailbox::Mailbox( void )
+{
+}
+
+void Mailbox::deliver( int const &source, int const &tag, std::vector< value_t > &&data )
+{
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+
+        _messages[std::make_pair( source, tag )].push_back( std::move( data ) );
+    }
+
+    _condition.notify_all();
+}
+
+std::vector< value_t > Mailbox::take( int const &source, int const &tag )
+{
+    const std::pair< int, int > key( source, tag );
+    std::unique_lock< std::mutex > lock( _mutex );
+
+    for( ;; )
+    {
+        auto found = _messages.find( key );
+
+        if( ( found != _messages.end() ) && !found->second.empty() )
+        {
+            std::vector< value_t > data = std::move( found->second.front() );
+
+            found->second.pop_front();
+
+            return data;
+        }
+
+        if( std::find( _closed.begin(), _closed.end(), source ) != _closed.end() )
+        {
+            throw TransportClosed();
+        }
+
+        _condition.wait( lock );
+    }
+}
+
+void Mailbox::close( int const &source )
+{
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+
+        _closed.push_back( source );
+    }
+
+    _condition.notify_all();
+}
+
+InProcessNetwork::InProcessNetwork( int const &size )
+{
+    if( size < 1 )
+    {
+        throw std::domain_error( "Network needs at least one rank!" );
+    }
+
+    for( int i = 0; i < size; ++i )
+    {
+        _mailboxes.emplace_back( new Mailbox() );
+    }
+}
+
+int InProcessNetwork::size( void ) const
+{
+    return static_cast< int >( _mailboxes.size() );
+}
+
+std::unique_ptr< Transport > InProcessNetwork::endpoint( int const &rank )
+{
+    return std::unique_ptr< Transport >( new InProcessTransport( *this, rank ) );
+}
+
+InProcessTransport::InProcessTransport( InProcessNetwork &network, int const &rank )
+    : _network( network )
+    , _rank( rank )
+{
+    if( ( rank < 0 ) || ( rank >= network.size() ) )
+    {
+        throw std::out_of_range( "Rank out of range!" );
+    }
+}
+
+int InProcessTransport::rank( void ) const
+{
+    return _rank;
+}
+
+int InProcessTransport::size( void ) const
+{
+    return _network.size();
+}
+
+void InProcessTransport::send( int const &destination,
+                               int const &tag,
+                               std::vector< value_t > const &data )
+{
+    if( ( destination < 0 ) || ( destination >= size() ) )
+    {
+        throw std::out_of_range( "Rank out of range!" );
+    }
+
+    _network._mailboxes[destination]->deliver( _rank, tag, std::vector< value_t >( data ) );
+}
+
+std::vector< value_t > InProcessTransport::receive( int const &source, int const &tag )
+{
+    if( ( source < 0 ) || ( source >= size() ) )
+    {
+        throw std::out_of_range( "Rank out of range!" );
+    }
+
+    return _network._mailboxes[_rank]->take( source, tag );
+}
@@ -0,0 +1,93 @@
+#ifndef TRANSPORT_H
+#define TRANSPORT_H
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "matrix.hpp"
+
+// Thrown by receive() when the peer went away before sending the message
+class TransportClosed : public std::runtime_error
+{
+    public:
+    TransportClosed( void );
+};
+
+// Point to point messages between the ranks 0..size()-1 of a group of
+// processes. Messages are buffered: send() never waits for the matching
+// receive(). Messages with the same source and tag arrive in send order.
+// Implementations must allow send() and receive() from different threads.
+class Transport
+{
+    public:
+    virtual ~Transport( void );
+
+    virtual int rank( void ) const = 0;
+    virtual int size( void ) const = 0;
+
+    virtual void send( int const &destination, int const &tag, std::vector< value_t > const &data ) = 0;
+    // Blocks until a message from source with tag is available
+    virtual std::vector< value_t > receive( int const &source, int const &tag ) = 0;
+};
+
+// Messages delivered to one rank, waiting to be received. Shared by the
+// transport implementations.
+class Mailbox
+{
+    public:
+    Mailbox( void );
+
+    void deliver( int const &source, int const &tag, std::vector< value_t > &&data );
+    std::vector< value_t > take( int const &source, int const &tag );
+    // No more messages will come from source, pending ones can still be taken
+    void close( int const &source );
+
+    private:
+    std::map< std::pair< int, int >, std::deque< std::vector< value_t > > > _messages;
+    std::vector< int > _closed;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+};
+
+// Ranks living in threads of a single process, mostly useful for tests
+class InProcessNetwork
+{
+    public:
+    explicit InProcessNetwork( int const &size );
+
+    InProcessNetwork( InProcessNetwork const & ) = delete;
+    InProcessNetwork &operator=( InProcessNetwork const & ) = delete;
+
+    int size( void ) const;
+    // Transport of one rank, the network must outlive it
+    std::unique_ptr< Transport > endpoint( int const &rank );
+
+    private:
+    friend class InProcessTransport;
+
+    std::vector< std::unique_ptr< Mailbox > > _mailboxes;
+};
+
+class InProcessTransport : public Transport
+{
+    public:
+    InProcessTransport( InProcessNetwork &network, int const &rank );
+
+    int rank( void ) const override;
+    int size( void ) const override;
+
+    void send( int const &destination, int const &tag, std::vector< value_t > const &data ) override;
+    std::vector< value_t > receive( int const &source, int const &tag ) override;
+
+    private:
+    InProcessNetwork &_network;
+    int _rank;
+};
+
+#endif
@@ -0,0 +1,241 @@
+#include "triangular_matrix.hpp"
+#include <stdexcept>
+
+TriangularMatrix::TriangularMatrix( void )
+    : _size( 0 )
+    , _triangle( Triangle::lower )
+{
+}
+
+TriangularMatrix::TriangularMatrix( position_t const &size, Triangle const &triangle )
+    : _size( size )
+    , _triangle( triangle )
+    , _data( static_cast< std::size_t >( size ) * ( size + 1 ) / 2, 0.0 )
+{
+}
+
+TriangularMatrix::TriangularMatrix( Matrix const &matrix, Triangle const &triangle )
+    : TriangularMatrix( matrix.dimensions().first, triangle )
+{
+    if( matrix.dimensions().first != matrix.dimensions().second )
+    {
+        throw std::domain_error( "Triangular matrixes should be square!" );
+    }
+
+    for( position_t line = 0; line < _size; ++line )
+    {
+        for( position_t column = 0; column < _size; ++column )
+        {
+            if( contains( line, column ) )
+            {
+                _data[offset( line, column )] = matrix[line][column];
+            }
+        }
+    }
+}
+
+position_t TriangularMatrix::size( void ) const
+{
+    return _size;
+}
+
+Triangle TriangularMatrix::triangle( void ) const
+{
+    return _triangle;
+}
+
+value_t &TriangularMatrix::element( position_t const &line, position_t const &column )
+{
+    if( ( line >= _size ) || ( column >= _size ) || !contains( line, column ) )
+    {
+        throw std::out_of_range( "Position is outside the stored triangle!" );
+    }
+
+    return _data[offset( line, column )];
+}
+
+value_t TriangularMatrix::get( position_t const &line, position_t const &column ) const
+{
+    if( ( line >= _size ) || ( column >= _size ) )
+    {
+        throw std::out_of_range( "Position out of range!" );
+    }
+
+    return contains( line, column ) ? _data[offset( line, column )] : 0.0;
+}
+
+value_t TriangularMatrix::determinant( void ) const
+{
+    value_t result = 1.0;
+
+    for( position_t i = 0; i < _size; ++i )
+    {
+        result *= _data[offset( i, i )];
+    }
+
+    return result;
+}
+
+std::vector< value_t > TriangularMatrix::multiply( std::vector< value_t > const &values ) const
+{
+    std::vector< value_t > result( _size, 0.0 );
+
+    assert_vector_size( values );
+
+    for( position_t line = 0; line < _size; ++line )
+    {
+        const position_t first = ( _triangle == Triangle::lower ) ? 0 : line;
+        const position_t last = ( _triangle == Triangle::lower ) ? line : _size - 1;
+        value_t const *packed = _data.data() + offset( line, first );
+        value_t sum = 0.0;
+
+        for( position_t column = first; column <= last; ++column )
+        {
+            sum += packed[column - first] * values[column];
+        }
+
+        result[line] = sum;
+    }
+
+    return result;
+}
+
+std::vector< value_t > TriangularMatrix::solve( std::vector< value_t > const &rhs ) const
+{
+    std::vector< value_t > result( rhs );
+
+    assert_vector_size( rhs );
+    solve_in_place( result.data() );
+
+    return result;
+}
+
+void TriangularMatrix::solve_in_place( value_t *values ) const
+{
+    if( _triangle == Triangle::lower )
+    {
+        for( position_t line = 0; line < _size; ++line )
+        {
+            value_t const *packed = _data.data() + offset( line, 0 );
+            value_t sum = values[line];
+
+            for( position_t column = 0; column < line; ++column )
+            {
+                sum -= packed[column] * values[column];
+            }
+
+            if( packed[line] == 0.0 )
+            {
+                throw std::domain_error( "Triangular matrix is singular!" );
+            }
+
+            values[line] = sum / packed[line];
+        }
+    }
+    else
+    {
+        for( position_t line = _size; line-- > 0; )
+        {
+            value_t const *packed = _data.data() + offset( line, line );
+            value_t sum = values[line];
+
+            for( position_t column = line + 1; column < _size; ++column )
+            {
+                sum -= packed[column - line] * values[column];
+            }
+
+            if( packed[0] == 0.0 )
+            {
+                throw std::domain_error( "Triangular matrix is singular!" );
+            }
+
+            values[line] = sum / packed[0];
+        }
+    }
+}
+
+// The transposed of a lower matrix is upper and vice versa, so the
+// substitution runs in the opposite direction, column by column.
+void TriangularMatrix::solve_transposed_in_place( value_t *values ) const
+{
+    if( _triangle == Triangle::lower )
+    {
+        for( position_t line = _size; line-- > 0; )
+        {
+            value_t const *packed = _data.data() + offset( line, 0 );
+
+            if( packed[line] == 0.0 )
+            {
+                throw std::domain_error( "Triangular matrix is singular!" );
+            }
+
+            values[line] /= packed[line];
+
+            for( position_t column = 0; column < line; ++column )
+            {
+                values[column] -= packed[column] * values[line];
+            }
+        }
+    }
+    else
+    {
+        for( position_t line = 0; line < _size; ++line )
+        {
+            value_t const *packed = _data.data() + offset( line, line );
+
+            if( packed[0] == 0.0 )
+            {
+                throw std::domain_error( "Triangular matrix is singular!" );
+            }
+
+            values[line] /= packed[0];
+
+            for( position_t column = line + 1; column < _size; ++column )
+            {
+                values[column] -= packed[column - line] * values[line];
+            }
+        }
+    }
+}
+
+Matrix TriangularMatrix::to_matrix( void ) const
+{
+    Matrix result;
+
+    result.reset_dimensions( _size, _size );
+
+    for( position_t line = 0; line < _size; ++line )
+    {
+        for( position_t column = 0; column < _size; ++column )
+        {
+            result[line][column] = get( line, column );
+        }
+    }
+
+    return result;
+}
+
+bool TriangularMatrix::contains( position_t const &line, position_t const &column ) const
+{
+    return ( _triangle == Triangle::lower ) ? ( column <= line ) : ( column >= line );
+}
+
+std::size_t TriangularMatrix::offset( position_t const &line, position_t const &column ) const
+{
+    const std::size_t l = line;
+
+    if( _triangle == Triangle::lower )
+    {
+        return l * ( l + 1 ) / 2 + column;
+    }
+
+    return l * _size - l * ( l - 1 ) / 2 + ( column - line );
+}
+
+void TriangularMatrix::assert_vector_size( std::vector< value_t > const &values ) const
+{
+    if( values.size() != _size )
+    {
+        throw std::domain_error( "Vector size differs from matrix size!" );
+    }
+}
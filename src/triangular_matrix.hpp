@@ -0,0 +1,53 @@
+#ifndef TRIANGULAR_MATRIX_H
+#define TRIANGULAR_MATRIX_H
+
+#include <cstddef>
+#include <vector>
+
+#include "matrix.hpp"
+
+enum class Triangle
+{
+    lower,
+    upper
+};
+
+// Square triangular matrix, only the n(n+1)/2 entries of the triangle are
+// stored (packed line by line).
+class TriangularMatrix
+{
+    public:
+    TriangularMatrix( void );
+    TriangularMatrix( position_t const &size, Triangle const &triangle );
+    TriangularMatrix( Matrix const &matrix, Triangle const &triangle );
+
+    position_t size( void ) const;
+    Triangle triangle( void ) const;
+
+    // Throws std::out_of_range for positions outside the triangle
+    value_t &element( position_t const &line, position_t const &column );
+    // Returns 0 for positions outside the triangle
+    value_t get( position_t const &line, position_t const &column ) const;
+
+    value_t determinant( void ) const;
+
+    std::vector< value_t > multiply( std::vector< value_t > const &values ) const;
+    // Forward (lower) or back (upper) substitution
+    std::vector< value_t > solve( std::vector< value_t > const &rhs ) const;
+    void solve_in_place( value_t *values ) const;
+    // Solves with the transposed matrix, without building it
+    void solve_transposed_in_place( value_t *values ) const;
+
+    Matrix to_matrix( void ) const;
+
+    private:
+    position_t _size;
+    Triangle _triangle;
+    std::vector< value_t > _data;
+
+    bool contains( position_t const &line, position_t const &column ) const;
+    std::size_t offset( position_t const &line, position_t const &column ) const;
+    void assert_vector_size( std::vector< value_t > const &values ) const;
+};
+
+#endif
@@ -0,0 +1,218 @@
+#include "tridiagonal_matrix.hpp"
+#include <stdexcept>
+
+TridiagonalMatrix::TridiagonalMatrix( void )
+{
+}
+
+TridiagonalMatrix::TridiagonalMatrix( position_t const &size )
+    : _lower( ( size > 0 ) ? size - 1 : 0, 0.0 )
+    , _diagonal( size, 0.0 )
+    , _upper( ( size > 0 ) ? size - 1 : 0, 0.0 )
+{
+}
+
+TridiagonalMatrix::TridiagonalMatrix( Matrix const &matrix )
+    : TridiagonalMatrix( matrix.dimensions().first )
+{
+    const position_t size = matrix.dimensions().first;
+
+    if( size != matrix.dimensions().second )
+    {
+        throw std::domain_error( "Tridiagonal matrixes should be square!" );
+    }
+
+    for( position_t i = 0; i < size; ++i )
+    {
+        _diagonal[i] = matrix[i][i];
+
+        if( ( i + 1 ) < size )
+        {
+            _upper[i] = matrix[i][i + 1];
+            _lower[i] = matrix[i + 1][i];
+        }
+    }
+}
+
+position_t TridiagonalMatrix::size( void ) const
+{
+    return _diagonal.size();
+}
+
+value_t &TridiagonalMatrix::element( position_t const &line, position_t const &column )
+{
+    if( ( line >= size() ) || ( column >= size() ) )
+    {
+        throw std::out_of_range( "Position out of range!" );
+    }
+
+    if( line == column )
+    {
+        return _diagonal[line];
+    }
+
+    if( line == ( column + 1 ) )
+    {
+        return _lower[column];
+    }
+
+    if( column == ( line + 1 ) )
+    {
+        return _upper[line];
+    }
+
+    throw std::out_of_range( "Position is outside the stored diagonals!" );
+}
+
+value_t TridiagonalMatrix::get( position_t const &line, position_t const &column ) const
+{
+    if( ( line >= size() ) || ( column >= size() ) )
+    {
+        throw std::out_of_range( "Position out of range!" );
+    }
+
+    if( line == column )
+    {
+        return _diagonal[line];
+    }
+
+    if( line == ( column + 1 ) )
+    {
+        return _lower[column];
+    }
+
+    if( column == ( line + 1 ) )
+    {
+        return _upper[line];
+    }
+
+    return 0.0;
+}
+
+std::vector< value_t > &TridiagonalMatrix::lower( void )
+{
+    return _lower;
+}
+
+std::vector< value_t > &TridiagonalMatrix::diagonal( void )
+{
+    return _diagonal;
+}
+
+std::vector< value_t > &TridiagonalMatrix::upper( void )
+{
+    return _upper;
+}
+
+value_t TridiagonalMatrix::determinant( void ) const
+{
+    value_t previous = 1.0;
+    value_t current = 1.0;
+
+    for( position_t i = 0; i < size(); ++i )
+    {
+        value_t next = _diagonal[i] * current;
+
+        if( i > 0 )
+        {
+            next -= _lower[i - 1] * _upper[i - 1] * previous;
+        }
+
+        previous = current;
+        current = next;
+    }
+
+    return current;
+}
+
+std::vector< value_t > TridiagonalMatrix::multiply( std::vector< value_t > const &values ) const
+{
+    const position_t n = size();
+    std::vector< value_t > result( n, 0.0 );
+
+    assert_vector_size( values );
+
+    for( position_t i = 0; i < n; ++i )
+    {
+        value_t sum = _diagonal[i] * values[i];
+
+        if( i > 0 )
+        {
+            sum += _lower[i - 1] * values[i - 1];
+        }
+
+        if( ( i + 1 ) < n )
+        {
+            sum += _upper[i] * values[i + 1];
+        }
+
+        result[i] = sum;
+    }
+
+    return result;
+}
+
+std::vector< value_t > TridiagonalMatrix::solve( std::vector< value_t > const &rhs ) const
+{
+    const position_t n = size();
+    std::vector< value_t > modified_upper( n, 0.0 );
+    std::vector< value_t > result( rhs );
+
+    assert_vector_size( rhs );
+
+    for( position_t i = 0; i < n; ++i )
+    {
+        value_t pivot = _diagonal[i];
+
+        if( i > 0 )
+        {
+            pivot -= _lower[i - 1] * modified_upper[i - 1];
+            result[i] -= _lower[i - 1] * result[i - 1];
+        }
+
+        if( pivot == 0.0 )
+        {
+            throw std::domain_error( "Zero pivot found, Thomas algorithm cannot solve system!" );
+        }
+
+        if( ( i + 1 ) < n )
+        {
+            modified_upper[i] = _upper[i] / pivot;
+        }
+
+        result[i] /= pivot;
+    }
+
+    for( position_t i = n; i > 1; --i )
+    {
+        result[i - 2] -= modified_upper[i - 2] * result[i - 1];
+    }
+
+    return result;
+}
+
+Matrix TridiagonalMatrix::to_matrix( void ) const
+{
+    const position_t n = size();
+    Matrix result;
+
+    result.reset_dimensions( n, n );
+
+    for( position_t line = 0; line < n; ++line )
+    {
+        for( position_t column = 0; column < n; ++column )
+        {
+            result[line][column] = get( line, column );
+        }
+    }
+
+    return result;
+}
+
+void TridiagonalMatrix::assert_vector_size( std::vector< value_t > const &values ) const
+{
+    if( values.size() != size() )
+    {
+        throw std::domain_error( "Vector size differs from matrix size!" );
+    }
+}
@@ -0,0 +1,46 @@
+#ifndef TRIDIAGONAL_MATRIX_H
+#define TRIDIAGONAL_MATRIX_H
+
+#include <vector>
+
+#include "matrix.hpp"
+
+// Square matrix with non zero entries only on the main diagonal and the
+// diagonals right above and below it. Stores 3n - 2 values.
+class TridiagonalMatrix
+{
+    public:
+    TridiagonalMatrix( void );
+    TridiagonalMatrix( position_t const &size );
+    TridiagonalMatrix( Matrix const &matrix );
+
+    position_t size( void ) const;
+
+    // Throws std::out_of_range for positions outside the three diagonals
+    value_t &element( position_t const &line, position_t const &column );
+    // Returns 0 for positions outside the three diagonals
+    value_t get( position_t const &line, position_t const &column ) const;
+
+    std::vector< value_t > &lower( void );
+    std::vector< value_t > &diagonal( void );
+    std::vector< value_t > &upper( void );
+
+    // Three term recurrence, O(n)
+    value_t determinant( void ) const;
+
+    std::vector< value_t > multiply( std::vector< value_t > const &values ) const;
+    // Thomas algorithm, O(n). No pivoting: meant for diagonally dominant or
+    // symmetric positive definite systems.
+    std::vector< value_t > solve( std::vector< value_t > const &rhs ) const;
+
+    Matrix to_matrix( void ) const;
+
+    private:
+    std::vector< value_t > _lower;
+    std::vector< value_t > _diagonal;
+    std::vector< value_t > _upper;
+
+    void assert_vector_size( std::vector< value_t > const &values ) const;
+};
+
+#endif
@@ -1,53 +1,61 @@
 #ifndef FIXED_VECTOR_H
 #define FIXED_VECTOR_H
 
-#include <array>
 #include <cmath>
 #include <initializer_list>
+#include <stdexcept>
 #include <type_traits>
 
+#include "reduction.hpp"
+
 typedef unsigned int position_t;
 
+// Every operation except distance_to() (which needs sqrt) is constexpr, so
+// tables of constant vectors can be computed at compile time.
 template < position_t DIMENSIONS, typename Scalar >
 class Vector
 {
     public:
-    Vector< DIMENSIONS, Scalar >( void )
+    constexpr Vector< DIMENSIONS, Scalar >( void )
+        : _coordinates{}
     {
-        _coordinates.fill( 0.0 );
     }
 
-    Vector< DIMENSIONS, Scalar >( std::initializer_list< Scalar > values )
+    constexpr Vector< DIMENSIONS, Scalar >( std::initializer_list< Scalar > values )
+        : _coordinates{}
     {
         this->set( values );
     }
 
-    inline position_t dimensions( void ) const
+    constexpr position_t dimensions( void ) const
     {
-        return _coordinates.size();
+        return DIMENSIONS;
     }
 
-    Scalar distance_to( Vector< DIMENSIONS, Scalar > const &other ) const
+    constexpr Scalar squared_distance_to( Vector< DIMENSIONS, Scalar > const &other ) const
     {
         Scalar distance = 0.0;
-        Scalar diff;
 
-        for( position_t i = 0; i < _coordinates.size(); ++i )
+        for( position_t i = 0; i < DIMENSIONS; ++i )
         {
-            diff = _coordinates[i];
-            diff -= other._coordinates[i];
+            const Scalar diff = _coordinates[i] - other._coordinates[i];
 
             distance += diff * diff;
         }
 
-        return sqrt( distance );
+        return distance;
+    }
+
+    Scalar distance_to( Vector< DIMENSIONS, Scalar > const &other ) const
+    {
+        return std::sqrt( this->squared_distance_to( other ) );
     }
 
-    Scalar dot( Vector< DIMENSIONS, Scalar > const &other ) const
+    constexpr Scalar dot( Vector< DIMENSIONS, Scalar > const &other ) const
     {
         Scalar product = 0.0;
 
-        for( position_t i = 0; i < _coordinates.size(); ++i )
+        for( position_t i = 0; i < DIMENSIONS; ++i )
         {
             product += _coordinates[i] * other._coordinates[i];
         }
@@ -55,63 +63,201 @@ class Vector
         return product;
     }
 
-    Scalar cross( Vector< 2, Scalar > const &other ) const
+    // Sum, norms and min/max with their coordinate, in a single pass
+    constexpr Reduction< Scalar > reduce( void ) const
     {
-        Scalar product = 0.0;
+        Reduction< Scalar > result;
 
-        product = _coordinates[0] * other._coordinates[1];
-        product -= _coordinates[1] * other._coordinates[0];
+        for( position_t i = 0; i < DIMENSIONS; ++i )
+        {
+            result.accumulate( _coordinates[i], i );
+        }
 
-        return product;
+        return result;
     }
 
-    Vector< 3, Scalar > cross( Vector< 3, Scalar > const &other ) const
+    // True when every coordinate differs by at most tolerance, stops at the
+    // first one that does not
+    constexpr bool approx_equal( Vector< DIMENSIONS, Scalar > const &other,
+                                 Scalar const &tolerance ) const
     {
-        Vector< 3, Scalar > result;
-        Scalar up, down;
-
-        const position_t size = _coordinates.size();
-
-        for( position_t i = 0; i < size; ++i )
+        for( position_t i = 0; i < DIMENSIONS; ++i )
         {
-            down = _coordinates[( i + 1 ) % size] * other._coordinates[( i + 2 ) % size];
-            up = _coordinates[( i + 2 ) % size] * other._coordinates[( i + 1 ) % size];
+            const Scalar diff = _coordinates[i] - other._coordinates[i];
 
-            result[i] = down - up;
+            // |diff| <= tolerance without std::fabs, which is not constexpr.
+            // Negated so that NaN on either side never compares equal.
+            if( !( ( diff <= tolerance ) && ( -diff <= tolerance ) ) )
+            {
+                return false;
+            }
         }
 
-        return result;
+        return true;
+    }
+
+    constexpr Scalar cross( Vector< 2, Scalar > const &other ) const
+    {
+        return _coordinates[0] * other.template get< 1 >() -
+               _coordinates[1] * other.template get< 0 >();
+    }
+
+    constexpr Vector< 3, Scalar > cross( Vector< 3, Scalar > const &other ) const
+    {
+        return Vector< 3, Scalar >(
+            {_coordinates[1] * other.template get< 2 >() - _coordinates[2] * other.template get< 1 >(),
+             _coordinates[2] * other.template get< 0 >() - _coordinates[0] * other.template get< 2 >(),
+             _coordinates[0] * other.template get< 1 >() -
+                 _coordinates[1] * other.template get< 0 >()} );
     }
 
-    void set( std::initializer_list< Scalar > values )
+    constexpr void set( std::initializer_list< Scalar > values )
     {
         typename std::initializer_list< Scalar >::iterator it = values.begin();
 
-        for( position_t i = 0; ( i < _coordinates.size() ) && ( it != values.end() ); ++i )
+        for( position_t i = 0; ( i < DIMENSIONS ) && ( it != values.end() ); ++i )
         {
             _coordinates[i] = *it;
             ++it;
         }
     }
 
-    Scalar &operator[]( position_t const &position )
+    // Compile time checked access, no runtime bounds check
+    template < position_t POSITION >
+    constexpr Scalar &get( void )
     {
-        return _coordinates.at( position );
+        static_assert( POSITION < DIMENSIONS, "Vector coordinate out of range!" );
+
+        return _coordinates[POSITION];
     }
 
-    Scalar const &operator[]( position_t const &position ) const
+    template < position_t POSITION >
+    constexpr Scalar const &get( void ) const
     {
-        return _coordinates.at( position );
+        static_assert( POSITION < DIMENSIONS, "Vector coordinate out of range!" );
+
+        return _coordinates[POSITION];
     }
 
-    Scalar operator*( Vector< DIMENSIONS, Scalar > const &other ) const
+    constexpr Scalar &operator[]( position_t const &position )
+    {
+        if( position >= DIMENSIONS )
+        {
+            throw std::out_of_range( "Vector coordinate out of range!" );
+        }
+
+        return _coordinates[position];
+    }
+
+    constexpr Scalar const &operator[]( position_t const &position ) const
+    {
+        if( position >= DIMENSIONS )
+        {
+            throw std::out_of_range( "Vector coordinate out of range!" );
+        }
+
+        return _coordinates[position];
+    }
+
+    constexpr Scalar operator*( Vector< DIMENSIONS, Scalar > const &other ) const
     {
         return this->dot( other );
     }
 
-    Vector< DIMENSIONS, Scalar > &operator=( Vector< DIMENSIONS, Scalar > const &other )
+    constexpr Vector< DIMENSIONS, Scalar > operator*( Scalar const &scalar ) const
     {
-        for( position_t i = 0; i < _coordinates.size(); ++i )
+        Vector< DIMENSIONS, Scalar > result( *this );
+
+        return result *= scalar;
+    }
+
+    constexpr Vector< DIMENSIONS, Scalar > &operator*=( Scalar const &scalar )
+    {
+        for( position_t i = 0; i < DIMENSIONS; ++i )
+        {
+            _coordinates[i] *= scalar;
+        }
+
+        return *this;
+    }
+
+    constexpr Vector< DIMENSIONS, Scalar > operator/( Scalar const &scalar ) const
+    {
+        Vector< DIMENSIONS, Scalar > result( *this );
+
+        return result /= scalar;
+    }
+
+    constexpr Vector< DIMENSIONS, Scalar > &operator/=( Scalar const &scalar )
+    {
+        for( position_t i = 0; i < DIMENSIONS; ++i )
+        {
+            _coordinates[i] /= scalar;
+        }
+
+        return *this;
+    }
+
+    constexpr Vector< DIMENSIONS, Scalar > operator+( Vector< DIMENSIONS, Scalar > const &other ) const
+    {
+        Vector< DIMENSIONS, Scalar > result( *this );
+
+        return result += other;
+    }
+
+    constexpr Vector< DIMENSIONS, Scalar > &operator+=( Vector< DIMENSIONS, Scalar > const &other )
+    {
+        for( position_t i = 0; i < DIMENSIONS; ++i )
+        {
+            _coordinates[i] += other._coordinates[i];
+        }
+
+        return *this;
+    }
+
+    constexpr Vector< DIMENSIONS, Scalar > operator-( Vector< DIMENSIONS, Scalar > const &other ) const
+    {
+        Vector< DIMENSIONS, Scalar > result( *this );
+
+        return result -= other;
+    }
+
+    constexpr Vector< DIMENSIONS, Scalar > &operator-=( Vector< DIMENSIONS, Scalar > const &other )
+    {
+        for( position_t i = 0; i < DIMENSIONS; ++i )
+        {
+            _coordinates[i] -= other._coordinates[i];
+        }
+
+        return *this;
+    }
+
+    constexpr Vector< DIMENSIONS, Scalar > operator-( void ) const
+    {
+        return ( *this ) * -1.0;
+    }
+
+    constexpr bool operator==( Vector< DIMENSIONS, Scalar > const &other ) const
+    {
+        for( position_t i = 0; i < DIMENSIONS; ++i )
+        {
+            if( _coordinates[i] != other._coordinates[i] )
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    constexpr bool operator!=( Vector< DIMENSIONS, Scalar > const &other ) const
+    {
+        return !( ( *this ) == other );
+    }
+
+    constexpr Vector< DIMENSIONS, Scalar > &operator=( Vector< DIMENSIONS, Scalar > const &other )
+    {
+        for( position_t i = 0; i < DIMENSIONS; ++i )
         {
             _coordinates[i] = other._coordinates[i];
         }
@@ -119,7 +265,7 @@ class Vector
         return *this;
     }
 
-    Vector< DIMENSIONS, Scalar > &operator=( std::initializer_list< Scalar > values )
+    constexpr Vector< DIMENSIONS, Scalar > &operator=( std::initializer_list< Scalar > values )
     {
         this->set( values );
 
@@ -127,9 +273,15 @@ class Vector
     }
 
     private:
-    std::array< typename std::enable_if< std::is_floating_point< Scalar >::value, Scalar >::type,
-                DIMENSIONS >
-        _coordinates;
+    typename std::enable_if< std::is_floating_point< Scalar >::value, Scalar >::type
+        _coordinates[DIMENSIONS];
 };
 
+template < position_t DIMENSIONS, typename Scalar >
+constexpr Vector< DIMENSIONS, Scalar > operator*( Scalar const &scalar,
+                                                  Vector< DIMENSIONS, Scalar > const &vector )
+{
+    return vector * scalar;
+}
+
 #endif
@@ -0,0 +1,388 @@
+#ifndef VECTOR_ARRAY_H
+#define VECTOR_ARRAY_H
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "vector.hpp"
+
+// Structure-of-arrays container for many Vector< DIMENSIONS, Scalar >.
+// Each coordinate lives in its own contiguous buffer, so bulk operations
+// walk unit-stride memory and the compiler is free to vectorize them.
+template < position_t DIMENSIONS, typename Scalar >
+class VectorArray
+{
+    static_assert( std::is_floating_point< Scalar >::value,
+                   "VectorArray only supports floating point scalars!" );
+
+    public:
+    typedef Vector< DIMENSIONS, Scalar > VectorType;
+
+    // Proxy returned by operator[], behaves like a Vector stored in the array
+    class Reference
+    {
+        public:
+        Reference( VectorArray< DIMENSIONS, Scalar > &array, std::size_t const &index )
+            : _array( array )
+            , _index( index )
+        {
+        }
+
+        inline position_t dimensions( void ) const
+        {
+            return DIMENSIONS;
+        }
+
+        Scalar &operator[]( position_t const &position )
+        {
+            return _array.component( position )[_index];
+        }
+
+        Scalar const &operator[]( position_t const &position ) const
+        {
+            return static_cast< VectorArray< DIMENSIONS, Scalar > const & >( _array ).component(
+                position )[_index];
+        }
+
+        operator VectorType( void ) const
+        {
+            return _array.get( _index );
+        }
+
+        Reference &operator=( VectorType const &vector )
+        {
+            _array.set( _index, vector );
+
+            return *this;
+        }
+
+        Reference &operator=( Reference const &other )
+        {
+            _array.set( _index, other._array.get( other._index ) );
+
+            return *this;
+        }
+
+        private:
+        VectorArray< DIMENSIONS, Scalar > &_array;
+        std::size_t _index;
+    };
+
+    VectorArray( void )
+    {
+    }
+
+    explicit VectorArray( std::size_t const &count )
+    {
+        this->resize( count );
+    }
+
+    inline std::size_t size( void ) const
+    {
+        return _components[0].size();
+    }
+
+    inline position_t dimensions( void ) const
+    {
+        return DIMENSIONS;
+    }
+
+    void resize( std::size_t const &count )
+    {
+        for( position_t d = 0; d < DIMENSIONS; ++d )
+        {
+            _components[d].resize( count, 0.0 );
+        }
+    }
+
+    void reserve( std::size_t const &count )
+    {
+        for( position_t d = 0; d < DIMENSIONS; ++d )
+        {
+            _components[d].reserve( count );
+        }
+    }
+
+    void push_back( VectorType const &vector )
+    {
+        for( position_t d = 0; d < DIMENSIONS; ++d )
+        {
+            _components[d].push_back( vector[d] );
+        }
+    }
+
+    VectorType get( std::size_t const &index ) const
+    {
+        VectorType vector;
+
+        assert_index( index );
+
+        for( position_t d = 0; d < DIMENSIONS; ++d )
+        {
+            vector[d] = _components[d][index];
+        }
+
+        return vector;
+    }
+
+    void set( std::size_t const &index, VectorType const &vector )
+    {
+        assert_index( index );
+
+        for( position_t d = 0; d < DIMENSIONS; ++d )
+        {
+            _components[d][index] = vector[d];
+        }
+    }
+
+    // Raw access to one coordinate of every vector
+    Scalar *component( position_t const &dimension )
+    {
+        return _components.at( dimension ).data();
+    }
+
+    Scalar const *component( position_t const &dimension ) const
+    {
+        return _components.at( dimension ).data();
+    }
+
+    Reference operator[]( std::size_t const &index )
+    {
+        assert_index( index );
+
+        return Reference( *this, index );
+    }
+
+    VectorType operator[]( std::size_t const &index ) const
+    {
+        return this->get( index );
+    }
+
+    // result[i] = (*this)[i] . other
+    void dot( VectorType const &other, std::vector< Scalar > &result ) const
+    {
+        const std::size_t count = this->size();
+
+        result.assign( count, 0.0 );
+        Scalar *out = result.data();
+
+        for( position_t d = 0; d < DIMENSIONS; ++d )
+        {
+            Scalar const *in = _components[d].data();
+            const Scalar factor = other[d];
+
+            for( std::size_t i = 0; i < count; ++i )
+            {
+                out[i] += in[i] * factor;
+            }
+        }
+    }
+
+    std::vector< Scalar > dot( VectorType const &other ) const
+    {
+        std::vector< Scalar > result;
+
+        this->dot( other, result );
+
+        return result;
+    }
+
+    // result[i] = (*this)[i] . other[i]
+    void dot( VectorArray< DIMENSIONS, Scalar > const &other, std::vector< Scalar > &result ) const
+    {
+        const std::size_t count = this->size();
+
+        assert_size_match( other );
+
+        result.assign( count, 0.0 );
+        Scalar *out = result.data();
+
+        for( position_t d = 0; d < DIMENSIONS; ++d )
+        {
+            Scalar const *first = _components[d].data();
+            Scalar const *second = other._components[d].data();
+
+            for( std::size_t i = 0; i < count; ++i )
+            {
+                out[i] += first[i] * second[i];
+            }
+        }
+    }
+
+    std::vector< Scalar > dot( VectorArray< DIMENSIONS, Scalar > const &other ) const
+    {
+        std::vector< Scalar > result;
+
+        this->dot( other, result );
+
+        return result;
+    }
+
+    // Element-wise cross product, only available for tridimensional arrays
+    VectorArray< DIMENSIONS, Scalar > cross( VectorArray< DIMENSIONS, Scalar > const &other ) const
+    {
+        static_assert( DIMENSIONS == 3, "Cross product is only defined for 3D vector arrays!" );
+
+        const std::size_t count = this->size();
+        VectorArray< DIMENSIONS, Scalar > result( count );
+
+        assert_size_match( other );
+
+        for( position_t d = 0; d < 3; ++d )
+        {
+            Scalar const *a1 = _components[( d + 1 ) % 3].data();
+            Scalar const *a2 = _components[( d + 2 ) % 3].data();
+            Scalar const *b1 = other._components[( d + 1 ) % 3].data();
+            Scalar const *b2 = other._components[( d + 2 ) % 3].data();
+            Scalar *out = result._components[d].data();
+
+            for( std::size_t i = 0; i < count; ++i )
+            {
+                out[i] = a1[i] * b2[i] - a2[i] * b1[i];
+            }
+        }
+
+        return result;
+    }
+
+    void norms( std::vector< Scalar > &result ) const
+    {
+        this->squared_norms( result );
+
+        for( Scalar &value : result )
+        {
+            value = std::sqrt( value );
+        }
+    }
+
+    std::vector< Scalar > norms( void ) const
+    {
+        std::vector< Scalar > result;
+
+        this->norms( result );
+
+        return result;
+    }
+
+    void distances_to( VectorType const &other, std::vector< Scalar > &result ) const
+    {
+        const std::size_t count = this->size();
+
+        result.assign( count, 0.0 );
+        Scalar *out = result.data();
+
+        for( position_t d = 0; d < DIMENSIONS; ++d )
+        {
+            Scalar const *in = _components[d].data();
+            const Scalar reference = other[d];
+
+            for( std::size_t i = 0; i < count; ++i )
+            {
+                const Scalar diff = in[i] - reference;
+                out[i] += diff * diff;
+            }
+        }
+
+        for( std::size_t i = 0; i < count; ++i )
+        {
+            out[i] = std::sqrt( out[i] );
+        }
+    }
+
+    std::vector< Scalar > distances_to( VectorType const &other ) const
+    {
+        std::vector< Scalar > result;
+
+        this->distances_to( other, result );
+
+        return result;
+    }
+
+    // Zero length vectors are left untouched
+    VectorArray< DIMENSIONS, Scalar > &normalize( void )
+    {
+        std::vector< Scalar > factors;
+        const std::size_t count = this->size();
+
+        this->squared_norms( factors );
+
+        for( std::size_t i = 0; i < count; ++i )
+        {
+            factors[i] = ( factors[i] > 0.0 ) ? ( 1.0 / std::sqrt( factors[i] ) ) : 1.0;
+        }
+
+        Scalar const *factor = factors.data();
+
+        for( position_t d = 0; d < DIMENSIONS; ++d )
+        {
+            Scalar *values = _components[d].data();
+
+            for( std::size_t i = 0; i < count; ++i )
+            {
+                values[i] *= factor[i];
+            }
+        }
+
+        return *this;
+    }
+
+    VectorArray< DIMENSIONS, Scalar > &scale( Scalar const &factor )
+    {
+        const std::size_t count = this->size();
+
+        for( position_t d = 0; d < DIMENSIONS; ++d )
+        {
+            Scalar *values = _components[d].data();
+
+            for( std::size_t i = 0; i < count; ++i )
+            {
+                values[i] *= factor;
+            }
+        }
+
+        return *this;
+    }
+
+    private:
+    std::array< std::vector< Scalar >, DIMENSIONS > _components;
+
+    void squared_norms( std::vector< Scalar > &result ) const
+    {
+        const std::size_t count = this->size();
+
+        result.assign( count, 0.0 );
+        Scalar *out = result.data();
+
+        for( position_t d = 0; d < DIMENSIONS; ++d )
+        {
+            Scalar const *in = _components[d].data();
+
+            for( std::size_t i = 0; i < count; ++i )
+            {
+                out[i] += in[i] * in[i];
+            }
+        }
+    }
+
+    void assert_index( std::size_t const &index ) const
+    {
+        if( index >= this->size() )
+        {
+            throw std::out_of_range( "VectorArray index out of range!" );
+        }
+    }
+
+    void assert_size_match( VectorArray< DIMENSIONS, Scalar > const &other ) const
+    {
+        if( this->size() != other.size() )
+        {
+            throw std::domain_error( "VectorArray sizes differ! Both arrays should have N vectors!" );
+        }
+    }
+};
+
+#endif
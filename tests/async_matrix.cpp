@@ -0,0 +1,74 @@
+#include <boost/test/unit_test.hpp>
+
+#include "../src/async_matrix.hpp"
+
+#include "test_utils.hpp"
+
+BOOST_AUTO_TEST_SUITE( ASYNC_MATRIX_TEST_SUITE )
+
+BOOST_AUTO_TEST_CASE( multiply_async_test )
+{
+    Matrix matrix1;
+    Matrix matrix2;
+    std::vector< value_t > progress;
+    AsyncOptions options;
+
+    matrix1.set( {1.0, 2.0, 3.0, 4.0, 5.0, 6.0}, 2, 3 );
+    matrix2.set( {7.0, 8.0, 9.0}, 3, 1 );
+
+    options.progress = [&progress]( value_t fraction ) -> void { progress.push_back( fraction ); };
+
+    Matrix result = multiply_async( matrix1, matrix2, options ).get();
+
+    BOOST_CHECK_CLOSE( result[0][0], 50.0, 0.00001 );
+    BOOST_CHECK_CLOSE( result[1][0], 122.0, 0.00001 );
+    test_uint_value( progress.size(), 2, "progress.size()" );
+    BOOST_CHECK_CLOSE( progress.back(), 1.0, 0.00001 );
+
+    BOOST_REQUIRE_THROW( multiply_async( matrix2, matrix2 ), std::domain_error );
+}
+
+BOOST_AUTO_TEST_CASE( inverse_and_determinant_async_test )
+{
+    Matrix matrix;
+
+    matrix.set( {3.0, 0.0, 2.0, 2.0, 0.0, -2.0, 0.0, 1.0, 1.0}, 3, 3 );
+
+    std::future< Matrix > inverse = inverse_async( matrix );
+    std::future< value_t > determinant = determinant_async( matrix );
+
+    Matrix result = inverse.get();
+
+    BOOST_CHECK_CLOSE( result[0][0], 0.2, 0.00001 );
+    BOOST_CHECK_CLOSE( result[1][2], 1.0, 0.00001 );
+    BOOST_CHECK_CLOSE( result[2][1], -0.3, 0.00001 );
+    BOOST_CHECK_CLOSE( determinant.get(), 10.0, 0.00001 );
+
+    matrix.set( {0.0, 0.0, 0.0, 0.0}, 2, 2 );
+
+    BOOST_REQUIRE_THROW( inverse_async( matrix ).get(), std::domain_error );
+
+    // Not exactly singular, but rcond is below machine epsilon
+    matrix.set( {1.0, 2.0, 2.0, 4.0 + 1e-15}, 2, 2 );
+
+    BOOST_REQUIRE_THROW( inverse_async( matrix ).get(), std::domain_error );
+}
+
+BOOST_AUTO_TEST_CASE( cancelled_operation_test )
+{
+    Matrix matrix = Matrix::identity_matrix( 4, 4 );
+    AsyncOptions options;
+
+    options.token.cancel();
+
+    BOOST_REQUIRE_THROW( determinant_async( matrix, options ).get(), OperationCancelled );
+
+    AsyncOptions expired;
+
+    expired.token.cancel_at( CancellationToken::Clock::now() );
+
+    BOOST_REQUIRE_THROW( multiply_async( matrix, matrix, expired ).get(), OperationCancelled );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+/* src/async_matrix.hpp test suite end */
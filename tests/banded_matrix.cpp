@@ -0,0 +1,63 @@
+#include <boost/test/unit_test.hpp>
+
+#include "../src/banded_matrix.hpp"
+
+#include "test_utils.hpp"
+
+BOOST_AUTO_TEST_SUITE( BANDED_MATRIX_CLASS_TEST_SUITE )
+
+BOOST_AUTO_TEST_CASE( banded_matrix_conversion_test )
+{
+    Matrix dense;
+
+    dense.set( {1.0, 2.0, 0.0, 0.0, 3.0, 4.0, 5.0, 0.0, 6.0, 7.0, 8.0, 9.0, 0.0, 1.0, 2.0, 3.0},
+               4,
+               4 );
+
+    BandedMatrix banded( dense, 2, 1 );
+
+    BOOST_CHECK_CLOSE( banded.get( 2, 0 ), 6.0, 0.00001 );
+    BOOST_CHECK_SMALL( banded.get( 0, 2 ), 0.00001 );
+    BOOST_REQUIRE_THROW( banded.element( 3, 0 ), std::out_of_range );
+
+    Matrix converted = banded.to_matrix();
+
+    for( position_t i = 0; i < 4; ++i )
+    {
+        for( position_t j = 0; j < 4; ++j )
+        {
+            BOOST_CHECK_CLOSE( converted[i][j], dense[i][j], 0.00001 );
+        }
+    }
+
+    BOOST_CHECK_CLOSE( banded.determinant(), dense.determinant(), 0.00001 );
+}
+
+BOOST_AUTO_TEST_CASE( banded_matrix_solve_with_pivoting_test )
+{
+    Matrix dense;
+
+    // First pivot is zero, so a line swap is required
+    dense.set( {0.0, 2.0, 0.0, 0.0, 3.0, 1.0, 5.0, 0.0, 0.0, 7.0, 1.0, 9.0, 0.0, 0.0, 2.0, 3.0},
+               4,
+               4 );
+
+    BandedMatrix banded( dense, 1, 1 );
+    std::vector< value_t > expected( {1.0, -1.0, 2.0, 0.5} );
+    std::vector< value_t > solution = banded.solve( banded.multiply( expected ) );
+
+    for( position_t i = 0; i < 4; ++i )
+    {
+        BOOST_CHECK_CLOSE( solution[i], expected[i], 0.00001 );
+    }
+
+    BOOST_CHECK_CLOSE( banded.determinant(), dense.determinant(), 0.00001 );
+
+    BandedMatrix singular( 3, 1, 1 );
+
+    BOOST_CHECK_SMALL( singular.determinant(), 0.00001 );
+    BOOST_REQUIRE_THROW( singular.solve( std::vector< value_t >( 3, 1.0 ) ), std::domain_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+/* src/banded_matrix.hpp test suite end */
@@ -0,0 +1,174 @@
+#include <boost/test/unit_test.hpp>
+
+#include "../src/distributed_matrix.hpp"
+#include "../src/socket_transport.hpp"
+
+#include <cstdlib>
+#include <thread>
+#include <unistd.h>
+
+#include "test_utils.hpp"
+
+namespace
+{
+// Runs a SUMMA product on every rank of a grid, rank 0 checks the gathered
+// result against a local product
+template < typename Factory >
+void check_summa( int const &grid_lines,
+                  int const &grid_columns,
+                  MatrixDimensions const &a_dimensions,
+                  position_t const &b_columns,
+                  Factory &&factory )
+{
+    const Matrix a = make_matrix( a_dimensions.first, a_dimensions.second, 1 );
+    const Matrix b = make_matrix( a_dimensions.second, b_columns, 2 );
+    const Matrix expected = a * b;
+    std::vector< std::thread > threads;
+    Matrix gathered;
+
+    for( int rank = 0; rank < grid_lines * grid_columns; ++rank )
+    {
+        threads.emplace_back( [&, rank]( void ) {
+            std::unique_ptr< Transport > transport = factory( rank );
+            ProcessGrid grid( *transport, grid_lines, grid_columns );
+            DistributedMatrix c = summa_multiply( DistributedMatrix::distribute( grid, a ),
+                                                  DistributedMatrix::distribute( grid, b ) );
+            Matrix result = c.gather( 0 );
+
+            if( rank == 0 )
+            {
+                gathered = result;
+            }
+        } );
+    }
+
+    for( std::thread &thread : threads )
+    {
+        thread.join();
+    }
+
+    test_bool_value( gathered.approx_equal( expected, 0.000001 ), true, "gathered.approx_equal" );
+}
+}
+
+BOOST_AUTO_TEST_SUITE( DISTRIBUTED_MATRIX_CLASS_TEST_SUITE )
+
+BOOST_AUTO_TEST_CASE( distribute_and_gather_test )
+{
+    InProcessNetwork network( 1 );
+    std::unique_ptr< Transport > transport = network.endpoint( 0 );
+    ProcessGrid grid( *transport, 1, 1 );
+    Matrix global = make_matrix( 3, 5, 0 );
+    DistributedMatrix distributed = DistributedMatrix::distribute( grid, global );
+
+    test_uint_value( distributed.local().dimensions().first, 3, "local().dimensions().first" );
+    test_bool_value( distributed.gather().approx_equal( global, 0.0 ), true, "gather()" );
+
+    BOOST_REQUIRE_THROW( ProcessGrid( *transport, 2, 1 ), std::domain_error );
+}
+
+BOOST_AUTO_TEST_CASE( block_offsets_test )
+{
+    InProcessNetwork network( 6 );
+    std::unique_ptr< Transport > transport = network.endpoint( 4 );
+    ProcessGrid grid( *transport, 2, 3 );
+    DistributedMatrix matrix( grid, 7, 8 );
+
+    test_uint_value( grid.line(), 1, "grid.line()" );
+    test_uint_value( grid.column(), 1, "grid.column()" );
+    test_uint_value( matrix.line_offset( 1 ), 3, "matrix.line_offset( 1 )" );
+    test_uint_value( matrix.column_offset( 1 ), 2, "matrix.column_offset( 1 )" );
+    test_uint_value( matrix.column_offset( 2 ), 5, "matrix.column_offset( 2 )" );
+    test_uint_value( matrix.local().dimensions().first, 4, "local().dimensions().first" );
+    test_uint_value( matrix.local().dimensions().second, 3, "local().dimensions().second" );
+}
+
+BOOST_AUTO_TEST_CASE( summa_in_process_test )
+{
+    InProcessNetwork square( 4 );
+
+    check_summa( 2, 2, MatrixDimensions( 6, 5 ), 7,
+                 [&square]( int const &rank ) { return square.endpoint( rank ); } );
+
+    // A's column blocks and B's line blocks do not line up
+    InProcessNetwork rectangular( 6 );
+
+    check_summa( 2, 3, MatrixDimensions( 5, 7 ), 4,
+                 [&rectangular]( int const &rank ) { return rectangular.endpoint( rank ); } );
+}
+
+BOOST_AUTO_TEST_CASE( summa_user_tags_test )
+{
+    // Application messages with tags 0 and 1 are pending during the product,
+    // SUMMA must neither consume them nor mistake them for its panels
+    InProcessNetwork network( 4 );
+    const Matrix a = make_matrix( 6, 5, 1 );
+    const Matrix b = make_matrix( 5, 7, 2 );
+    const Matrix expected = a * b;
+    std::vector< std::thread > threads;
+    std::vector< unsigned int > mismatches( 4, 0 );
+    Matrix gathered;
+
+    for( int rank = 0; rank < 4; ++rank )
+    {
+        threads.emplace_back( [&, rank]( void ) {
+            std::unique_ptr< Transport > transport = network.endpoint( rank );
+
+            for( int peer = 0; peer < 4; ++peer )
+            {
+                transport->send( peer, 0, std::vector< value_t >{100.0 + rank} );
+                transport->send( peer, 1, std::vector< value_t >{200.0 + rank} );
+            }
+
+            ProcessGrid grid( *transport, 2, 2 );
+            DistributedMatrix c = summa_multiply( DistributedMatrix::distribute( grid, a ),
+                                                  DistributedMatrix::distribute( grid, b ) );
+            Matrix result = c.gather( 0 );
+
+            for( int peer = 0; peer < 4; ++peer )
+            {
+                const std::vector< value_t > first = transport->receive( peer, 0 );
+                const std::vector< value_t > second = transport->receive( peer, 1 );
+
+                if( ( first.size() != 1 ) || ( first[0] != 100.0 + peer ) ||
+                    ( second.size() != 1 ) || ( second[0] != 200.0 + peer ) )
+                {
+                    ++mismatches[rank];
+                }
+            }
+
+            if( rank == 0 )
+            {
+                gathered = result;
+            }
+        } );
+    }
+
+    for( std::thread &thread : threads )
+    {
+        thread.join();
+    }
+
+    for( int rank = 0; rank < 4; ++rank )
+    {
+        test_uint_value( mismatches[rank], 0, "mismatches[" + std::to_string( rank ) + "]" );
+    }
+
+    test_bool_value( gathered.approx_equal( expected, 0.000001 ), true, "gathered.approx_equal" );
+}
+
+BOOST_AUTO_TEST_CASE( summa_unix_socket_test )
+{
+    char directory[] = "/tmp/summa_test_XXXXXX";
+
+    BOOST_REQUIRE( mkdtemp( directory ) != nullptr );
+
+    check_summa( 2, 2, MatrixDimensions( 9, 8 ), 10, [&directory]( int const &rank ) {
+        return std::unique_ptr< Transport >( SocketTransport::unix_domain( directory, rank, 4 ) );
+    } );
+
+    test_uint_value( rmdir( directory ), 0, "rmdir( directory )" );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+/* src/distributed_matrix.hpp test suite end */
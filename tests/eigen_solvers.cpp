@@ -0,0 +1,205 @@
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+
+#include "../src/eigen_solvers.hpp"
+
+#include "test_utils.hpp"
+
+namespace
+{
+const value_t PI = std::acos( -1.0 );
+
+// 1-D Laplacian, eigenvalues 2 - 2 cos( j pi / ( size + 1 ) ), j = 1..size
+SparseMatrix laplacian( position_t const &size )
+{
+    std::vector< SparseEntry > entries;
+
+    for( position_t i = 0; i < size; ++i )
+    {
+        entries.push_back( {i, i, 2.0} );
+
+        if( i > 0 )
+        {
+            entries.push_back( {i, i - 1, -1.0} );
+        }
+
+        if( i + 1 < size )
+        {
+            entries.push_back( {i, i + 1, -1.0} );
+        }
+    }
+
+    return SparseMatrix( size, size, entries );
+}
+
+// ||A x - lambda x|| for every returned pair, and orthonormal vectors
+void check_pairs( LinearOperator const &a, EigenResult const &result, value_t const &tolerance )
+{
+    const position_t n = a.size();
+    const position_t count = static_cast< position_t >( result.values.size() );
+    std::vector< value_t > product( n );
+
+    test_uint_value( result.vectors.dimensions().first, count, "vectors lines" );
+    test_uint_value( result.vectors.dimensions().second, n, "vectors columns" );
+
+    for( position_t i = 0; i < count; ++i )
+    {
+        value_t const *x = result.vectors[i];
+        value_t residual = 0.0;
+
+        a.apply( x, product.data() );
+
+        for( position_t k = 0; k < n; ++k )
+        {
+            const value_t difference = product[k] - result.values[i] * x[k];
+
+            residual += difference * difference;
+        }
+
+        BOOST_CHECK_SMALL( std::sqrt( residual ), tolerance );
+
+        for( position_t j = 0; j <= i; ++j )
+        {
+            value_t const *y = result.vectors[j];
+            value_t inner = 0.0;
+
+            for( position_t k = 0; k < n; ++k )
+            {
+                inner += x[k] * y[k];
+            }
+
+            BOOST_CHECK_SMALL( inner - ( ( i == j ) ? 1.0 : 0.0 ), 1e-8 );
+        }
+    }
+}
+}
+
+BOOST_AUTO_TEST_SUITE( EIGEN_SOLVERS_CLASS_TEST_SUITE )
+
+BOOST_AUTO_TEST_CASE( lanczos_sparse_test )
+{
+    const position_t n = 300;
+    SparseMatrix a = laplacian( n );
+    EigenOptions options;
+
+    options.max_iterations = 20000;
+
+    // The top of the spectrum is clustered, several restarts are needed
+    EigenResult result = lanczos( a, 4, options );
+
+    test_bool_value( result.converged, true, "result.converged" );
+    test_bool_value( result.iterations > 24, true, "result.iterations > 24" );
+    test_uint_value( result.values.size(), 4, "result.values.size()" );
+
+    for( position_t j = 0; j < 4; ++j )
+    {
+        BOOST_CHECK_CLOSE( result.values[j], 2.0 - 2.0 * std::cos( ( n - j ) * PI / ( n + 1 ) ),
+                           0.00001 );
+    }
+
+    check_pairs( a, result, 1e-7 );
+}
+
+BOOST_AUTO_TEST_CASE( lanczos_dense_test )
+{
+    Matrix a;
+
+    a.set( {4.0, 1.0, 0.0, 2.0, 1.0, 3.0, -1.0, 0.0, 0.0, -1.0, 5.0, 1.0, 2.0, 0.0, 1.0, -2.0},
+           4,
+           4 );
+
+    // Basis as large as A, the Krylov space is exhausted without a restart
+    EigenResult result = lanczos( a, 2 );
+
+    test_bool_value( result.converged, true, "result.converged" );
+    test_uint_value( result.iterations, 4, "result.iterations" );
+    test_bool_value( result.values[0] >= result.values[1], true, "decreasing values" );
+    check_pairs( a, result, 1e-9 );
+
+    // Trace is kept by the full spectrum
+    EigenResult full = lanczos( a, 4 );
+
+    BOOST_CHECK_CLOSE( full.values[0] + full.values[1] + full.values[2] + full.values[3],
+                       10.0,
+                       0.00001 );
+    check_pairs( a, full, 1e-9 );
+}
+
+BOOST_AUTO_TEST_CASE( lanczos_callable_test )
+{
+    // diag( 1, 2, ..., 500 ) without a matrix
+    const position_t n = 500;
+    LinearOperator a( n, []( value_t const *x, value_t *y ) {
+        for( position_t i = 0; i < 500; ++i )
+        {
+            y[i] = ( i + 1.0 ) * x[i];
+        }
+    } );
+    KrylovWorkspace workspace;
+    EigenOptions options;
+
+    options.max_iterations = 5000;
+
+    EigenResult result = lanczos( a, 3, options, &workspace );
+
+    test_bool_value( result.converged, true, "result.converged" );
+    BOOST_CHECK_CLOSE( result.values[0], 500.0, 0.00001 );
+    BOOST_CHECK_CLOSE( result.values[1], 499.0, 0.00001 );
+    BOOST_CHECK_CLOSE( result.values[2], 498.0, 0.00001 );
+    check_pairs( a, result, 1e-6 );
+
+    // A second solve reuses the buffers
+    const std::size_t allocations = workspace.allocations();
+
+    lanczos( a, 3, options, &workspace );
+    test_uint_value( workspace.allocations(), allocations, "workspace.allocations()" );
+
+    BOOST_CHECK_THROW( lanczos( a, 0 ), std::domain_error );
+    BOOST_CHECK_THROW( lanczos( a, 501 ), std::domain_error );
+
+    options.basis_size = 3;
+    BOOST_CHECK_THROW( lanczos( a, 3, options ), std::domain_error );
+}
+
+BOOST_AUTO_TEST_CASE( power_iteration_test )
+{
+    // Dominant eigenvalue is negative: -10 against 1..5
+    Matrix a;
+
+    a.set( {-10.0, 0.0, 0.0, 0.0, 0.0, 5.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 3.0},
+           4,
+           4 );
+
+    EigenResult result = power_iteration( a );
+
+    test_bool_value( result.converged, true, "result.converged" );
+    test_uint_value( result.values.size(), 1, "result.values.size()" );
+    BOOST_CHECK_CLOSE( result.values[0], -10.0, 0.00001 );
+    BOOST_CHECK_CLOSE( std::fabs( result.vectors[0][0] ), 1.0, 0.00001 );
+    check_pairs( a, result, 1e-8 );
+
+    // Same pair as Lanczos on a sparse operator with a clear gap
+    std::vector< SparseEntry > entries;
+
+    for( position_t i = 0; i < 100; ++i )
+    {
+        entries.push_back( {i, i, ( i == 50 ) ? 20.0 : 1.0 + 0.01 * i} );
+    }
+
+    SparseMatrix sparse( 100, 100, entries );
+    EigenResult dominant = power_iteration( sparse );
+
+    test_bool_value( dominant.converged, true, "dominant.converged" );
+    BOOST_CHECK_CLOSE( dominant.values[0], lanczos( sparse, 1 ).values[0], 0.00001 );
+
+    // Not enough iterations
+    EigenOptions options;
+
+    options.max_iterations = 2;
+    test_bool_value( power_iteration( a, options ).converged, false, "converged" );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/* src/eigen_solvers.hpp test suite end */
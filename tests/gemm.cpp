@@ -0,0 +1,325 @@
+#include <boost/test/unit_test.hpp>
+
+#include "../src/gemm.hpp"
+
+#include "test_utils.hpp"
+
+namespace
+{
+// Plain triple loop reference, independent from operator*
+value_t naive_entry( Matrix const &a, Matrix const &b, position_t const &i, position_t const &j )
+{
+    value_t sum = 0.0;
+
+    for( position_t p = 0; p < a.dimensions().second; ++p )
+    {
+        sum += a[i][p] * b[p][j];
+    }
+
+    return sum;
+}
+
+void check_product( Matrix const &result, Matrix const &a, Matrix const &b )
+{
+    test_bool_value( result.approx_equal( a * b, 0.000001 ), true, "result.approx_equal" );
+}
+}
+
+BOOST_AUTO_TEST_SUITE( GEMM_TEST_SUITE )
+
+BOOST_AUTO_TEST_CASE( gemm_test )
+{
+    Matrix a = make_matrix( 3, 4, 1 );
+    Matrix b = make_matrix( 4, 2, 2 );
+    Matrix c;
+
+    gemm( 1.0, a, false, b, false, 0.0, c );
+
+    test_uint_value( c.dimensions().first, 3, "c.dimensions().first" );
+    test_uint_value( c.dimensions().second, 2, "c.dimensions().second" );
+
+    for( position_t i = 0; i < 3; ++i )
+    {
+        for( position_t j = 0; j < 2; ++j )
+        {
+            BOOST_CHECK_CLOSE( c[i][j], naive_entry( a, b, i, j ), 0.00001 );
+        }
+    }
+
+    Matrix accumulated = make_matrix( 3, 2, 5 );
+    Matrix initial( accumulated );
+    value_t const *buffer = accumulated[0];
+
+    gemm( 2.0, a, false, b, false, -0.5, accumulated );
+
+    // Same dimensions, the buffer is written in place
+    test_bool_value( accumulated[0] == buffer, true, "accumulated[0] == buffer" );
+
+    for( position_t i = 0; i < 3; ++i )
+    {
+        for( position_t j = 0; j < 2; ++j )
+        {
+            BOOST_CHECK_CLOSE( accumulated[i][j],
+                               2.0 * naive_entry( a, b, i, j ) - 0.5 * initial[i][j],
+                               0.00001 );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( gemm_transposed_test )
+{
+    // a_t is a stored transposed (4x3), b_t is b stored transposed (2x4)
+    Matrix a = make_matrix( 3, 4, 1 );
+    Matrix b = make_matrix( 4, 2, 2 );
+    Matrix a_t;
+    Matrix b_t;
+
+    a_t.reset_dimensions( 4, 3 );
+    b_t.reset_dimensions( 2, 4 );
+
+    for( position_t i = 0; i < 3; ++i )
+    {
+        for( position_t j = 0; j < 4; ++j )
+        {
+            a_t[j][i] = a[i][j];
+        }
+    }
+
+    for( position_t i = 0; i < 4; ++i )
+    {
+        for( position_t j = 0; j < 2; ++j )
+        {
+            b_t[j][i] = b[i][j];
+        }
+    }
+
+    Matrix expected;
+    Matrix c;
+
+    gemm( 1.0, a, false, b, false, 0.0, expected );
+
+    gemm( 1.0, a_t, true, b, false, 0.0, c );
+    test_bool_value( c.approx_equal( expected, 0.000001 ), true, "transposed a" );
+
+    gemm( 1.0, a, false, b_t, true, 0.0, c );
+    test_bool_value( c.approx_equal( expected, 0.000001 ), true, "transposed b" );
+
+    gemm( 1.0, a_t, true, b_t, true, 0.0, c );
+    test_bool_value( c.approx_equal( expected, 0.000001 ), true, "transposed a and b" );
+}
+
+BOOST_AUTO_TEST_CASE( gemm_view_test )
+{
+    Matrix a = make_matrix( 3, 4, 1 );
+    Matrix b = make_matrix( 2, 4, 2 );
+    Matrix expected;
+    Matrix c;
+
+    gemm( 1.0, a, false, b.transposed(), false, 0.0, expected );
+
+    // b^T read in place through a column-major view
+    gemm( 1.0, MatrixView( a ), transposed_view( b ), 0.0, c );
+    test_bool_value( c.approx_equal( expected, 0.000001 ), true, "transposed_view( b )" );
+
+    // (b * a^T)^T = a * b^T
+    Matrix swapped;
+
+    gemm( 1.0, MatrixView( b ), transposed_view( a ), 0.0, swapped );
+    test_bool_value( transposed_view( swapped ).to_matrix().approx_equal( expected, 0.000001 ),
+                     true,
+                     "transposed_view( swapped )" );
+
+    BOOST_REQUIRE_THROW( gemm( 1.0, MatrixView( a ), MatrixView( b ), 0.0, c ),
+                         std::domain_error );
+
+    // Views of the result itself, whose resize would free their buffer
+    Matrix heap = make_matrix( 5, 4, 1 );
+
+    BOOST_REQUIRE_THROW( gemm( 1.0, transposed_view( heap ), MatrixView( heap ), 0.0, heap ),
+                         std::domain_error );
+    BOOST_REQUIRE_THROW( gemm( 1.0, heap, true, heap, false, 0.0, heap ), std::domain_error );
+    test_bool_value( heap.approx_equal( make_matrix( 5, 4, 1 ), 0.0 ), true, "heap untouched" );
+}
+
+BOOST_AUTO_TEST_CASE( gemm_parallel_test )
+{
+    const std::size_t previous = parallel_threshold();
+
+    Matrix a = make_matrix( 9, 7, 3 );
+    Matrix b = make_matrix( 9, 6, 4 );
+    Matrix serial;
+    Matrix parallel;
+
+    gemm( 1.5, a, true, b, false, 0.0, serial );
+
+    set_parallel_threshold( 1 );
+    gemm( 1.5, a, true, b, false, 0.0, parallel );
+    set_parallel_threshold( previous );
+
+    test_bool_value( parallel.approx_equal( serial, 0.000001 ), true, "parallel.approx_equal" );
+}
+
+BOOST_AUTO_TEST_CASE( gemm_error_test )
+{
+    Matrix a = make_matrix( 3, 4, 1 );
+    Matrix b = make_matrix( 4, 2, 2 );
+    Matrix c = make_matrix( 2, 2, 0 );
+
+    // Inner dimensions differ
+    BOOST_REQUIRE_THROW( gemm( 1.0, a, true, b, false, 0.0, c ), std::domain_error );
+    // Accumulating into a matrix of the wrong shape
+    BOOST_REQUIRE_THROW( gemm( 1.0, a, false, b, false, 1.0, c ), std::domain_error );
+
+    Matrix square = make_matrix( 4, 4, 1 );
+
+    // Result aliasing an operand
+    BOOST_REQUIRE_THROW( gemm( 1.0, square, false, square, false, 1.0, square ), std::domain_error );
+
+    // Same with a product of another shape: the operand is left untouched
+    Matrix tall = make_matrix( 3, 2, 1 );
+
+    BOOST_REQUIRE_THROW( gemm( 1.0, tall, true, tall, false, 0.0, tall ), std::domain_error );
+    test_uint_value( tall.dimensions().first, 3, "tall.dimensions().first" );
+    test_uint_value( tall.dimensions().second, 2, "tall.dimensions().second" );
+    test_bool_value( tall.approx_equal( make_matrix( 3, 2, 1 ), 0.0 ), true, "tall untouched" );
+}
+
+BOOST_AUTO_TEST_CASE( batched_gemm_test )
+{
+    std::vector< Matrix > a;
+    std::vector< Matrix > b;
+    std::vector< Matrix > c;
+
+    for( unsigned int i = 0; i < 6; ++i )
+    {
+        a.push_back( make_matrix( 3, 5, i ) );
+        b.push_back( make_matrix( 5, 2, 10 + i ) );
+    }
+
+    batched_gemm( a, b, c );
+
+    test_uint_value( c.size(), 6, "c.size()" );
+
+    for( unsigned int i = 0; i < 6; ++i )
+    {
+        check_product( c[i], a[i], b[i] );
+    }
+
+    b.push_back( make_matrix( 5, 2, 0 ) );
+
+    BOOST_REQUIRE_THROW( batched_gemm( a, b, c ), std::domain_error );
+
+    a.push_back( make_matrix( 4, 5, 0 ) );
+
+    BOOST_REQUIRE_THROW( batched_gemm( a, b, c ), std::domain_error );
+}
+
+BOOST_AUTO_TEST_CASE( batched_gemm_aliasing_test )
+{
+    std::vector< Matrix > a( 3, make_matrix( 4, 4, 1 ) );
+    std::vector< Matrix > b( 3, make_matrix( 4, 4, 4 ) );
+
+    BOOST_REQUIRE_THROW( batched_gemm( a, b, a ), std::domain_error );
+    BOOST_REQUIRE_THROW( batched_gemm( a, b, b ), std::domain_error );
+    test_uint_value( a.size(), 3, "a.size()" );
+    test_bool_value( a[0].approx_equal( make_matrix( 4, 4, 1 ), 0.0 ), true, "a[0] untouched" );
+
+    std::vector< value_t > buffer( 48, 1.0 );
+
+    // c starting inside a, and c covering b
+    BOOST_REQUIRE_THROW( batched_gemm_strided( buffer.data(), buffer.data() + 32, buffer.data() + 4,
+                                               2, 2, 2, 2 ),
+                         std::domain_error );
+    BOOST_REQUIRE_THROW( batched_gemm_strided( buffer.data(), buffer.data() + 8, buffer.data() + 8,
+                                               2, 2, 2, 2 ),
+                         std::domain_error );
+
+    // Adjacent buffers do not overlap
+    batched_gemm_strided( buffer.data(), buffer.data() + 8, buffer.data() + 16, 2, 2, 2, 2 );
+    BOOST_CHECK_CLOSE( buffer[16], 2.0, 0.00001 );
+}
+
+BOOST_AUTO_TEST_CASE( batched_gemm_specialized_size_test )
+{
+    const std::size_t previous = parallel_threshold();
+    std::vector< Matrix > a;
+    std::vector< Matrix > b;
+    std::vector< Matrix > c;
+
+    set_parallel_threshold( 1000 );
+
+    for( unsigned int i = 0; i < 5; ++i )
+    {
+        a.push_back( make_matrix( 32, 32, i ) );
+        b.push_back( make_matrix( 32, 32, 20 + i ) );
+    }
+
+    batched_gemm( a, b, c );
+
+    set_parallel_threshold( previous );
+
+    for( unsigned int i = 0; i < 5; ++i )
+    {
+        check_product( c[i], a[i], b[i] );
+    }
+
+    // Every fixed size kernel, against the plain loop
+    for( position_t size = 4; size <= 128; size *= 2 )
+    {
+        a.assign( 2, make_matrix( size, size, 1 ) );
+        b.assign( 2, make_matrix( size, size, 6 ).transposed() );
+        batched_gemm( a, b, c );
+
+        for( position_t i = 0; i < size; i += 3 )
+        {
+            for( position_t j = 0; j < size; j += 5 )
+            {
+                BOOST_CHECK_CLOSE( c[1][i][j], naive_entry( a[1], b[1], i, j ), 0.00001 );
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( gemv_test )
+{
+    Matrix a = make_matrix( 3, 2, 1 );
+    const value_t x[2] = {1.0, -2.0};
+    value_t y[3] = {1.0, 1.0, 1.0};
+    value_t transposed_y[2] = {0.0, 0.0};
+    const value_t ones[3] = {1.0, 1.0, 1.0};
+
+    gemv( 2.0, MatrixView( a ), x, 1.0, y );
+
+    for( position_t i = 0; i < 3; ++i )
+    {
+        BOOST_CHECK_CLOSE( y[i], 2.0 * ( a[i][0] - 2.0 * a[i][1] ) + 1.0, 0.00001 );
+    }
+
+    // Column-major view of a is a^T, read in place
+    gemv( 1.0, transposed_view( a ), ones, 0.0, transposed_y );
+
+    BOOST_CHECK_CLOSE( transposed_y[0], a[0][0] + a[1][0] + a[2][0], 0.00001 );
+    BOOST_CHECK_CLOSE( transposed_y[1], a[0][1] + a[1][1] + a[2][1], 0.00001 );
+}
+
+BOOST_AUTO_TEST_CASE( batched_gemm_strided_test )
+{
+    Matrix a = make_matrix( 2, 3, 1 );
+    Matrix b = make_matrix( 3, 2, 7 );
+    std::vector< value_t > a_buffer( a[0], a[0] + 6 );
+    std::vector< value_t > b_buffer( b[0], b[0] + 6 );
+    std::vector< value_t > c_buffer( 8 );
+
+    a_buffer.insert( a_buffer.end(), b[0], b[0] + 6 );
+    b_buffer.insert( b_buffer.end(), a[0], a[0] + 6 );
+
+    batched_gemm_strided( a_buffer.data(), b_buffer.data(), c_buffer.data(), 2, 2, 3, 1 );
+
+    Matrix expected = a * b;
+
+    BOOST_CHECK_CLOSE( c_buffer[0], expected[0][0], 0.00001 );
+    BOOST_CHECK_CLOSE( c_buffer[3], expected[1][1], 0.00001 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+/* src/gemm.hpp test suite end */
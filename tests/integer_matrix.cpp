@@ -0,0 +1,100 @@
+#include <boost/test/unit_test.hpp>
+
+#include <future>
+#include <vector>
+
+#include "../src/integer_matrix.hpp"
+
+#include "test_utils.hpp"
+
+BOOST_AUTO_TEST_SUITE( INTEGER_MATRIX_CLASS_TEST_SUITE )
+
+BOOST_AUTO_TEST_CASE( determinant_test )
+{
+    IntegerMatrix matrix;
+
+    matrix.set( {2, -3, 1, 2, 0, -1, 1, 4, 5}, 3, 3 );
+
+    test_bool_value( matrix.determinant() == 49, true, "matrix.determinant() == 49" );
+    test_bool_value( matrix.used_multiprecision(), false, "matrix.used_multiprecision()" );
+    test_bool_value( matrix.is_singular(), false, "matrix.is_singular()" );
+
+    // First pivot is zero, one line swap
+    matrix.set( {0, 1, 1, 0}, 2, 2 );
+    test_bool_value( matrix.determinant() == -1, true, "matrix.determinant() == -1" );
+
+    matrix.set( {2, 0, 1, 1, 3, 2, 1, 1, 1}, 3, 3 );
+    test_bool_value( matrix.determinant() == 0, true, "matrix.determinant() == 0" );
+    test_bool_value( matrix.is_singular(), true, "matrix.is_singular()" );
+
+    BOOST_REQUIRE_THROW( IntegerMatrix( 2, 3 ).determinant(), std::domain_error );
+}
+
+BOOST_AUTO_TEST_CASE( determinant_overflow_test )
+{
+    const integer_t big = 10000000000;
+    IntegerMatrix matrix;
+
+    matrix.set( {big, 1, 0, 0, big, 1, 1, 0, big}, 3, 3 );
+
+    // big^3 + 1 does not fit in 64 bits
+    const big_integer_t expected = big_integer_t( big ) * big * big + 1;
+
+    test_bool_value( matrix.determinant() == expected, true, "matrix.determinant() == expected" );
+    test_bool_value( matrix.used_multiprecision(), true, "matrix.used_multiprecision()" );
+
+    IntegerMatrix copy( matrix );
+
+    test_bool_value( copy.used_multiprecision(), true, "copy.used_multiprecision()" );
+
+    // Concurrent const calls on one matrix, checked from this thread
+    std::vector< std::future< big_integer_t > > results;
+
+    for( unsigned int i = 0; i < 4; ++i )
+    {
+        results.push_back( std::async( std::launch::async, [&matrix]() {
+            return matrix.determinant();
+        } ) );
+    }
+
+    for( std::future< big_integer_t > &result : results )
+    {
+        test_bool_value( result.get() == expected, true, "result.get() == expected" );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( rank_test )
+{
+    IntegerMatrix matrix;
+
+    // Third line is the sum of the first two, second column is all zeros
+    matrix.set( {1, 0, 2, 3, 4, 0, 5, 6, 5, 0, 7, 9}, 3, 4 );
+    test_uint_value( matrix.rank(), 2, "matrix.rank()" );
+
+    matrix.set( {1, 2, 2, 4, 3, 6}, 3, 2 );
+    test_uint_value( matrix.rank(), 1, "matrix.rank()" );
+
+    test_uint_value( IntegerMatrix( 3, 3 ).rank(), 0, "IntegerMatrix( 3, 3 ).rank()" );
+}
+
+BOOST_AUTO_TEST_CASE( conversion_test )
+{
+    Matrix values;
+
+    values.set( {1.0, -2.0, 3.0, 4.0}, 2, 2 );
+
+    IntegerMatrix matrix( values );
+
+    test_bool_value( matrix.element( 0, 1 ) == -2, true, "matrix.element( 0, 1 )" );
+    test_bool_value( matrix.determinant() == 10, true, "matrix.determinant() == 10" );
+    test_bool_value( matrix.to_matrix().approx_equal( values, 0.0 ), true, "matrix.to_matrix()" );
+
+    BOOST_REQUIRE_THROW( matrix.element( 2, 0 ), std::out_of_range );
+
+    values[0][0] = 0.5;
+
+    BOOST_REQUIRE_THROW( IntegerMatrix{values}, std::domain_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+/* src/integer_matrix.hpp test suite end */
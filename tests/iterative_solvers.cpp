@@ -0,0 +1,279 @@
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+
+#include "../src/iterative_solvers.hpp"
+#include "../src/parallel.hpp"
+
+#include "test_utils.hpp"
+
+namespace
+{
+// 2-D Poisson on a grid x grid mesh, symmetric positive definite
+SparseMatrix poisson( position_t const &grid )
+{
+    std::vector< SparseEntry > entries;
+
+    for( position_t i = 0; i < grid; ++i )
+    {
+        for( position_t j = 0; j < grid; ++j )
+        {
+            const position_t line = i * grid + j;
+
+            entries.push_back( {line, line, 4.0} );
+
+            if( i > 0 )
+            {
+                entries.push_back( {line, line - grid, -1.0} );
+            }
+
+            if( i + 1 < grid )
+            {
+                entries.push_back( {line, line + grid, -1.0} );
+            }
+
+            if( j > 0 )
+            {
+                entries.push_back( {line, line - 1, -1.0} );
+            }
+
+            if( j + 1 < grid )
+            {
+                entries.push_back( {line, line + 1, -1.0} );
+            }
+        }
+    }
+
+    return SparseMatrix( grid * grid, grid * grid, entries );
+}
+
+// Convection-diffusion like, diagonally dominant and not symmetric
+SparseMatrix nonsymmetric( position_t const &size )
+{
+    std::vector< SparseEntry > entries;
+
+    for( position_t i = 0; i < size; ++i )
+    {
+        entries.push_back( {i, i, 3.0} );
+
+        if( i > 0 )
+        {
+            entries.push_back( {i, i - 1, -1.5} );
+        }
+
+        if( i + 1 < size )
+        {
+            entries.push_back( {i, i + 1, -0.5} );
+        }
+
+        if( i + 7 < size )
+        {
+            entries.push_back( {i, i + 7, 0.25} );
+        }
+    }
+
+    return SparseMatrix( size, size, entries );
+}
+
+std::vector< value_t > expected_solution( position_t const &size )
+{
+    std::vector< value_t > values( size );
+
+    for( position_t i = 0; i < size; ++i )
+    {
+        values[i] = std::sin( 0.1 * i ) + 2.0;
+    }
+
+    return values;
+}
+
+void check_solution( std::vector< value_t > const &x, std::vector< value_t > const &expected )
+{
+    for( std::size_t i = 0; i < x.size(); ++i )
+    {
+        BOOST_CHECK_CLOSE( x[i], expected[i], 0.0001 );
+    }
+}
+}
+
+BOOST_AUTO_TEST_SUITE( ITERATIVE_SOLVERS_CLASS_TEST_SUITE )
+
+BOOST_AUTO_TEST_CASE( conjugate_gradient_test )
+{
+    SparseMatrix a = poisson( 20 );
+    std::vector< value_t > expected = expected_solution( 400 );
+    std::vector< value_t > b = a.multiply( expected );
+    std::vector< value_t > x;
+
+    SolverResult plain = conjugate_gradient( a, b, x );
+
+    test_bool_value( plain.converged, true, "plain.converged" );
+    check_solution( x, expected );
+
+    // ILU(0) needs fewer iterations
+    ILU0Preconditioner ilu( a );
+    SolverOptions options;
+
+    options.preconditioner = &ilu;
+    x.clear();
+
+    SolverResult preconditioned = conjugate_gradient( a, b, x, options );
+
+    test_bool_value( preconditioned.converged, true, "preconditioned.converged" );
+    test_bool_value( preconditioned.iterations < plain.iterations,
+                     true,
+                     "preconditioned.iterations < plain.iterations" );
+    check_solution( x, expected );
+}
+
+BOOST_AUTO_TEST_CASE( dense_operator_test )
+{
+    Matrix a;
+
+    a.set( {4.0, 1.0, 0.0, 1.0, 3.0, -1.0, 0.0, -1.0, 5.0}, 3, 3 );
+
+    std::vector< value_t > b( {6.0, 4.0, 13.0} );
+    std::vector< value_t > x;
+    JacobiPreconditioner jacobi( a );
+    SolverOptions options;
+
+    options.preconditioner = &jacobi;
+
+    test_bool_value( conjugate_gradient( a, b, x, options ).converged, true, "cg converged" );
+    check_solution( x, {1.0, 2.0, 3.0} );
+
+    x.clear();
+    test_bool_value( gmres( a, b, x ).converged, true, "gmres converged" );
+    check_solution( x, {1.0, 2.0, 3.0} );
+
+    BOOST_CHECK_THROW( conjugate_gradient( a, std::vector< value_t >( 2 ), x ), std::domain_error );
+}
+
+BOOST_AUTO_TEST_CASE( bicgstab_test )
+{
+    SparseMatrix a = nonsymmetric( 500 );
+    std::vector< value_t > expected = expected_solution( 500 );
+    std::vector< value_t > b = a.multiply( expected );
+    std::vector< value_t > x;
+
+    SolverResult plain = bicgstab( a, b, x );
+
+    test_bool_value( plain.converged, true, "plain.converged" );
+    check_solution( x, expected );
+
+    ILU0Preconditioner ilu( a );
+    SolverOptions options;
+
+    options.preconditioner = &ilu;
+    x.clear();
+
+    SolverResult preconditioned = bicgstab( a, b, x, options );
+
+    test_bool_value( preconditioned.converged, true, "preconditioned.converged" );
+    test_bool_value( preconditioned.iterations < plain.iterations,
+                     true,
+                     "preconditioned.iterations < plain.iterations" );
+    check_solution( x, expected );
+}
+
+BOOST_AUTO_TEST_CASE( gmres_test )
+{
+    SparseMatrix a = nonsymmetric( 500 );
+    std::vector< value_t > expected = expected_solution( 500 );
+    std::vector< value_t > b = a.multiply( expected );
+    std::vector< value_t > x;
+    SolverOptions options;
+
+    // Forces several restarts
+    options.restart = 5;
+
+    SolverResult restarted = gmres( a, b, x, options );
+
+    test_bool_value( restarted.converged, true, "restarted.converged" );
+    test_bool_value( restarted.iterations > 5, true, "restarted.iterations > 5" );
+    check_solution( x, expected );
+
+    JacobiPreconditioner jacobi( a );
+
+    options.preconditioner = &jacobi;
+    x.clear();
+
+    test_bool_value( gmres( a, b, x, options ).converged, true, "jacobi gmres converged" );
+    check_solution( x, expected );
+
+    options.restart = 0;
+    BOOST_CHECK_THROW( gmres( a, b, x, options ), std::domain_error );
+}
+
+BOOST_AUTO_TEST_CASE( callable_operator_test )
+{
+    // Matrix-free 1-D Laplacian, never stored
+    const position_t size = 100;
+    LinearOperator laplacian( size, [size]( value_t const *x, value_t *y ) {
+        for( position_t i = 0; i < size; ++i )
+        {
+            y[i] = 2.0 * x[i] - ( ( i > 0 ) ? x[i - 1] : 0.0 ) -
+                   ( ( i + 1 < size ) ? x[i + 1] : 0.0 );
+        }
+    } );
+    std::vector< value_t > expected = expected_solution( size );
+    std::vector< value_t > b( size );
+    std::vector< value_t > x;
+
+    laplacian.apply( expected.data(), b.data() );
+
+    SolverResult result = conjugate_gradient( laplacian, b, x );
+
+    test_bool_value( result.converged, true, "result.converged" );
+    test_bool_value( result.iterations <= size, true, "result.iterations <= size" );
+    check_solution( x, expected );
+
+    BOOST_CHECK_THROW( LinearOperator( 3, LinearOperator::Function() ), std::domain_error );
+}
+
+BOOST_AUTO_TEST_CASE( workspace_buffer_reuse_test )
+{
+    SparseMatrix a = nonsymmetric( 300 );
+    std::vector< value_t > b = a.multiply( expected_solution( 300 ) );
+    std::vector< value_t > x;
+    SparseMatrix smaller = poisson( 10 );
+    std::vector< value_t > smaller_b( 100, 1.0 );
+    KrylovWorkspace workspace;
+    SolverOptions options;
+
+    gmres( a, b, x, options, &workspace );
+
+    const std::size_t allocations = workspace.allocations();
+
+    // Same or smaller systems reuse the buffers
+    for( unsigned int i = 0; i < 3; ++i )
+    {
+        x.clear();
+        gmres( a, b, x, options, &workspace );
+        bicgstab( a, b, x, options, &workspace );
+        conjugate_gradient( smaller, smaller_b, x, options, &workspace );
+    }
+
+    test_uint_value( workspace.allocations(), allocations, "workspace.allocations()" );
+}
+
+BOOST_AUTO_TEST_CASE( parallel_solver_test )
+{
+    SparseMatrix a = poisson( 40 );
+    std::vector< value_t > expected = expected_solution( 1600 );
+    std::vector< value_t > b = a.multiply( expected );
+    std::vector< value_t > x;
+    const std::size_t previous = parallel_threshold();
+
+    set_parallel_threshold( 64 );
+
+    SolverResult result = conjugate_gradient( a, b, x );
+
+    set_parallel_threshold( previous );
+
+    test_bool_value( result.converged, true, "result.converged" );
+    check_solution( x, expected );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+/* src/iterative_solvers.hpp test suite end */
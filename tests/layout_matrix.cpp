@@ -0,0 +1,102 @@
+#include <boost/test/unit_test.hpp>
+
+#include "../src/layout_matrix.hpp"
+
+#include "test_utils.hpp"
+
+namespace
+{
+// Every position must map to a distinct offset inside the buffer, and
+// visit() must go through each of them once
+template < typename Layout >
+void check_layout( position_t const &lines, position_t const &columns )
+{
+    Layout layout( lines, columns );
+    std::vector< unsigned int > seen( layout.size(), 0 );
+    unsigned int visited = 0;
+
+    layout.visit( [&]( position_t const &i, position_t const &j, std::size_t const &offset ) {
+        BOOST_REQUIRE( offset < layout.size() );
+        BOOST_CHECK_EQUAL( offset, layout.offset( i, j ) );
+        ++seen[offset];
+        ++visited;
+    } );
+
+    test_uint_value( visited, lines * columns, "visited" );
+    test_uint_value( *std::max_element( seen.begin(), seen.end() ), 1, "seen" );
+}
+
+template < typename Layout >
+void check_matrix( position_t const &lines, position_t const &columns )
+{
+    const Matrix matrix = make_matrix( lines, columns );
+    LayoutMatrix< Layout > converted( matrix );
+
+    test_bool_value( converted.to_matrix().approx_equal( matrix, 0.0 ), true, "to_matrix()" );
+    BOOST_CHECK_EQUAL( converted( lines - 1, columns - 1 ), matrix[lines - 1][columns - 1] );
+
+    const std::vector< value_t > column = converted.column( columns - 1 );
+
+    BOOST_CHECK_EQUAL( column[lines - 1], matrix[lines - 1][columns - 1] );
+
+    test_bool_value( converted.transposed().to_matrix().approx_equal( matrix.transposed(), 0.0 ),
+                     true,
+                     "transposed()" );
+
+    const Matrix other = make_matrix( columns, 3 ) * 0.001;
+    const Matrix expected = matrix * other;
+    const Matrix product = ( converted * LayoutMatrix< Layout >( other ) ).to_matrix();
+
+    test_bool_value( product.approx_equal( expected, 0.000001 * expected.reduce().linf_norm() ),
+                     true,
+                     "operator*" );
+}
+}
+
+BOOST_AUTO_TEST_SUITE( LAYOUT_MATRIX_CLASS_TEST_SUITE )
+
+BOOST_AUTO_TEST_CASE( layout_offsets_test )
+{
+    check_layout< RowMajorLayout >( 5, 7 );
+    check_layout< TiledLayout< 4 > >( 9, 6 );
+    check_layout< TiledLayout<> >( 70, 3 );
+    check_layout< MortonLayout >( 8, 8 );
+    check_layout< MortonLayout >( 5, 13 );
+    check_layout< MortonLayout >( 33, 3 );
+
+    // Z-order inside a 2x2 block
+    MortonLayout morton( 4, 4 );
+
+    test_uint_value( morton.offset( 0, 1 ), 1, "morton.offset( 0, 1 )" );
+    test_uint_value( morton.offset( 1, 0 ), 2, "morton.offset( 1, 0 )" );
+    test_uint_value( morton.offset( 1, 1 ), 3, "morton.offset( 1, 1 )" );
+    test_uint_value( morton.offset( 0, 2 ), 4, "morton.offset( 0, 2 )" );
+}
+
+BOOST_AUTO_TEST_CASE( layout_matrix_test )
+{
+    check_matrix< RowMajorLayout >( 7, 5 );
+    check_matrix< TiledLayout< 4 > >( 10, 7 );
+    check_matrix< TiledLayout<> >( 70, 66 );
+    check_matrix< MortonLayout >( 9, 20 );
+    check_matrix< MortonLayout >( 40, 33 );
+}
+
+BOOST_AUTO_TEST_CASE( layout_conversion_test )
+{
+    const Matrix matrix = make_matrix( 11, 6 );
+    MortonMatrix morton( matrix );
+    TiledMatrix tiled( morton );
+    LayoutMatrix< TiledLayout< 4 > > small_tiles( tiled );
+
+    test_bool_value( small_tiles.to_matrix().approx_equal( matrix, 0.0 ), true, "conversions" );
+
+    small_tiles.element( 10, 5 ) = -1.0;
+    BOOST_CHECK_EQUAL( small_tiles.line( 10 )[5], -1.0 );
+
+    BOOST_REQUIRE_THROW( small_tiles.element( 11, 0 ), std::out_of_range );
+    BOOST_REQUIRE_THROW( morton * morton, std::domain_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+/* src/layout_matrix.hpp test suite end */
@@ -0,0 +1,143 @@
+#include <boost/test/unit_test.hpp>
+
+#include "../src/condition_estimate.hpp"
+#include "../src/lu_decomposition.hpp"
+
+#include "test_utils.hpp"
+
+BOOST_AUTO_TEST_SUITE( LU_DECOMPOSITION_CLASS_TEST_SUITE )
+
+BOOST_AUTO_TEST_CASE( lu_determinant_test )
+{
+    Matrix matrix;
+
+    matrix.set(
+        {3.0, 2.0, 0.0, 1.0, 4.0, 0.0, 1.0, 2.0, 3.0, 0.0, 2.0, 1.0, 9.0, 2.0, 3.0, 1.0}, 4, 4 );
+
+    LUDecomposition lu( matrix );
+
+    test_bool_value( lu.is_singular(), false, "lu.is_singular()" );
+    BOOST_CHECK_CLOSE( lu.determinant(), 24.0, 0.00001 );
+}
+
+BOOST_AUTO_TEST_CASE( lu_solve_and_inverse_test )
+{
+    Matrix matrix;
+
+    matrix.set( {3.0, 0.0, 2.0, 2.0, 0.0, -2.0, 0.0, 1.0, 1.0}, 3, 3 );
+
+    LUDecomposition lu( matrix );
+
+    std::vector< value_t > solution = lu.solve( std::vector< value_t >( {5.0, 0.0, 2.0} ) );
+
+    BOOST_CHECK_CLOSE( solution[0], 1.0, 0.00001 );
+    BOOST_CHECK_CLOSE( solution[1], 1.0, 0.00001 );
+    BOOST_CHECK_CLOSE( solution[2], 1.0, 0.00001 );
+
+    Matrix inverse = lu.inverse();
+
+    BOOST_CHECK_CLOSE( inverse[0][0], 0.2, 0.00001 );
+    BOOST_CHECK_CLOSE( inverse[1][2], 1.0, 0.00001 );
+    BOOST_CHECK_CLOSE( inverse[2][1], -0.3, 0.00001 );
+}
+
+BOOST_AUTO_TEST_CASE( lu_singular_matrix_test )
+{
+    Matrix matrix;
+
+    matrix.set( {1.0, 2.0, 2.0, 4.0}, 2, 2 );
+
+    LUDecomposition lu( matrix );
+
+    test_bool_value( lu.is_singular(), true, "lu.is_singular()" );
+    BOOST_CHECK_SMALL( lu.determinant(), 0.00001 );
+    BOOST_REQUIRE_THROW( lu.inverse(), std::domain_error );
+
+    matrix.reset_dimensions( 2, 3 );
+
+    BOOST_REQUIRE_THROW( LUDecomposition invalid( matrix ), std::domain_error );
+}
+
+BOOST_AUTO_TEST_CASE( lu_solve_transposed_test )
+{
+    Matrix matrix;
+
+    matrix.set( {0.0, 2.0, 1.0, 4.0, 1.0, -1.0, 2.0, 3.0, 5.0}, 3, 3 );
+
+    LUDecomposition lu( matrix );
+    const std::vector< value_t > rhs( {1.0, -2.0, 3.0} );
+    const std::vector< value_t > expected = LUDecomposition( matrix.transposed() ).solve( rhs );
+    const std::vector< value_t > solution = lu.solve_transposed( rhs );
+
+    for( unsigned int i = 0; i < 3; ++i )
+    {
+        BOOST_CHECK_CLOSE( solution[i], expected[i], 0.00001 );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( lu_condition_estimate_test )
+{
+    // Hilbert matrixes are notoriously ill conditioned
+    const position_t size = 6;
+    Matrix hilbert;
+
+    hilbert.reset_dimensions( size, size );
+
+    for( position_t i = 0; i < size; ++i )
+    {
+        for( position_t j = 0; j < size; ++j )
+        {
+            hilbert[i][j] = 1.0 / ( i + j + 1 );
+        }
+    }
+
+    LUDecomposition lu( hilbert );
+    const value_t exact = norm1( hilbert ) * norm1( lu.inverse() );
+    const value_t estimate = lu.condition_estimate();
+
+    // A lower bound, tight in practice
+    BOOST_CHECK( estimate <= exact * 1.000001 );
+    BOOST_CHECK( estimate >= exact / 3.0 );
+    BOOST_CHECK_CLOSE( lu.reciprocal_condition(), 1.0 / estimate, 0.00001 );
+
+    // Well conditioned even though the determinant is tiny
+    Matrix scaled = Matrix::identity_matrix( 4, 4 ) * 1e-6;
+
+    BOOST_CHECK_CLOSE( LUDecomposition( scaled ).condition_estimate(), 1.0, 0.00001 );
+    test_bool_value( scaled.generate_inverse().approx_equal( Matrix::identity_matrix( 4, 4 ) * 1e6,
+                                                             0.0001 ),
+                     true,
+                     "scaled.generate_inverse()" );
+
+    // Singular to working precision
+    Matrix rank_two;
+
+    rank_two.set( {1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0}, 3, 3 );
+
+    BOOST_CHECK( LUDecomposition( rank_two ).reciprocal_condition() < 1e-15 );
+    BOOST_REQUIRE_THROW( rank_two.generate_inverse(), std::domain_error );
+
+    Matrix singular;
+
+    singular.set( {1.0, 2.0, 2.0, 4.0}, 2, 2 );
+
+    test_bool_value( LUDecomposition( singular ).reciprocal_condition() == 0.0, true,
+                     "reciprocal_condition() == 0.0" );
+}
+
+BOOST_AUTO_TEST_CASE( lu_pivot_statistics_test )
+{
+    Matrix matrix;
+
+    matrix.set( {1.0, 0.0, 1.0, -1.0, 1.0, 1.0, -1.0, -1.0, 1.0}, 3, 3 );
+
+    // Wilkinson's example: U doubles its last column at every step
+    PivotStatistics statistics = LUDecomposition( matrix ).pivot_statistics();
+
+    BOOST_CHECK_CLOSE( statistics.growth_factor, 4.0, 0.00001 );
+    BOOST_CHECK_CLOSE( statistics.largest_pivot, 4.0, 0.00001 );
+    BOOST_CHECK_CLOSE( statistics.smallest_pivot, 1.0, 0.00001 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+/* src/lu_decomposition.hpp test suite end */
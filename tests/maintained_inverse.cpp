@@ -0,0 +1,170 @@
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+
+#include "../src/maintained_inverse.hpp"
+
+#include "test_utils.hpp"
+
+namespace
+{
+void check_inverse( MaintainedInverse const &maintained )
+{
+    Matrix product = maintained.matrix() * maintained.inverse();
+    const position_t size = product.dimensions().first;
+
+    for( position_t i = 0; i < size; ++i )
+    {
+        for( position_t j = 0; j < size; ++j )
+        {
+            BOOST_CHECK_SMALL( product[i][j] - ( ( i == j ) ? 1.0 : 0.0 ), 0.000001 );
+        }
+    }
+
+    BOOST_CHECK_CLOSE( maintained.determinant(), maintained.matrix().determinant(), 0.00001 );
+}
+}
+
+BOOST_AUTO_TEST_SUITE( MAINTAINED_INVERSE_CLASS_TEST_SUITE )
+
+BOOST_AUTO_TEST_CASE( rank_one_update_and_downdate_test )
+{
+    Matrix matrix;
+
+    matrix.set( {3.0, 0.0, 2.0, 2.0, 0.0, -2.0, 0.0, 1.0, 1.0}, 3, 3 );
+
+    MaintainedInverse maintained( matrix );
+
+    BOOST_CHECK_CLOSE( maintained.determinant(), 10.0, 0.00001 );
+
+    maintained.rank_one_update( {1.0, 0.0, 2.0}, {0.5, 1.0, -1.0} );
+
+    check_inverse( maintained );
+    BOOST_CHECK_CLOSE( maintained.matrix()[2][1], 3.0, 0.00001 );
+
+    maintained.rank_one_downdate( {1.0, 0.0, 2.0}, {0.5, 1.0, -1.0} );
+
+    check_inverse( maintained );
+    BOOST_CHECK_CLOSE( maintained.determinant(), 10.0, 0.00001 );
+    test_uint_value( maintained.refactorizations(), 0, "maintained.refactorizations()" );
+}
+
+BOOST_AUTO_TEST_CASE( replace_line_and_column_test )
+{
+    Matrix matrix;
+
+    matrix.set( {4.0, 1.0, 0.0, 1.0, 3.0, 1.0, 0.0, 1.0, 2.0}, 3, 3 );
+
+    MaintainedInverse maintained( matrix );
+
+    maintained.replace_line( 1, {2.0, 5.0, -1.0} );
+
+    check_inverse( maintained );
+    BOOST_CHECK_CLOSE( maintained.matrix()[1][1], 5.0, 0.00001 );
+
+    maintained.replace_column( 0, {1.0, 1.0, 1.0} );
+
+    check_inverse( maintained );
+    BOOST_CHECK_CLOSE( maintained.matrix()[2][0], 1.0, 0.00001 );
+}
+
+BOOST_AUTO_TEST_CASE( rank_k_update_test )
+{
+    Matrix matrix;
+    Matrix u;
+    Matrix v;
+
+    matrix.set( {4.0, 1.0, 0.0, 1.0, 3.0, 1.0, 0.0, 1.0, 2.0}, 3, 3 );
+    u.set( {1.0, 0.0, 0.0, 1.0, 1.0, 1.0}, 3, 2 );
+    v.set( {0.5, 0.0, 0.0, 2.0, 0.0, 1.0}, 3, 2 );
+
+    MaintainedInverse maintained( matrix );
+
+    maintained.rank_k_update( u, v );
+
+    check_inverse( maintained );
+
+    maintained.rank_k_downdate( u, v );
+
+    check_inverse( maintained );
+    BOOST_CHECK_CLOSE( maintained.matrix()[0][0], 4.0, 0.00001 );
+}
+
+BOOST_AUTO_TEST_CASE( singular_update_throws_test )
+{
+    Matrix matrix = Matrix::identity_matrix( 2, 2 );
+
+    MaintainedInverse maintained( matrix );
+
+    BOOST_REQUIRE_THROW( maintained.rank_one_update( {1.0, 0.0}, {-1.0, 0.0} ),
+                         std::domain_error );
+    BOOST_CHECK_CLOSE( maintained.determinant(), 1.0, 0.00001 );
+}
+
+BOOST_AUTO_TEST_CASE( forced_refactorization_test )
+{
+    DriftOptions options;
+    Matrix matrix = Matrix::identity_matrix( 3, 3 );
+
+    options.refactor_interval = 2;
+
+    MaintainedInverse maintained( matrix, options );
+
+    maintained.rank_one_update( {1.0, 0.0, 0.0}, {0.0, 1.0, 0.0} );
+    maintained.rank_one_update( {0.0, 1.0, 0.0}, {0.0, 0.0, 1.0} );
+
+    test_uint_value( maintained.refactorizations(), 1, "maintained.refactorizations()" );
+    check_inverse( maintained );
+}
+
+BOOST_AUTO_TEST_CASE( drift_refactorization_test )
+{
+    Matrix matrix;
+
+    // Hilbert matrix, badly conditioned: updates lose digits quickly
+    matrix.reset_dimensions( 5, 5 );
+
+    for( position_t i = 0; i < 5; ++i )
+    {
+        for( position_t j = 0; j < 5; ++j )
+        {
+            matrix[i][j] = 1.0 / ( i + j + 1.0 );
+        }
+    }
+
+    DriftOptions strict;
+    DriftOptions loose;
+
+    strict.tolerance = 1e-13;
+    loose.tolerance = 1.0;
+
+    MaintainedInverse checked( matrix, strict );
+    MaintainedInverse unchecked( matrix, loose );
+
+    for( unsigned int update = 0; update < 20; ++update )
+    {
+        std::vector< value_t > u( 5 );
+        std::vector< value_t > v( 5 );
+
+        for( position_t i = 0; i < 5; ++i )
+        {
+            u[i] = 0.01 * std::sin( update + 0.3 * i );
+            v[i] = 0.01 * std::cos( 2.0 * update + 0.7 * i );
+        }
+
+        checked.rank_one_update( u, v );
+        unchecked.rank_one_update( u, v );
+
+        // A refactorization always leaves the probe within tolerance
+        test_bool_value( checked.last_drift() <= strict.tolerance,
+                         true,
+                         "checked.last_drift() <= strict.tolerance" );
+    }
+
+    test_bool_value( checked.refactorizations() > 0, true, "checked.refactorizations() > 0" );
+    test_uint_value( unchecked.refactorizations(), 0, "unchecked.refactorizations()" );
+    check_inverse( checked );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+/* src/maintained_inverse.hpp test suite end */
@@ -1,5 +1,8 @@
 #include <boost/test/unit_test.hpp>
 
+#include <limits>
+
+#include "../src/lu_decomposition.hpp"
 #include "../src/matrix.hpp"
 
 #include "test_utils.hpp"
@@ -28,7 +31,7 @@ void test_matrix_equal( Matrix const &values, Matrix const &expected )
 
     for( unsigned int i = 0; i < values_dimensions.first; ++i )
     {
-        for( unsigned int j = 0; j < values_dimensions.first; ++j )
+        for( unsigned int j = 0; j < values_dimensions.second; ++j )
         {
             BOOST_CHECK_CLOSE( values[i][j], expected[i][j], 0.00001 );
         }
@@ -187,6 +190,21 @@ BOOST_AUTO_TEST_CASE( calculate_2x2_matrix_multiplication_test )
     test_matrix_equal( result, expected );
 }
 
+BOOST_AUTO_TEST_CASE( calculate_non_square_matrix_multiplication_test )
+{
+    Matrix matrix1;
+    Matrix matrix2;
+    Matrix expected;
+
+    matrix1.set( {1.0, 2.0, 3.0, 4.0, 5.0, 6.0}, 2, 3 );
+    matrix2.set( {7.0, 8.0, 9.0}, 3, 1 );
+    expected.set( {50.0, 122.0}, 2, 1 );
+
+    Matrix result = matrix1 * matrix2;
+
+    test_matrix_equal( result, expected );
+}
+
 BOOST_AUTO_TEST_CASE( throw_domain_error_for_invalid_multiplication_test )
 {
     Matrix matrix1;
@@ -334,6 +352,12 @@ BOOST_AUTO_TEST_CASE( throw_domain_error_for_zero_determinant_inverse_test )
     matrix.set( {0.0, 0.0, 0.0, 0.0}, 2, 2 );
 
     BOOST_REQUIRE_THROW( matrix.generate_inverse(), std::domain_error );
+
+    // Not exactly singular, but rcond is below machine epsilon
+    matrix.set( {1.0, 2.0, 2.0, 4.0 + 1e-15}, 2, 2 );
+
+    test_bool_value( LUDecomposition( matrix ).is_singular(), false, "is_singular()" );
+    BOOST_REQUIRE_THROW( matrix.generate_inverse(), std::domain_error );
 }
 
 BOOST_AUTO_TEST_CASE( get_transposed_matrix_test )
@@ -586,5 +610,142 @@ BOOST_AUTO_TEST_CASE( throw_domain_error_for_invalid_element_division_test )
     BOOST_REQUIRE_THROW( matrix1 / matrix2, std::domain_error );
 }
 
+BOOST_AUTO_TEST_CASE( matrix_reduction_test )
+{
+    Matrix matrix;
+
+    matrix.set( {3.0, -4.0, 1.0, 2.0, 0.0, -6.0}, 2, 3 );
+
+    Reduction< value_t > result = matrix.reduce();
+
+    test_uint_value( result.count, 6, "result.count" );
+    BOOST_CHECK_CLOSE( result.sum, -4.0, 0.00001 );
+    BOOST_CHECK_CLOSE( result.sum_of_squares, 66.0, 0.00001 );
+    BOOST_CHECK_CLOSE( result.l1_norm(), 16.0, 0.00001 );
+    BOOST_CHECK_CLOSE( result.l2_norm(), std::sqrt( 66.0 ), 0.00001 );
+    BOOST_CHECK_CLOSE( result.linf_norm(), 6.0, 0.00001 );
+    BOOST_CHECK_CLOSE( result.minimum, -6.0, 0.00001 );
+    test_uint_value( result.minimum_index, 5, "result.minimum_index" );
+    BOOST_CHECK_CLOSE( result.maximum, 3.0, 0.00001 );
+    test_uint_value( result.maximum_index, 0, "result.maximum_index" );
+
+    BOOST_CHECK_CLOSE( matrix.trace(), 3.0, 0.00001 );
+}
+
+BOOST_AUTO_TEST_CASE( matrix_approx_equal_test )
+{
+    Matrix matrix1;
+    Matrix matrix2;
+
+    matrix1.set( {1.0, 2.0, 3.0, 4.0}, 2, 2 );
+    matrix2.set( {1.0, 2.0, 3.0, 4.00001}, 2, 2 );
+
+    test_bool_value( matrix1.approx_equal( matrix2, 0.0001 ), true, "matrix1.approx_equal" );
+    test_bool_value( matrix1.approx_equal( matrix2, 0.000001 ), false, "matrix1.approx_equal" );
+
+    matrix2.set( {1.0, 2.0, 3.0, 4.0}, 1, 4 );
+
+    test_bool_value( matrix1.approx_equal( matrix2, 0.0001 ), false, "matrix1.approx_equal" );
+
+    // NaN is never close to anything, itself included
+    const value_t nan = std::numeric_limits< value_t >::quiet_NaN();
+
+    matrix2.set( {nan, nan, nan, nan}, 2, 2 );
+
+    test_bool_value( matrix1.approx_equal( matrix2, 1e300 ), false, "matrix1.approx_equal" );
+    test_bool_value( matrix2.approx_equal( matrix2, 1e300 ), false, "matrix2.approx_equal" );
+}
+
+BOOST_AUTO_TEST_CASE( copy_on_write_matrix_test )
+{
+    Matrix matrix;
+    Matrix expected;
+
+    matrix.reset_dimensions( 5, 4 );
+
+    for( position_t i = 0; i < 5; ++i )
+    {
+        for( position_t j = 0; j < 4; ++j )
+        {
+            matrix[i][j] = i * 4 + j;
+        }
+    }
+
+    expected = matrix;
+
+    Matrix deep_copy( matrix );
+
+    test_bool_value( deep_copy.shares_data_with( matrix ), false, "shares_data_with" );
+
+    matrix.set_copy_on_write( true );
+
+    Matrix shared_copy( matrix );
+    Matrix const &const_copy = shared_copy;
+
+    test_bool_value( shared_copy.copy_on_write(), true, "shared_copy.copy_on_write()" );
+    test_bool_value( shared_copy.shares_data_with( matrix ), true, "shares_data_with" );
+
+    BOOST_CHECK_CLOSE( const_copy[4][3], 19.0, 0.00001 );
+    test_bool_value( shared_copy.shares_data_with( matrix ), true, "shares_data_with" );
+
+    shared_copy[4][3] = 10.0;
+
+    test_bool_value( shared_copy.shares_data_with( matrix ), false, "shares_data_with" );
+    test_matrix_equal( matrix, expected );
+    BOOST_CHECK_CLOSE( shared_copy[4][3], 10.0, 0.00001 );
+
+    Matrix assigned;
+
+    assigned = matrix;
+    assigned *= 2.0;
+
+    test_matrix_equal( matrix, expected );
+    BOOST_CHECK_CLOSE( assigned[0][1], 2.0, 0.00001 );
+}
+
+BOOST_AUTO_TEST_CASE( small_matrix_inline_storage_test )
+{
+    Matrix small;
+    Matrix large;
+
+    small.set( {1.0, 2.0, 3.0, 4.0}, 2, 2 );
+    large.reset_dimensions( 5, 5 );
+
+    test_bool_value( small.uses_inline_storage(), true, "small.uses_inline_storage()" );
+    test_bool_value( large.uses_inline_storage(), false, "large.uses_inline_storage()" );
+
+    small.set_copy_on_write( true );
+
+    Matrix copy( small );
+    Matrix moved( std::move( copy ) );
+
+    test_bool_value( moved.shares_data_with( small ), false, "moved.shares_data_with" );
+    BOOST_CHECK_CLOSE( moved[1][0], 3.0, 0.00001 );
+
+    moved = large;
+
+    test_bool_value( moved.uses_inline_storage(), false, "moved.uses_inline_storage()" );
+    test_uint_value( moved.dimensions().first, 5, "moved.dimensions().first" );
+
+    moved = small;
+
+    test_bool_value( moved.uses_inline_storage(), true, "moved.uses_inline_storage()" );
+    BOOST_CHECK_CLOSE( moved.determinant(), -2.0, 0.00001 );
+}
+
+BOOST_AUTO_TEST_CASE( move_matrix_test )
+{
+    Matrix matrix;
+    Matrix expected;
+
+    matrix.set( {1.0, 2.0, 3.0, 4.0}, 2, 2 );
+    expected.set( {1.0, 2.0, 3.0, 4.0}, 2, 2 );
+
+    Matrix moved( std::move( matrix ) );
+
+    test_matrix_equal( moved, expected );
+    test_uint_value( matrix.dimensions().first, 0, "matrix.dimensions().first" );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 /* src/Vector test suite end */
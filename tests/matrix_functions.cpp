@@ -0,0 +1,133 @@
+#include <boost/test/unit_test.hpp>
+
+#include "../src/matrix_functions.hpp"
+
+#include "test_utils.hpp"
+
+BOOST_AUTO_TEST_SUITE( MATRIX_FUNCTIONS_TEST_SUITE )
+
+BOOST_AUTO_TEST_CASE( power_test )
+{
+    Matrix a;
+    Matrix expected = Matrix::identity_matrix( 3, 3 );
+    Matrix result;
+    MatrixFunctions functions;
+
+    a.set( {1.0, 1.0, 0.0, 0.0, 1.0, 2.0, 1.0, 0.0, 0.5}, 3, 3 );
+
+    for( unsigned long k = 0; k <= 20; ++k )
+    {
+        functions.power( a, k, result );
+
+        test_bool_value( result.approx_equal( expected, 0.000001 * expected.reduce().linf_norm() ),
+                         true,
+                         "power " + std::to_string( k ) );
+
+        expected = expected * a;
+    }
+
+    // 1000 = 0b1111101000: 9 squarings and 6 multiplications into the result
+    functions.power( a, 1000, result );
+    test_uint_value( functions.multiplications(), 15, "functions.multiplications()" );
+
+    BOOST_REQUIRE_THROW( matrix_power( Matrix::identity_matrix( 2, 3 ), 2 ), std::domain_error );
+}
+
+BOOST_AUTO_TEST_CASE( power_fibonacci_test )
+{
+    Matrix fibonacci;
+
+    fibonacci.set( {1.0, 1.0, 1.0, 0.0}, 2, 2 );
+
+    // Result aliasing the operand
+    MatrixFunctions().power( fibonacci, 50, fibonacci );
+
+    BOOST_CHECK_CLOSE( fibonacci[0][1], 12586269025.0, 0.00001 );
+    BOOST_CHECK_CLOSE( fibonacci[0][0], 20365011074.0, 0.00001 );
+}
+
+BOOST_AUTO_TEST_CASE( exponential_test )
+{
+    Matrix zero = Matrix::identity_matrix( 3, 3 ) * 0.0;
+
+    test_bool_value( matrix_exponential( zero ).approx_equal( Matrix::identity_matrix( 3, 3 ), 1e-12 ),
+                     true,
+                     "exp(0)" );
+
+    // exp(diag(1, -2)) = diag(e, e^-2)
+    Matrix diagonal;
+
+    diagonal.set( {1.0, 0.0, 0.0, -2.0}, 2, 2 );
+
+    Matrix result = matrix_exponential( diagonal );
+
+    BOOST_CHECK_CLOSE( result[0][0], std::exp( 1.0 ), 0.00001 );
+    BOOST_CHECK_CLOSE( result[1][1], std::exp( -2.0 ), 0.00001 );
+    BOOST_CHECK_SMALL( result[0][1], 1e-12 );
+
+    // exp([0 t; -t 0]) is a rotation by t, large enough to need squarings
+    const value_t t = 5.0;
+    Matrix rotation;
+
+    rotation.set( {0.0, t, -t, 0.0}, 2, 2 );
+
+    MatrixFunctions functions;
+
+    functions.exponential( rotation, result );
+
+    BOOST_CHECK_CLOSE( result[0][0], std::cos( t ), 0.0001 );
+    BOOST_CHECK_CLOSE( result[0][1], std::sin( t ), 0.0001 );
+    BOOST_CHECK_CLOSE( result[1][0], -std::sin( t ), 0.0001 );
+    BOOST_CHECK_CLOSE( result[1][1], std::cos( t ), 0.0001 );
+
+    // Nilpotent: exp(N) = I + N + N^2 / 2
+    Matrix nilpotent;
+
+    nilpotent.set( {0.0, 1.0, 3.0, 0.0, 0.0, 2.0, 0.0, 0.0, 0.0}, 3, 3 );
+
+    functions.exponential( nilpotent, nilpotent );
+
+    BOOST_CHECK_CLOSE( nilpotent[0][1], 1.0, 0.00001 );
+    BOOST_CHECK_CLOSE( nilpotent[0][2], 4.0, 0.00001 );
+    BOOST_CHECK_CLOSE( nilpotent[1][2], 2.0, 0.00001 );
+    BOOST_CHECK_CLOSE( nilpotent[2][2], 1.0, 0.00001 );
+}
+
+BOOST_AUTO_TEST_CASE( copy_on_write_operand_test )
+{
+    // 5x5 is past the inline storage, copies of a share its heap buffer
+    Matrix plain = make_matrix( 5, 5, 38 );
+    Matrix shared = plain;
+    MatrixFunctions functions;
+    Matrix expected;
+    Matrix result;
+
+    shared.set_copy_on_write( true );
+
+    functions.power( plain, 7, expected );
+
+    for( unsigned int call = 0; call < 2; ++call )
+    {
+        functions.power( shared, 7, result );
+        test_bool_value( result.approx_equal( expected, 1e-12 ), true, "power with copy-on-write" );
+    }
+
+    functions.exponential( plain, expected );
+
+    for( unsigned int call = 0; call < 2; ++call )
+    {
+        functions.exponential( shared, result );
+        test_bool_value(
+            result.approx_equal( expected, 1e-12 ), true, "exponential with copy-on-write" );
+    }
+
+    // Result sharing the operand buffer
+    Matrix copy = shared;
+
+    functions.exponential( shared, copy );
+    test_bool_value( copy.approx_equal( expected, 1e-12 ), true, "exponential into a shared copy" );
+    test_bool_value( shared.approx_equal( plain, 0.0 ), true, "operand unchanged" );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+/* src/matrix_functions.hpp test suite end */
@@ -0,0 +1,209 @@
+#include <boost/test/unit_test.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+
+#include "../src/matrix_io.hpp"
+#include "../src/parallel.hpp"
+
+#include "test_utils.hpp"
+
+namespace
+{
+void parse_text( std::string const &text, Matrix &result, DelimitedOptions const &options )
+{
+    parse_delimited( text.data(), text.data() + text.size(), result, options );
+}
+
+template < typename Result >
+void parse_market( std::string const &text, Result &result )
+{
+    parse_matrix_market( text.data(), text.data() + text.size(), result );
+}
+}
+
+BOOST_AUTO_TEST_SUITE( MATRIX_IO_CLASS_TEST_SUITE )
+
+BOOST_AUTO_TEST_CASE( parse_csv_test )
+{
+    Matrix matrix;
+    DelimitedOptions options;
+
+    options.skip_lines = 1;
+    parse_text( "a,b,c\n1,2.5,-3\r\n\n +4e2 , 5,6\n", matrix, options );
+
+    test_uint_value( matrix.dimensions().first, 2, "matrix.dimensions().first" );
+    test_uint_value( matrix.dimensions().second, 3, "matrix.dimensions().second" );
+    BOOST_CHECK_CLOSE( matrix[0][1], 2.5, 0.00001 );
+    BOOST_CHECK_CLOSE( matrix[0][2], -3.0, 0.00001 );
+    BOOST_CHECK_CLOSE( matrix[1][0], 400.0, 0.00001 );
+    BOOST_CHECK_CLOSE( matrix[1][2], 6.0, 0.00001 );
+
+    options.skip_lines = 0;
+    BOOST_CHECK_THROW( parse_text( "1,2\n3\n", matrix, options ), std::domain_error );
+    BOOST_CHECK_THROW( parse_text( "1,2\n3,4,5\n", matrix, options ), std::domain_error );
+    BOOST_CHECK_THROW( parse_text( "1,x\n", matrix, options ), std::domain_error );
+
+    parse_text( "", matrix, options );
+    test_uint_value( matrix.dimensions().first, 0, "matrix.dimensions().first" );
+}
+
+BOOST_AUTO_TEST_CASE( parse_whitespace_delimited_test )
+{
+    Matrix matrix;
+    DelimitedOptions options;
+
+    options.delimiter = ' ';
+    parse_text( "1 2\t 3\n  4   5 6", matrix, options );
+
+    test_uint_value( matrix.dimensions().first, 2, "matrix.dimensions().first" );
+    BOOST_CHECK_CLOSE( matrix[0][2], 3.0, 0.00001 );
+    BOOST_CHECK_CLOSE( matrix[1][0], 4.0, 0.00001 );
+    BOOST_CHECK_CLOSE( matrix[1][2], 6.0, 0.00001 );
+}
+
+BOOST_AUTO_TEST_CASE( parse_delimited_parallel_test )
+{
+    const position_t lines = 3000;
+    const position_t columns = 7;
+    std::string text;
+
+    for( position_t i = 0; i < lines; ++i )
+    {
+        for( position_t j = 0; j < columns; ++j )
+        {
+            text += std::to_string( i * 0.5 + j ) + ( ( j + 1 < columns ) ? "," : "\n" );
+        }
+
+        // Blank lines must not shift the following ones
+        if( i % 100 == 0 )
+        {
+            text += "\n";
+        }
+    }
+
+    Matrix matrix;
+
+    matrix.reset_dimensions( lines, columns );
+
+    value_t const *buffer = matrix[0];
+    const std::size_t previous = parallel_threshold();
+
+    set_parallel_threshold( 1000 );
+    parse_text( text, matrix, DelimitedOptions() );
+    set_parallel_threshold( previous );
+
+    // Preallocated destination is written in place
+    test_bool_value( buffer == matrix[0], true, "buffer == matrix[0]" );
+
+    for( position_t i = 0; i < lines; i += 97 )
+    {
+        BOOST_CHECK_CLOSE( matrix[i][0], i * 0.5, 0.00001 );
+        BOOST_CHECK_CLOSE( matrix[i][6], i * 0.5 + 6.0, 0.00001 );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( matrix_market_coordinate_test )
+{
+    const std::string text = "%%MatrixMarket matrix coordinate real symmetric\n"
+                             "% comment\n"
+                             "3 3 4\n"
+                             "1 1 2.0\n"
+                             "2 1 -1\n"
+                             "3 2 -1\n"
+                             "3 3 2\n";
+    SparseMatrix sparse;
+    Matrix dense;
+
+    parse_market( text, sparse );
+    parse_market( text, dense );
+
+    test_uint_value( sparse.non_zeros(), 6, "sparse.non_zeros()" );
+    BOOST_CHECK_CLOSE( sparse.get( 0, 1 ), -1.0, 0.00001 );
+    BOOST_CHECK_CLOSE( sparse.get( 1, 0 ), -1.0, 0.00001 );
+    BOOST_CHECK_CLOSE( dense[1][2], -1.0, 0.00001 );
+    BOOST_CHECK_CLOSE( dense[2][2], 2.0, 0.00001 );
+    BOOST_CHECK_EQUAL( dense[0][2], 0.0 );
+
+    parse_market( "%%MatrixMarket matrix coordinate pattern general\n2 3 2\n1 3\n2 2\n", sparse );
+
+    test_uint_value( sparse.dimensions().second, 3, "sparse.dimensions().second" );
+    BOOST_CHECK_CLOSE( sparse.get( 0, 2 ), 1.0, 0.00001 );
+
+    const std::string banner = "%%MatrixMarket matrix coordinate real general\n";
+
+    // Missing entry, then out of range position
+    BOOST_CHECK_THROW( parse_market( banner + "2 2 2\n1 1 1\n", sparse ), std::domain_error );
+    BOOST_CHECK_THROW( parse_market( banner + "2 2 1\n3 1 1\n", sparse ), std::domain_error );
+    BOOST_CHECK_THROW(
+        parse_market( "%%MatrixMarket matrix coordinate complex general\n1 1 1\n1 1 1 0\n", dense ),
+        std::domain_error );
+    BOOST_CHECK_THROW( parse_market( "1 1 1\n1 1 1\n", dense ), std::domain_error );
+}
+
+BOOST_AUTO_TEST_CASE( matrix_market_array_test )
+{
+    Matrix matrix;
+
+    // Column after column
+    parse_market( "%%MatrixMarket matrix array real general\n2 3\n1\n2\n3\n4\n5\n6\n", matrix );
+
+    BOOST_CHECK_CLOSE( matrix[0][0], 1.0, 0.00001 );
+    BOOST_CHECK_CLOSE( matrix[1][0], 2.0, 0.00001 );
+    BOOST_CHECK_CLOSE( matrix[0][2], 5.0, 0.00001 );
+    BOOST_CHECK_CLOSE( matrix[1][2], 6.0, 0.00001 );
+
+    parse_market( "%%MatrixMarket matrix array real skew-symmetric\n3 3\n1\n2\n3\n", matrix );
+
+    BOOST_CHECK_EQUAL( matrix[1][1], 0.0 );
+    BOOST_CHECK_CLOSE( matrix[1][0], 1.0, 0.00001 );
+    BOOST_CHECK_CLOSE( matrix[0][1], -1.0, 0.00001 );
+    BOOST_CHECK_CLOSE( matrix[2][1], 3.0, 0.00001 );
+    BOOST_CHECK_CLOSE( matrix[1][2], -3.0, 0.00001 );
+
+    SparseMatrix sparse;
+
+    parse_market( "%%MatrixMarket matrix array integer symmetric\n2 2\n4\n0\n5\n", sparse );
+
+    test_uint_value( sparse.non_zeros(), 2, "sparse.non_zeros()" );
+    BOOST_CHECK_CLOSE( sparse.get( 1, 1 ), 5.0, 0.00001 );
+
+    // Corrupt size lines: 10^10 values announced for one given, and a
+    // dimension past position_t
+    const std::string banner = "%%MatrixMarket matrix array real general\n";
+
+    BOOST_CHECK_THROW( parse_market( banner + "100000 100000\n1\n", matrix ), std::domain_error );
+    BOOST_CHECK_THROW( parse_market( banner + "4294967297 1\n1\n", matrix ), std::domain_error );
+}
+
+BOOST_AUTO_TEST_CASE( read_files_test )
+{
+    char directory[] = "/tmp/matrix_io_test_XXXXXX";
+
+    BOOST_REQUIRE( mkdtemp( directory ) != nullptr );
+
+    const std::string csv = std::string( directory ) + "/values.csv";
+    const std::string market = std::string( directory ) + "/values.mtx";
+
+    std::ofstream( csv ) << "1,2\n3,4\n";
+    std::ofstream( market ) << "%%MatrixMarket matrix coordinate real general\n2 2 1\n2 1 7.5\n";
+
+    Matrix dense = read_delimited( csv );
+    SparseMatrix sparse;
+
+    read_matrix_market( market, sparse );
+
+    BOOST_CHECK_CLOSE( dense[1][1], 4.0, 0.00001 );
+    BOOST_CHECK_CLOSE( sparse.get( 1, 0 ), 7.5, 0.00001 );
+    BOOST_CHECK_THROW( read_delimited( std::string( directory ) + "/missing.csv" ),
+                       MatrixFileError );
+
+    std::remove( csv.c_str() );
+    std::remove( market.c_str() );
+    rmdir( directory );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+/* src/matrix_io.hpp test suite end */
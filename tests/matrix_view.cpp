@@ -0,0 +1,63 @@
+#include <boost/test/unit_test.hpp>
+
+#include "../src/matrix_view.hpp"
+
+#include "test_utils.hpp"
+
+BOOST_AUTO_TEST_SUITE( MATRIX_VIEW_CLASS_TEST_SUITE )
+
+BOOST_AUTO_TEST_CASE( view_test )
+{
+    Matrix matrix;
+
+    matrix.set( {1.0, 2.0, 3.0, 4.0, 5.0, 6.0}, 3, 2 );
+
+    MatrixView view( matrix );
+
+    test_uint_value( view.dimensions().first, 3, "view.dimensions().first" );
+    test_uint_value( view.dimensions().second, 2, "view.dimensions().second" );
+    test_bool_value( view.data() == matrix[0], true, "view.data() == matrix[0]" );
+    BOOST_CHECK_EQUAL( view[2][1], 6.0 );
+
+    test_bool_value( view.to_matrix().approx_equal( matrix, 0.0 ), true, "view.to_matrix()" );
+
+    const value_t values[] = {1.0, 2.0, 3.0, 4.0};
+    MatrixView raw( values, 2, 2 );
+
+    BOOST_CHECK_EQUAL( raw[1][0], 3.0 );
+    test_uint_value( MatrixView().to_matrix().dimensions().first, 0, "empty to_matrix()" );
+}
+
+BOOST_AUTO_TEST_CASE( transposed_view_test )
+{
+    Matrix matrix;
+
+    matrix.reset_dimensions( 37, 45 );
+
+    for( position_t i = 0; i < 37; ++i )
+    {
+        for( position_t j = 0; j < 45; ++j )
+        {
+            matrix[i][j] = 100.0 * i + j;
+        }
+    }
+
+    MatrixView view = transposed_view( matrix );
+
+    // Nothing copied, only the orientation changes
+    test_bool_value( view.data() == matrix[0], true, "view.data() == matrix[0]" );
+    test_bool_value( view.order() == StorageOrder::column_major, true, "view.order()" );
+    test_uint_value( view.dimensions().first, 45, "view.dimensions().first" );
+    BOOST_CHECK_EQUAL( view( 44, 36 ), matrix[36][44] );
+    BOOST_REQUIRE_THROW( view[0], std::domain_error );
+
+    test_bool_value( view.to_matrix().approx_equal( matrix.transposed(), 0.0 ), true,
+                     "view.to_matrix()" );
+    test_bool_value( view.transposed().order() == StorageOrder::line_major, true,
+                     "view.transposed().order()" );
+    test_bool_value( view.transposed().to_matrix().approx_equal( matrix, 0.0 ), true,
+                     "view.transposed().to_matrix()" );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+/* src/matrix_view.hpp test suite end */
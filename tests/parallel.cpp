@@ -0,0 +1,115 @@
+#include <boost/test/unit_test.hpp>
+
+#include "../src/matrix.hpp"
+#include "../src/parallel.hpp"
+
+#include "test_utils.hpp"
+
+namespace
+{
+// Lowers the parallel threshold for the duration of a test
+struct SmallThreshold
+{
+    SmallThreshold( void )
+        : previous( parallel_threshold() )
+    {
+        set_parallel_threshold( 4 );
+    }
+
+    ~SmallThreshold( void )
+    {
+        set_parallel_threshold( previous );
+    }
+
+    std::size_t previous;
+};
+}
+
+BOOST_AUTO_TEST_SUITE( PARALLEL_TEST_SUITE )
+
+BOOST_AUTO_TEST_CASE( parallel_for_covers_whole_range_test )
+{
+    SmallThreshold threshold;
+    std::vector< unsigned int > visits( 1000, 0 );
+
+    parallel_for( visits.size(), [&visits]( std::size_t begin, std::size_t end ) {
+        for( std::size_t i = begin; i < end; ++i )
+        {
+            ++visits[i];
+        }
+    } );
+
+    for( unsigned int visit : visits )
+    {
+        test_uint_value( visit, 1, "visit" );
+    }
+
+    BOOST_REQUIRE_THROW( parallel_for( 1000,
+                                       []( std::size_t begin, std::size_t ) {
+                                           if( begin > 0 )
+                                           {
+                                               throw std::runtime_error( "chunk failed" );
+                                           }
+                                       } ),
+                         std::runtime_error );
+}
+
+BOOST_AUTO_TEST_CASE( parallel_reduce_sum_test )
+{
+    SmallThreshold threshold;
+    std::vector< value_t > values( 1001 );
+
+    for( std::size_t i = 0; i < values.size(); ++i )
+    {
+        values[i] = i;
+    }
+
+    value_t sum = parallel_reduce(
+        values.size(),
+        0.0,
+        [&values]( std::size_t begin, std::size_t end ) -> value_t {
+            value_t partial = 0.0;
+
+            for( std::size_t i = begin; i < end; ++i )
+            {
+                partial += values[i];
+            }
+
+            return partial;
+        },
+        []( value_t first, value_t second ) -> value_t { return first + second; } );
+
+    BOOST_CHECK_CLOSE( sum, 500500.0, 0.00001 );
+}
+
+BOOST_AUTO_TEST_CASE( parallel_matrix_element_wise_test )
+{
+    SmallThreshold threshold;
+    Matrix matrix;
+    Matrix other;
+
+    matrix.reset_dimensions( 30, 40 );
+    other.reset_dimensions( 30, 40 );
+
+    for( position_t i = 0; i < 30; ++i )
+    {
+        for( position_t j = 0; j < 40; ++j )
+        {
+            matrix[i][j] = i + j;
+            other[i][j] = 2.0;
+        }
+    }
+
+    Matrix sum = matrix + other;
+    Matrix scaled = matrix * 3.0;
+
+    matrix -= 1.0;
+
+    BOOST_CHECK_CLOSE( sum[29][39], 70.0, 0.00001 );
+    BOOST_CHECK_CLOSE( scaled[10][5], 45.0, 0.00001 );
+    BOOST_CHECK_CLOSE( matrix[29][39], 67.0, 0.00001 );
+    BOOST_CHECK_CLOSE( ( matrix / other )[3][3], 2.5, 0.00001 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+/* src/parallel.hpp test suite end */
@@ -0,0 +1,145 @@
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include "../src/parallel.hpp"
+#include "../src/point_transform.hpp"
+
+#include "test_utils.hpp"
+
+namespace
+{
+typedef PointTransform< double > Transform;
+typedef Vector< 3, double > Point;
+
+Transform translation( double const &x, double const &y, double const &z )
+{
+    Matrix matrix;
+
+    matrix.set( {1.0, 0.0, 0.0, x, 0.0, 1.0, 0.0, y, 0.0, 0.0, 1.0, z, 0.0, 0.0, 0.0, 1.0}, 4, 4 );
+
+    return Transform( matrix );
+}
+
+// Rotation of 90 degrees around z
+Transform quarter_turn( void )
+{
+    Matrix matrix;
+
+    matrix.set( {0.0, -1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0},
+                4,
+                4 );
+
+    return Transform( matrix );
+}
+
+// Pinhole projection, w = z
+Transform projection( void )
+{
+    Matrix matrix;
+
+    matrix.set( {1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0},
+                4,
+                4 );
+
+    return Transform( matrix );
+}
+
+void check_point( Point const &point, double const &x, double const &y, double const &z )
+{
+    BOOST_CHECK_SMALL( point[0] - x, 1e-12 );
+    BOOST_CHECK_SMALL( point[1] - y, 1e-12 );
+    BOOST_CHECK_SMALL( point[2] - z, 1e-12 );
+}
+}
+
+BOOST_AUTO_TEST_SUITE( POINT_TRANSFORM_CLASS_TEST_SUITE )
+
+BOOST_AUTO_TEST_CASE( point_transform_chain_test )
+{
+    // Translate first, then rotate
+    Transform combined = Transform::chain( {translation( 1.0, 0.0, 0.0 ), quarter_turn()} );
+
+    test_bool_value( combined.is_affine(), true, "combined.is_affine()" );
+    check_point( combined.apply( Point( {1.0, 2.0, 3.0} ) ), -2.0, 2.0, 3.0 );
+
+    Transform reversed = quarter_turn().then( translation( 1.0, 0.0, 0.0 ) );
+
+    check_point( reversed.apply( Point( {1.0, 2.0, 3.0} ) ), -1.0, 1.0, 3.0 );
+    BOOST_CHECK_CLOSE( reversed.to_matrix()[0][3], 1.0, 0.00001 );
+    BOOST_CHECK_THROW( reversed( 4, 0 ), std::out_of_range );
+
+    Matrix wrong;
+
+    wrong.reset_dimensions( 3, 3 );
+    BOOST_CHECK_THROW( Transform transform( wrong ), std::domain_error );
+}
+
+BOOST_AUTO_TEST_CASE( point_transform_perspective_test )
+{
+    Transform camera = Transform::chain( {translation( 0.0, 0.0, 2.0 ), projection()} );
+
+    test_bool_value( camera.is_affine(), false, "camera.is_affine()" );
+    check_point( camera.apply( Point( {4.0, -2.0, 2.0} ) ), 1.0, -0.5, 1.0 );
+
+    Vector< 4, double > homogeneous = camera.apply( Vector< 4, double >( {4.0, -2.0, 2.0, 1.0} ) );
+
+    BOOST_CHECK_CLOSE( homogeneous[3], 4.0, 0.00001 );
+    BOOST_CHECK_CLOSE( homogeneous[0], 4.0, 0.00001 );
+
+    homogeneous = camera.apply( Vector< 4, double >( {4.0, -2.0, 2.0, 1.0} ), true );
+
+    BOOST_CHECK_CLOSE( homogeneous[0], 1.0, 0.00001 );
+    BOOST_CHECK_CLOSE( homogeneous[3], 1.0, 0.00001 );
+}
+
+BOOST_AUTO_TEST_CASE( point_transform_bulk_in_place_test )
+{
+    const std::size_t count = 10000;
+    std::vector< Point > points( count );
+    std::vector< Point > transformed( count );
+    Transform combined = Transform::chain( {quarter_turn(), translation( 1.0, 2.0, 3.0 )} );
+    const std::size_t previous = parallel_threshold();
+
+    for( std::size_t i = 0; i < count; ++i )
+    {
+        points[i] = Point( {double( i ), 0.5 * i, -1.0} );
+    }
+
+    set_parallel_threshold( 1000 );
+
+    combined.apply( points.data(), transformed.data(), count );
+    combined.apply( points.data(), points.data(), count );
+
+    set_parallel_threshold( previous );
+
+    for( std::size_t i = 0; i < count; i += 997 )
+    {
+        check_point( transformed[i], 1.0 - 0.5 * i, 2.0 + i, 2.0 );
+        check_point( points[i], 1.0 - 0.5 * i, 2.0 + i, 2.0 );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( point_transform_vector_array_test )
+{
+    VectorArray< 3, double > points( 3 );
+    VectorArray< 3, double > projected;
+    Transform camera = Transform::chain( {translation( 0.0, 0.0, 2.0 ), projection()} );
+
+    points[0] = Point( {4.0, -2.0, 2.0} );
+    points[1] = Point( {1.0, 1.0, 0.0} );
+    points[2] = Point( {0.0, 6.0, 1.0} );
+
+    camera.apply( points, projected );
+
+    test_uint_value( projected.size(), 3, "projected.size()" );
+    check_point( projected.get( 0 ), 1.0, -0.5, 1.0 );
+    check_point( projected.get( 2 ), 0.0, 2.0, 1.0 );
+
+    translation( 1.0, 1.0, 1.0 ).apply( points );
+
+    check_point( points.get( 1 ), 2.0, 2.0, 1.0 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+/* src/point_transform.hpp test suite end */
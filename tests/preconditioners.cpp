@@ -0,0 +1,74 @@
+#include <boost/test/unit_test.hpp>
+
+#include "../src/preconditioners.hpp"
+
+#include "test_utils.hpp"
+
+BOOST_AUTO_TEST_SUITE( PRECONDITIONERS_CLASS_TEST_SUITE )
+
+BOOST_AUTO_TEST_CASE( jacobi_preconditioner_test )
+{
+    Matrix matrix;
+
+    matrix.set( {2.0, 1.0, 1.0, 4.0}, 2, 2 );
+
+    JacobiPreconditioner jacobi( matrix );
+    const value_t r[2] = {1.0, 1.0};
+    value_t z[2];
+
+    jacobi.apply( r, z );
+
+    BOOST_CHECK_CLOSE( z[0], 0.5, 0.00001 );
+    BOOST_CHECK_CLOSE( z[1], 0.25, 0.00001 );
+
+    matrix.set( {2.0, 1.0, 1.0, 0.0}, 2, 2 );
+
+    BOOST_CHECK_THROW( JacobiPreconditioner( SparseMatrix( matrix ) ), std::domain_error );
+}
+
+BOOST_AUTO_TEST_CASE( ilu0_tridiagonal_is_exact_test )
+{
+    // A tridiagonal LU has no fill, so ILU(0) is the exact factorization
+    Matrix matrix;
+
+    matrix.set( {4.0, 1.0, 0.0, 0.0, 2.0, 5.0, 1.0, 0.0, 0.0, 1.0, 6.0, 2.0, 0.0, 0.0, 3.0, 7.0},
+                4,
+                4 );
+
+    ILU0Preconditioner ilu( ( SparseMatrix( matrix ) ) );
+    const value_t b[4] = {5.0, 8.0, 9.0, 10.0};
+    value_t z[4];
+
+    ilu.apply( b, z );
+
+    for( position_t i = 0; i < 4; ++i )
+    {
+        BOOST_CHECK_CLOSE( z[i], 1.0, 0.00001 );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( ilu0_drops_fill_test )
+{
+    // Full first line and column: exact LU fills the rest, ILU(0) does not
+    Matrix matrix;
+
+    matrix.set( {4.0, 1.0, 1.0, 1.0, 4.0, 0.0, 1.0, 0.0, 4.0}, 3, 3 );
+
+    ILU0Preconditioner ilu( ( SparseMatrix( matrix ) ) );
+    const value_t r[3] = {1.0, 0.0, 0.0};
+    value_t z[3];
+
+    ilu.apply( r, z );
+
+    // L = [1 0 0; 0.25 1 0; 0.25 0 1], U = [4 1 1; 0 3.75 0; 0 0 3.75]
+    BOOST_CHECK_CLOSE( z[2], -0.25 / 3.75, 0.00001 );
+    BOOST_CHECK_CLOSE( z[1], -0.25 / 3.75, 0.00001 );
+    BOOST_CHECK_CLOSE( z[0], ( 1.0 + 0.5 / 3.75 ) / 4.0, 0.00001 );
+
+    matrix.set( {0.0, 1.0, 1.0, 0.0}, 2, 2 );
+
+    BOOST_CHECK_THROW( ILU0Preconditioner( SparseMatrix( matrix ) ), std::domain_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+/* src/preconditioners.hpp test suite end */
@@ -0,0 +1,87 @@
+#include <boost/test/unit_test.hpp>
+
+#include "../src/qr_decomposition.hpp"
+
+#include "test_utils.hpp"
+
+namespace
+{
+void check_factorization( Matrix const &matrix )
+{
+    QRDecomposition qr( matrix );
+    Matrix q = qr.thin_q();
+    Matrix r = qr.r();
+    const position_t m = matrix.dimensions().first;
+    const position_t n = matrix.dimensions().second;
+    const position_t p = std::min( m, n );
+
+    test_uint_value( q.dimensions().second, p, "q.dimensions().second" );
+    test_uint_value( r.dimensions().first, p, "r.dimensions().first" );
+
+    Matrix product = q * r;
+    Matrix gram = q.transposed() * q;
+
+    for( position_t i = 0; i < m; ++i )
+    {
+        for( position_t j = 0; j < n; ++j )
+        {
+            BOOST_CHECK_SMALL( product[i][j] - matrix[i][j], 1e-12 );
+        }
+    }
+
+    for( position_t i = 0; i < p; ++i )
+    {
+        for( position_t j = 0; j < p; ++j )
+        {
+            BOOST_CHECK_SMALL( gram[i][j] - ( ( i == j ) ? 1.0 : 0.0 ), 1e-12 );
+        }
+
+        for( position_t j = 0; j < i; ++j )
+        {
+            BOOST_CHECK_EQUAL( r[i][j], 0.0 );
+        }
+    }
+}
+}
+
+BOOST_AUTO_TEST_SUITE( QR_DECOMPOSITION_CLASS_TEST_SUITE )
+
+BOOST_AUTO_TEST_CASE( qr_factorization_test )
+{
+    check_factorization( make_matrix( 6, 4 ) );
+    check_factorization( make_matrix( 3, 5 ) );
+    check_factorization( make_matrix( 40, 40 ) );
+}
+
+BOOST_AUTO_TEST_CASE( qr_least_squares_test )
+{
+    // Fits y = 1 + 2x exactly, then an inconsistent system
+    Matrix a;
+    Matrix y;
+
+    a.set( {1.0, 0.0, 1.0, 1.0, 1.0, 2.0, 1.0, 3.0}, 4, 2 );
+    y.set( {1.0, 3.0, 5.0, 7.0}, 4, 1 );
+
+    Matrix fit = QRDecomposition( a ).solve( y );
+
+    BOOST_CHECK_CLOSE( fit[0][0], 1.0, 0.00001 );
+    BOOST_CHECK_CLOSE( fit[1][0], 2.0, 0.00001 );
+
+    y.set( {0.0, 1.0, 1.0, 3.0}, 4, 1 );
+    fit = QRDecomposition( a ).solve( y );
+
+    // Normal equations: intercept -0.1, slope 0.9
+    BOOST_CHECK_CLOSE( fit[0][0], -0.1, 0.00001 );
+    BOOST_CHECK_CLOSE( fit[1][0], 0.9, 0.00001 );
+
+    Matrix rank_deficient;
+
+    rank_deficient.set( {1.0, 2.0, 2.0, 4.0, 3.0, 6.0}, 3, 2 );
+    y.set( {1.0, 2.0, 3.0}, 3, 1 );
+
+    BOOST_CHECK_THROW( QRDecomposition( rank_deficient ).solve( y ), std::domain_error );
+    BOOST_CHECK_THROW( QRDecomposition( make_matrix( 2, 3 ) ).solve( y ), std::domain_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+/* src/qr_decomposition.hpp test suite end */
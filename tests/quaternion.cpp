@@ -0,0 +1,169 @@
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+
+#include "../src/parallel.hpp"
+#include "../src/quaternion.hpp"
+
+#include "test_utils.hpp"
+
+namespace
+{
+typedef Quaternion< double > Rotation;
+typedef Vector< 3, double > Vector3;
+
+const double PI = std::acos( -1.0 );
+
+void check_vector( Vector3 const &vector, double const &x, double const &y, double const &z )
+{
+    BOOST_CHECK_SMALL( vector[0] - x, 1e-12 );
+    BOOST_CHECK_SMALL( vector[1] - y, 1e-12 );
+    BOOST_CHECK_SMALL( vector[2] - z, 1e-12 );
+}
+
+void check_same_rotation( Rotation const &a, Rotation const &b )
+{
+    // q and -q are the same rotation
+    BOOST_CHECK_SMALL( std::fabs( a.dot( b ) ) - 1.0, 1e-12 );
+}
+}
+
+BOOST_AUTO_TEST_SUITE( QUATERNION_CLASS_TEST_SUITE )
+
+BOOST_AUTO_TEST_CASE( quaternion_rotate_test )
+{
+    Rotation quarter = Rotation::from_axis_angle( Vector3( {0.0, 0.0, 2.0} ), PI / 2 );
+
+    BOOST_CHECK_CLOSE( quarter.norm(), 1.0, 0.00001 );
+    check_vector( quarter.rotate( Vector3( {1.0, 0.0, 0.0} ) ), 0.0, 1.0, 0.0 );
+    check_vector( quarter.conjugate().rotate( Vector3( {0.0, 1.0, 5.0} ) ), 1.0, 0.0, 5.0 );
+    check_vector( Rotation().rotate( Vector3( {1.0, 2.0, 3.0} ) ), 1.0, 2.0, 3.0 );
+
+    BOOST_CHECK_THROW( Rotation::from_axis_angle( Vector3(), 1.0 ), std::domain_error );
+}
+
+BOOST_AUTO_TEST_CASE( quaternion_compose_test )
+{
+    Rotation around_z = Rotation::from_axis_angle( Vector3( {0.0, 0.0, 1.0} ), PI / 2 );
+    Rotation around_x = Rotation::from_axis_angle( Vector3( {1.0, 0.0, 0.0} ), PI / 2 );
+    Vector3 point( {1.0, 2.0, 3.0} );
+
+    // around_x first, then around_z
+    Rotation combined = around_z * around_x;
+    Vector3 expected = around_z.rotate( around_x.rotate( point ) );
+    Vector3 rotated = combined.rotate( point );
+
+    check_vector( rotated, expected[0], expected[1], expected[2] );
+
+    // A long chain stays a rotation once normalized
+    Rotation step = Rotation::from_axis_angle( Vector3( {1.0, 2.0, 3.0} ), 0.001 );
+    Rotation accumulated;
+
+    for( unsigned int i = 0; i < 10000; ++i )
+    {
+        accumulated *= step;
+    }
+
+    accumulated.normalize();
+    check_same_rotation( accumulated,
+                         Rotation::from_axis_angle( Vector3( {1.0, 2.0, 3.0} ), 10.0 ) );
+}
+
+BOOST_AUTO_TEST_CASE( quaternion_matrix_conversion_test )
+{
+    Rotation rotation = Rotation::from_axis_angle( Vector3( {1.0, -1.0, 0.5} ), 2.5 );
+    Matrix matrix = rotation.to_rotation_matrix();
+    Vector3 point( {0.3, -2.0, 1.5} );
+    Vector3 expected = rotation.rotate( point );
+
+    for( position_t i = 0; i < 3; ++i )
+    {
+        const double value =
+            matrix[i][0] * point[0] + matrix[i][1] * point[1] + matrix[i][2] * point[2];
+
+        BOOST_CHECK_SMALL( value - expected[i], 1e-12 );
+    }
+
+    check_same_rotation( Rotation::from_rotation_matrix( matrix ), rotation );
+
+    // Every branch of the conversion: 180 degrees around each axis
+    check_same_rotation(
+        Rotation::from_rotation_matrix( Rotation( 0.0, 1.0, 0.0, 0.0 ).to_rotation_matrix() ),
+        Rotation( 0.0, 1.0, 0.0, 0.0 ) );
+    check_same_rotation(
+        Rotation::from_rotation_matrix( Rotation( 0.0, 0.0, 1.0, 0.0 ).to_rotation_matrix() ),
+        Rotation( 0.0, 0.0, 1.0, 0.0 ) );
+    check_same_rotation(
+        Rotation::from_rotation_matrix( Rotation( 0.0, 0.0, 0.0, 1.0 ).to_rotation_matrix() ),
+        Rotation( 0.0, 0.0, 0.0, 1.0 ) );
+
+    BOOST_CHECK_THROW( Rotation::from_rotation_matrix( Matrix::identity_matrix( 2, 2 ) ),
+                       std::domain_error );
+}
+
+BOOST_AUTO_TEST_CASE( quaternion_interpolation_test )
+{
+    Vector3 axis( {0.0, 1.0, 0.0} );
+    Rotation from = Rotation::from_axis_angle( axis, 0.2 );
+    Rotation to = Rotation::from_axis_angle( axis, 1.4 );
+
+    check_same_rotation( slerp( from, to, 0.25 ), Rotation::from_axis_angle( axis, 0.5 ) );
+    check_same_rotation( slerp( from, to, 0.0 ), from );
+    check_same_rotation( slerp( from, to, 1.0 ), to );
+
+    // Opposite signs still take the shortest arc
+    Rotation negated( -to.w(), -to.x(), -to.y(), -to.z() );
+
+    check_same_rotation( slerp( from, negated, 0.5 ), Rotation::from_axis_angle( axis, 0.8 ) );
+    check_same_rotation( nlerp( from, negated, 0.5 ), Rotation::from_axis_angle( axis, 0.8 ) );
+    BOOST_CHECK_CLOSE( nlerp( from, to, 0.3 ).norm(), 1.0, 0.00001 );
+}
+
+BOOST_AUTO_TEST_CASE( quaternion_batch_test )
+{
+    const std::size_t count = 5000;
+    VectorArray< 3, double > points( count );
+    VectorArray< 4, double > rotations( count );
+    VectorArray< 4, double > composed;
+    VectorArray< 3, double > single;
+    VectorArray< 3, double > each;
+    Rotation common = Rotation::from_axis_angle( Vector3( {0.2, 0.4, 1.0} ), 0.7 );
+
+    for( std::size_t i = 0; i < count; ++i )
+    {
+        points[i] = Vector3( {double( i ), 1.0, -0.5 * i} );
+        rotations[i] = Rotation::from_axis_angle( Vector3( {1.0, 0.0, 1.0} ), 0.001 * i ).vector();
+    }
+
+    const std::size_t previous = parallel_threshold();
+
+    set_parallel_threshold( 1000 );
+
+    common.rotate( points, single );
+    rotate_each( rotations, points, each );
+    compose_each( rotations, rotations, composed );
+
+    set_parallel_threshold( previous );
+
+    for( std::size_t i = 0; i < count; i += 499 )
+    {
+        Rotation own( rotations.get( i ) );
+        Vector3 by_common = common.rotate( points.get( i ) );
+        Vector3 by_own = own.rotate( points.get( i ) );
+
+        for( position_t d = 0; d < 3; ++d )
+        {
+            BOOST_CHECK_SMALL( single.get( i )[d] - by_common[d], 1e-9 );
+            BOOST_CHECK_SMALL( each.get( i )[d] - by_own[d], 1e-9 );
+        }
+
+        check_same_rotation( Rotation( composed.get( i ) ),
+                             Rotation::from_axis_angle( Vector3( {1.0, 0.0, 1.0} ), 0.002 * i ) );
+    }
+
+    BOOST_CHECK_THROW( rotate_each( composed, VectorArray< 3, double >( 2 ), each ),
+                       std::domain_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+/* src/quaternion.hpp test suite end */
@@ -0,0 +1,144 @@
+#include <boost/test/unit_test.hpp>
+
+#include "../src/shared_matrix.hpp"
+
+#include <atomic>
+#include <thread>
+#include <unistd.h>
+
+#include "test_utils.hpp"
+
+namespace
+{
+std::string segment_name( std::string const &suffix )
+{
+    return "/matrix_test_" + std::to_string( getpid() ) + "_" + suffix;
+}
+}
+
+BOOST_AUTO_TEST_SUITE( SHARED_MATRIX_TEST_SUITE )
+
+BOOST_AUTO_TEST_CASE( publish_and_acquire_test )
+{
+    SharedMatrixWriter writer( segment_name( "publish" ), 12 );
+    SharedMatrixReader reader( writer.name() );
+    SharedMatrixSnapshot snapshot;
+
+    test_uint_value( reader.capacity(), 12, "reader.capacity()" );
+    test_bool_value( reader.acquire( snapshot ), false, "reader.acquire( snapshot )" );
+    BOOST_REQUIRE_THROW( reader.latest(), std::domain_error );
+
+    Matrix matrix;
+
+    matrix.set( {1.0, 2.0, 3.0, 4.0, 5.0, 6.0}, 2, 3 );
+    writer.publish( matrix );
+
+    test_bool_value( reader.acquire( snapshot ), true, "reader.acquire( snapshot )" );
+    test_uint_value( snapshot.sequence, 1, "snapshot.sequence" );
+    test_uint_value( snapshot.view.dimensions().first, 2, "view.dimensions().first" );
+    test_uint_value( snapshot.view.dimensions().second, 3, "view.dimensions().second" );
+    BOOST_CHECK_EQUAL( snapshot.view[1][2], 6.0 );
+
+    // Written in place, not visible before publish()
+    value_t *buffer = writer.prepare( 1, 2 );
+
+    buffer[0] = 7.0;
+    buffer[1] = 8.0;
+
+    test_uint_value( reader.sequence(), 1, "reader.sequence()" );
+    test_bool_value( reader.is_valid( snapshot ), true, "reader.is_valid( snapshot )" );
+
+    writer.publish();
+
+    Matrix latest = reader.latest();
+
+    test_uint_value( latest.dimensions().second, 2, "latest.dimensions().second" );
+    BOOST_CHECK_EQUAL( latest[0][1], 8.0 );
+
+    // The first snapshot buffer is reused by the third publication
+    writer.prepare( 1, 1 );
+    test_bool_value( reader.is_valid( snapshot ), false, "reader.is_valid( snapshot )" );
+
+    BOOST_REQUIRE_THROW( writer.prepare( 4, 4 ), std::domain_error );
+
+    // Column-major buffers are handed out as column-major views
+    buffer = writer.prepare( 2, 3, StorageOrder::column_major );
+
+    for( unsigned int i = 0; i < 6; ++i )
+    {
+        buffer[i] = i;
+    }
+
+    writer.publish();
+
+    test_bool_value( reader.acquire( snapshot ), true, "reader.acquire( snapshot )" );
+    test_bool_value( snapshot.view.order() == StorageOrder::column_major, true, "view.order()" );
+    BOOST_CHECK_EQUAL( snapshot.view( 1, 2 ), 5.0 );
+    BOOST_CHECK_EQUAL( reader.latest()[0][1], 2.0 );
+}
+
+BOOST_AUTO_TEST_CASE( segment_errors_test )
+{
+    BOOST_REQUIRE_THROW( SharedMatrixWriter( "no_slash", 4 ), std::domain_error );
+    BOOST_REQUIRE_THROW( SharedMatrixReader( segment_name( "missing" ) ), std::system_error );
+
+    SharedMatrixWriter writer( segment_name( "errors" ), 4 );
+
+    // Segments are created exclusively
+    BOOST_REQUIRE_THROW( SharedMatrixWriter( writer.name(), 4 ), std::system_error );
+    BOOST_REQUIRE_THROW( writer.publish(), std::domain_error );
+}
+
+BOOST_AUTO_TEST_CASE( concurrent_readers_test )
+{
+    const position_t size = 64;
+    SharedMatrixWriter writer( segment_name( "concurrent" ), size * size );
+    std::atomic< bool > done( false );
+    std::atomic< unsigned int > inconsistent( 0 );
+    std::vector< std::thread > readers;
+
+    for( unsigned int i = 0; i < 2; ++i )
+    {
+        readers.emplace_back( [&]( void ) {
+            SharedMatrixReader reader( writer.name() );
+
+            while( !done )
+            {
+                if( reader.sequence() == 0 )
+                {
+                    continue;
+                }
+
+                // Every published matrix is filled with its sequence number
+                Matrix latest = reader.latest();
+                const Reduction< value_t > reduction = latest.reduce();
+
+                if( reduction.minimum != reduction.maximum )
+                {
+                    ++inconsistent;
+                }
+            }
+        } );
+    }
+
+    for( unsigned int sequence = 1; sequence <= 200; ++sequence )
+    {
+        value_t *buffer = writer.prepare( size, size );
+
+        std::fill( buffer, buffer + size * size, static_cast< value_t >( sequence ) );
+        writer.publish();
+    }
+
+    done = true;
+
+    for( std::thread &reader : readers )
+    {
+        reader.join();
+    }
+
+    test_uint_value( inconsistent, 0, "inconsistent" );
+    test_uint_value( writer.sequence(), 200, "writer.sequence()" );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+/* src/shared_matrix.hpp test suite end */
@@ -0,0 +1,95 @@
+#include <boost/test/unit_test.hpp>
+
+#include "../src/parallel.hpp"
+#include "../src/sparse_matrix.hpp"
+
+#include "test_utils.hpp"
+
+BOOST_AUTO_TEST_SUITE( SPARSE_MATRIX_CLASS_TEST_SUITE )
+
+BOOST_AUTO_TEST_CASE( sparse_from_entries_test )
+{
+    // Out of order, the two ( 1, 0 ) entries are summed
+    SparseMatrix sparse( 3, 4, {{2, 3, 5.0}, {1, 0, 1.0}, {0, 1, 2.0}, {1, 0, 2.0}, {1, 2, -1.0}} );
+
+    test_uint_value( sparse.non_zeros(), 4, "sparse.non_zeros()" );
+    test_uint_value( sparse.line_offsets()[1], 1, "sparse.line_offsets()[1]" );
+    test_uint_value( sparse.line_offsets()[2], 3, "sparse.line_offsets()[2]" );
+    test_uint_value( sparse.column_indexes()[1], 0, "sparse.column_indexes()[1]" );
+    test_uint_value( sparse.column_indexes()[2], 2, "sparse.column_indexes()[2]" );
+
+    BOOST_CHECK_CLOSE( sparse.get( 1, 0 ), 3.0, 0.00001 );
+    BOOST_CHECK_CLOSE( sparse.get( 2, 3 ), 5.0, 0.00001 );
+    BOOST_CHECK_EQUAL( sparse.get( 2, 2 ), 0.0 );
+    BOOST_CHECK_THROW( sparse.get( 3, 0 ), std::out_of_range );
+    BOOST_CHECK_THROW( SparseMatrix( 2, 2, {{2, 0, 1.0}} ), std::out_of_range );
+
+    Matrix dense = sparse.to_matrix();
+
+    BOOST_CHECK_CLOSE( dense[0][1], 2.0, 0.00001 );
+    BOOST_CHECK_CLOSE( dense[1][2], -1.0, 0.00001 );
+    BOOST_CHECK_EQUAL( dense[2][0], 0.0 );
+}
+
+BOOST_AUTO_TEST_CASE( sparse_from_matrix_test )
+{
+    Matrix matrix;
+
+    matrix.set( {4.0, 0.0, 1.0, 0.0, 3.0, 0.0, 2.0, 0.0, 5.0}, 3, 3 );
+
+    SparseMatrix sparse( matrix );
+    std::vector< value_t > diagonal = sparse.diagonal();
+
+    test_uint_value( sparse.non_zeros(), 5, "sparse.non_zeros()" );
+    BOOST_CHECK_CLOSE( diagonal[0], 4.0, 0.00001 );
+    BOOST_CHECK_CLOSE( diagonal[1], 3.0, 0.00001 );
+    BOOST_CHECK_CLOSE( diagonal[2], 5.0, 0.00001 );
+
+    Matrix dense = sparse.to_matrix();
+
+    for( position_t i = 0; i < 3; ++i )
+    {
+        for( position_t j = 0; j < 3; ++j )
+        {
+            BOOST_CHECK_EQUAL( dense[i][j], matrix[i][j] );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( sparse_multiply_test )
+{
+    const position_t size = 2000;
+    std::vector< SparseEntry > entries;
+
+    for( position_t i = 0; i < size; ++i )
+    {
+        entries.push_back( {i, i, 2.0} );
+
+        if( i > 0 )
+        {
+            entries.push_back( {i, i - 1, -1.0} );
+        }
+    }
+
+    SparseMatrix sparse( size, size, entries );
+    std::vector< value_t > x( size, 1.0 );
+    const std::size_t previous = parallel_threshold();
+
+    set_parallel_threshold( 100 );
+
+    std::vector< value_t > y = sparse.multiply( x );
+
+    set_parallel_threshold( previous );
+
+    BOOST_CHECK_CLOSE( y[0], 2.0, 0.00001 );
+
+    for( position_t i = 1; i < size; ++i )
+    {
+        BOOST_CHECK_CLOSE( y[i], 1.0, 0.00001 );
+    }
+
+    BOOST_CHECK_THROW( sparse.multiply( std::vector< value_t >( 3 ) ), std::domain_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+/* src/sparse_matrix.hpp test suite end */
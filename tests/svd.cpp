@@ -0,0 +1,184 @@
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+#include "../src/svd.hpp"
+
+#include "test_utils.hpp"
+
+namespace
+{
+// lines x columns matrix with the given singular values, exactly of rank
+// values.size()
+Matrix low_rank_matrix( position_t const &lines,
+                        position_t const &columns,
+                        std::vector< value_t > const &values )
+{
+    Matrix result;
+
+    result.reset_dimensions( lines, columns );
+
+    for( position_t i = 0; i < lines; ++i )
+    {
+        std::fill( result[i], result[i] + columns, 0.0 );
+    }
+
+    for( position_t k = 0; k < values.size(); ++k )
+    {
+        std::vector< value_t > left( lines );
+        std::vector< value_t > right( columns );
+        value_t left_norm = 0.0;
+        value_t right_norm = 0.0;
+
+        for( position_t i = 0; i < lines; ++i )
+        {
+            left[i] = std::cos( ( k + 1.0 ) * ( i + 0.5 ) * 3.14159265358979 / lines );
+            left_norm += left[i] * left[i];
+        }
+
+        for( position_t j = 0; j < columns; ++j )
+        {
+            right[j] = std::cos( ( k + 1.0 ) * ( j + 0.5 ) * 3.14159265358979 / columns );
+            right_norm += right[j] * right[j];
+        }
+
+        // Distinct cosine frequencies are orthogonal on these grids
+        const value_t scale = values[k] / std::sqrt( left_norm * right_norm );
+
+        for( position_t i = 0; i < lines; ++i )
+        {
+            for( position_t j = 0; j < columns; ++j )
+            {
+                result[i][j] += scale * left[i] * right[j];
+            }
+        }
+    }
+
+    return result;
+}
+
+void check_reconstruction( SingularValueDecomposition const &svd,
+                           Matrix const &matrix,
+                           value_t const &tolerance )
+{
+    const position_t rank = static_cast< position_t >( svd.singular_values.size() );
+    Matrix scaled( svd.u );
+
+    for( position_t i = 0; i < scaled.dimensions().first; ++i )
+    {
+        for( position_t k = 0; k < rank; ++k )
+        {
+            scaled[i][k] *= svd.singular_values[k];
+        }
+    }
+
+    Matrix product = scaled * svd.vt;
+
+    for( position_t i = 0; i < matrix.dimensions().first; ++i )
+    {
+        for( position_t j = 0; j < matrix.dimensions().second; ++j )
+        {
+            BOOST_CHECK_SMALL( product[i][j] - matrix[i][j], tolerance );
+        }
+    }
+}
+}
+
+BOOST_AUTO_TEST_SUITE( SVD_CLASS_TEST_SUITE )
+
+BOOST_AUTO_TEST_CASE( jacobi_svd_test )
+{
+    Matrix matrix;
+
+    // Singular values 5 and 3
+    matrix.set( {3.0, 2.0, 2.0, 2.0, 3.0, -2.0}, 2, 3 );
+
+    SingularValueDecomposition svd = jacobi_svd( matrix );
+
+    test_uint_value( svd.singular_values.size(), 2, "svd.singular_values.size()" );
+    test_uint_value( svd.u.dimensions().first, 2, "svd.u.dimensions().first" );
+    test_uint_value( svd.vt.dimensions().second, 3, "svd.vt.dimensions().second" );
+    BOOST_CHECK_CLOSE( svd.singular_values[0], 5.0, 0.00001 );
+    BOOST_CHECK_CLOSE( svd.singular_values[1], 3.0, 0.00001 );
+    check_reconstruction( svd, matrix, 1e-12 );
+
+    Matrix tall = matrix.transposed();
+
+    svd = jacobi_svd( tall );
+
+    BOOST_CHECK_CLOSE( svd.singular_values[0], 5.0, 0.00001 );
+    check_reconstruction( svd, tall, 1e-12 );
+}
+
+BOOST_AUTO_TEST_CASE( randomized_svd_test )
+{
+    const std::vector< value_t > values( {50.0, 20.0, 10.0, 5.0, 1.0} );
+    Matrix matrix = low_rank_matrix( 300, 80, values );
+    SingularValueDecomposition svd = randomized_svd( matrix, 5 );
+
+    test_uint_value( svd.u.dimensions().first, 300, "svd.u.dimensions().first" );
+    test_uint_value( svd.u.dimensions().second, 5, "svd.u.dimensions().second" );
+    test_uint_value( svd.vt.dimensions().first, 5, "svd.vt.dimensions().first" );
+
+    for( position_t k = 0; k < 5; ++k )
+    {
+        BOOST_CHECK_CLOSE( svd.singular_values[k], values[k], 0.00001 );
+    }
+
+    check_reconstruction( svd, matrix, 1e-9 );
+
+    // Truncating below the true rank keeps the leading values
+    RandomizedSvdOptions options;
+
+    options.power_iterations = 2;
+    svd = randomized_svd( matrix, 2, options );
+
+    BOOST_CHECK_CLOSE( svd.singular_values[0], 50.0, 0.00001 );
+    BOOST_CHECK_CLOSE( svd.singular_values[1], 20.0, 0.00001 );
+
+    BOOST_CHECK_THROW( randomized_svd( matrix, 0 ), std::domain_error );
+    BOOST_CHECK_THROW( randomized_svd( matrix, 81 ), std::domain_error );
+}
+
+BOOST_AUTO_TEST_CASE( streaming_svd_test )
+{
+    const std::vector< value_t > values( {40.0, 8.0, 2.0} );
+    Matrix matrix = low_rank_matrix( 500, 60, values );
+    StreamingSvd streaming( 60, 3 );
+    const position_t block_lines = 37;
+
+    for( position_t first = 0; first < 500; first += block_lines )
+    {
+        const position_t count = std::min( block_lines, 500 - first );
+        Matrix block;
+
+        block.reset_dimensions( count, 60 );
+
+        for( position_t i = 0; i < count; ++i )
+        {
+            std::copy( matrix[first + i], matrix[first + i] + 60, block[i] );
+        }
+
+        streaming.add_lines( block );
+    }
+
+    test_uint_value( streaming.lines(), 500, "streaming.lines()" );
+
+    SingularValueDecomposition svd = streaming.finish();
+
+    for( position_t k = 0; k < 3; ++k )
+    {
+        BOOST_CHECK_CLOSE( svd.singular_values[k], values[k], 0.00001 );
+    }
+
+    check_reconstruction( svd, matrix, 1e-9 );
+
+    Matrix wrong;
+
+    wrong.reset_dimensions( 2, 59 );
+    BOOST_CHECK_THROW( streaming.add_lines( wrong ), std::domain_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+/* src/svd.hpp test suite end */
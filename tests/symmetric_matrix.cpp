@@ -0,0 +1,131 @@
+#include <boost/test/unit_test.hpp>
+
+#include "../src/condition_estimate.hpp"
+#include "../src/lu_decomposition.hpp"
+#include "../src/symmetric_matrix.hpp"
+
+#include "test_utils.hpp"
+
+BOOST_AUTO_TEST_SUITE( SYMMETRIC_MATRIX_CLASS_TEST_SUITE )
+
+BOOST_AUTO_TEST_CASE( symmetric_matrix_element_test )
+{
+    SymmetricMatrix matrix( 3 );
+
+    matrix.element( 2, 0 ) = 5.0;
+
+    BOOST_CHECK_CLOSE( matrix.get( 0, 2 ), 5.0, 0.00001 );
+
+    matrix.element( 0, 1 ) = -1.0;
+
+    Matrix dense = matrix.to_matrix();
+
+    BOOST_CHECK_CLOSE( dense[1][0], -1.0, 0.00001 );
+    BOOST_CHECK_CLOSE( dense[0][1], -1.0, 0.00001 );
+    BOOST_REQUIRE_THROW( matrix.get( 3, 0 ), std::out_of_range );
+}
+
+BOOST_AUTO_TEST_CASE( symmetric_matrix_rank_k_update_test )
+{
+    Matrix data;
+
+    data.set( {1.0, 2.0, 0.0, 1.0, 3.0, -1.0, 2.0, 1.0}, 4, 2 );
+
+    SymmetricMatrix gram = SymmetricMatrix::gram( data );
+    Matrix expected = data.transposed() * data;
+
+    BOOST_CHECK_CLOSE( gram.get( 0, 0 ), expected[0][0], 0.00001 );
+    BOOST_CHECK_CLOSE( gram.get( 0, 1 ), expected[0][1], 0.00001 );
+    BOOST_CHECK_CLOSE( gram.get( 1, 1 ), expected[1][1], 0.00001 );
+
+    SymmetricMatrix outer( 4 );
+
+    outer.rank_k_update( 2.0, data, false, 0.0 );
+    expected = ( data * data.transposed() ) * 2.0;
+
+    for( position_t i = 0; i < 4; ++i )
+    {
+        for( position_t j = 0; j < 4; ++j )
+        {
+            BOOST_CHECK_CLOSE( outer.get( i, j ), expected[i][j], 0.00001 );
+        }
+    }
+
+    BOOST_REQUIRE_THROW( outer.rank_k_update( 1.0, data, true, 1.0 ), std::domain_error );
+}
+
+BOOST_AUTO_TEST_CASE( symmetric_matrix_products_test )
+{
+    Matrix dense;
+    Matrix other;
+
+    dense.set( {4.0, 1.0, 2.0, 1.0, 3.0, 0.0, 2.0, 0.0, 5.0}, 3, 3 );
+    other.set( {1.0, 2.0, 3.0, 4.0, 5.0, 6.0}, 3, 2 );
+
+    SymmetricMatrix matrix( dense );
+
+    std::vector< value_t > product = matrix.multiply( {1.0, -1.0, 2.0} );
+
+    BOOST_CHECK_CLOSE( product[0], 7.0, 0.00001 );
+    BOOST_CHECK_CLOSE( product[1], -2.0, 0.00001 );
+    BOOST_CHECK_CLOSE( product[2], 12.0, 0.00001 );
+
+    Matrix result = matrix * other;
+    Matrix expected = dense * other;
+
+    for( position_t i = 0; i < 3; ++i )
+    {
+        for( position_t j = 0; j < 2; ++j )
+        {
+            BOOST_CHECK_CLOSE( result[i][j], expected[i][j], 0.00001 );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( symmetric_matrix_cholesky_test )
+{
+    Matrix dense;
+
+    dense.set( {4.0, 12.0, -16.0, 12.0, 37.0, -43.0, -16.0, -43.0, 98.0}, 3, 3 );
+
+    SymmetricMatrix matrix( dense );
+    TriangularMatrix factor = matrix.cholesky();
+
+    BOOST_CHECK_CLOSE( factor.get( 0, 0 ), 2.0, 0.00001 );
+    BOOST_CHECK_CLOSE( factor.get( 1, 0 ), 6.0, 0.00001 );
+    BOOST_CHECK_CLOSE( factor.get( 2, 1 ), 5.0, 0.00001 );
+    BOOST_CHECK_CLOSE( factor.get( 2, 2 ), 3.0, 0.00001 );
+
+    std::vector< value_t > expected( {1.0, -2.0, 0.5} );
+    std::vector< value_t > solution = matrix.solve( matrix.multiply( expected ) );
+
+    for( position_t i = 0; i < 3; ++i )
+    {
+        BOOST_CHECK_CLOSE( solution[i], expected[i], 0.00001 );
+    }
+
+    dense.set( {1.0, 2.0, 2.0, 1.0}, 2, 2 );
+
+    BOOST_REQUIRE_THROW( SymmetricMatrix( dense ).cholesky(), std::domain_error );
+}
+
+BOOST_AUTO_TEST_CASE( symmetric_matrix_condition_estimate_test )
+{
+    Matrix dense;
+
+    dense.set( {4.0, 12.0, -16.0, 12.0, 37.0, -43.0, -16.0, -43.0, 98.0}, 3, 3 );
+
+    SymmetricMatrix matrix( dense );
+    const value_t inverse_norm = norm1( LUDecomposition( dense ).inverse() );
+
+    // Exact for such a small matrix
+    BOOST_CHECK_CLOSE( matrix.condition_estimate( matrix.cholesky() ),
+                       norm1( dense ) * inverse_norm,
+                       0.0001 );
+
+    BOOST_REQUIRE_THROW( matrix.condition_estimate( TriangularMatrix( 2, Triangle::lower ) ),
+                         std::domain_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+/* src/symmetric_matrix.hpp test suite end */
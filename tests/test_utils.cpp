@@ -1,4 +1,5 @@
 #include "test_utils.hpp"
+#include <random>
 
 void test_bool_value( bool value, bool expected_value, const std::string &function )
 {
@@ -27,6 +28,25 @@ void test_uint_value( unsigned int value, unsigned int expected_value, const std
                                    << "     Got: " << value );
 }
 
+Matrix make_matrix( position_t const &lines, position_t const &columns, unsigned int const &seed )
+{
+    std::mt19937 generator( seed );
+    std::uniform_real_distribution< value_t > distribution( -1.0, 1.0 );
+    Matrix matrix;
+
+    matrix.reset_dimensions( lines, columns );
+
+    for( position_t i = 0; i < lines; ++i )
+    {
+        for( position_t j = 0; j < columns; ++j )
+        {
+            matrix[i][j] = distribution( generator );
+        }
+    }
+
+    return matrix;
+}
+
 // std::string get_tests_prefix(void)
 // {
 //     std::string prefix = bfs::canonical(bfs::absolute(".")).string();
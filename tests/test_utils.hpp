@@ -6,6 +6,8 @@
 // #include <boost/filesystem.hpp>
 #include <string>
 
+#include "../src/matrix.hpp"
+
 // namespace bfs = boost::filesystem;
 
 void test_bool_value( bool value, bool expected_value, const std::string &function );
@@ -16,6 +18,11 @@ void test_uint_value( unsigned int value,
                       unsigned int expected_value,
                       const std::string &function );
 
+// lines x columns values uniform in [-1, 1), always the same for a seed
+Matrix make_matrix( position_t const &lines,
+                    position_t const &columns,
+                    unsigned int const &seed = 0 );
+
 // std::string get_tests_prefix(void);
 
 #endif
@@ -0,0 +1,43 @@
+#include <boost/test/unit_test.hpp>
+
+#include "../src/thread_pool.hpp"
+
+#include <atomic>
+
+#include "test_utils.hpp"
+
+BOOST_AUTO_TEST_SUITE( THREAD_POOL_CLASS_TEST_SUITE )
+
+BOOST_AUTO_TEST_CASE( thread_pool_runs_every_task_test )
+{
+    std::atomic< unsigned int > counter( 0 );
+
+    {
+        ThreadPool pool( 3 );
+
+        test_uint_value( pool.thread_count(), 3, "pool.thread_count()" );
+
+        for( unsigned int i = 0; i < 100; ++i )
+        {
+            pool.submit( [&counter]( void ) -> void { ++counter; } );
+        }
+    }
+
+    test_uint_value( counter, 100, "counter" );
+}
+
+BOOST_AUTO_TEST_CASE( thread_pool_async_returns_future_test )
+{
+    ThreadPool pool( 2 );
+
+    std::future< unsigned int > result = pool.async( []( void ) -> unsigned int { return 42; } );
+    std::future< bool > inside =
+        pool.async( []( void ) -> bool { return ThreadPool::is_worker_thread(); } );
+
+    test_uint_value( result.get(), 42, "result.get()" );
+    test_bool_value( inside.get(), true, "ThreadPool::is_worker_thread()" );
+    test_bool_value( ThreadPool::is_worker_thread(), false, "ThreadPool::is_worker_thread()" );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+/* src/thread_pool.hpp test suite end */
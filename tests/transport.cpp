@@ -0,0 +1,247 @@
+#include <boost/test/unit_test.hpp>
+
+#include "../src/socket_transport.hpp"
+#include "../src/transport.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+
+#include "test_utils.hpp"
+
+namespace
+{
+// Every rank sends its rank and a running counter to every other rank, then
+// checks what it received, in order. Boost.Test assertions are not thread
+// safe, the count of wrong messages is checked by the caller.
+unsigned int exchange_messages( Transport &transport )
+{
+    unsigned int mismatches = 0;
+
+    for( int round = 0; round < 3; ++round )
+    {
+        for( int peer = 0; peer < transport.size(); ++peer )
+        {
+            transport.send( peer, 7, std::vector< value_t >( round + 1, transport.rank() ) );
+        }
+    }
+
+    for( int peer = 0; peer < transport.size(); ++peer )
+    {
+        for( int round = 0; round < 3; ++round )
+        {
+            std::vector< value_t > data = transport.receive( peer, 7 );
+
+            if( ( data.size() != static_cast< std::size_t >( round + 1 ) ) ||
+                ( data.back() != static_cast< value_t >( peer ) ) )
+            {
+                ++mismatches;
+            }
+        }
+    }
+
+    return mismatches;
+}
+
+template < typename Factory >
+void run_ranks( int const &size, Factory &&factory )
+{
+    std::vector< std::thread > threads;
+    std::vector< unsigned int > mismatches( size, 0 );
+    std::vector< std::exception_ptr > errors( size );
+
+    for( int rank = 0; rank < size; ++rank )
+    {
+        threads.emplace_back( [rank, &factory, &mismatches, &errors]( void ) {
+            try
+            {
+                std::unique_ptr< Transport > transport = factory( rank );
+
+                mismatches[rank] = exchange_messages( *transport );
+            }
+            catch( ... )
+            {
+                errors[rank] = std::current_exception();
+            }
+        } );
+    }
+
+    for( std::thread &thread : threads )
+    {
+        thread.join();
+    }
+
+    for( int rank = 0; rank < size; ++rank )
+    {
+        if( errors[rank] )
+        {
+            BOOST_CHECK_NO_THROW( std::rethrow_exception( errors[rank] ) );
+        }
+
+        test_uint_value( mismatches[rank], 0, "mismatches of rank " + std::to_string( rank ) );
+    }
+}
+
+// Kernel assigned ports, shared between the rank threads
+class PortTable
+{
+    public:
+    explicit PortTable( int const &size )
+        : _ports( size, 0 )
+    {
+    }
+
+    void publish( int const &rank, unsigned short const &port )
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+
+        _ports[rank] = port;
+    }
+
+    unsigned short port_of( int const &rank )
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+
+        return _ports[rank];
+    }
+
+    private:
+    std::mutex _mutex;
+    std::vector< unsigned short > _ports;
+};
+}
+
+BOOST_AUTO_TEST_SUITE( TRANSPORT_TEST_SUITE )
+
+BOOST_AUTO_TEST_CASE( mailbox_test )
+{
+    Mailbox mailbox;
+
+    mailbox.deliver( 1, 3, std::vector< value_t >{1.0} );
+    mailbox.deliver( 1, 4, std::vector< value_t >{2.0} );
+    mailbox.deliver( 1, 3, std::vector< value_t >{3.0} );
+
+    BOOST_CHECK_EQUAL( mailbox.take( 1, 4 )[0], 2.0 );
+    BOOST_CHECK_EQUAL( mailbox.take( 1, 3 )[0], 1.0 );
+    BOOST_CHECK_EQUAL( mailbox.take( 1, 3 )[0], 3.0 );
+
+    mailbox.close( 1 );
+
+    BOOST_REQUIRE_THROW( mailbox.take( 1, 3 ), TransportClosed );
+}
+
+BOOST_AUTO_TEST_CASE( in_process_transport_test )
+{
+    InProcessNetwork network( 4 );
+
+    run_ranks( 4, [&network]( int const &rank ) { return network.endpoint( rank ); } );
+
+    BOOST_REQUIRE_THROW( network.endpoint( 4 ), std::out_of_range );
+    BOOST_REQUIRE_THROW( InProcessNetwork( 0 ), std::domain_error );
+}
+
+BOOST_AUTO_TEST_CASE( unix_socket_transport_test )
+{
+    char directory[] = "/tmp/transport_test_XXXXXX";
+
+    BOOST_REQUIRE( mkdtemp( directory ) != nullptr );
+
+    run_ranks( 3, [&directory]( int const &rank ) {
+        return SocketTransport::unix_domain( directory, rank, 3 );
+    } );
+
+    test_uint_value( rmdir( directory ), 0, "rmdir( directory )" );
+}
+
+BOOST_AUTO_TEST_CASE( tcp_socket_transport_test )
+{
+    PortTable ports( 3 );
+
+    run_ranks( 3, [&ports]( int const &rank ) {
+        return SocketTransport::tcp(
+            "127.0.0.1",
+            [&ports]( int const &published, unsigned short const &port ) {
+                ports.publish( published, port );
+            },
+            [&ports]( int const &peer ) { return ports.port_of( peer ); },
+            rank,
+            3 );
+    } );
+}
+
+BOOST_AUTO_TEST_CASE( socket_transport_timeout_test )
+{
+    char directory[] = "/tmp/transport_test_XXXXXX";
+
+    BOOST_REQUIRE( mkdtemp( directory ) != nullptr );
+
+    // Rank 1 never shows up: rank 0 gives up accepting, rank 2 connecting
+    const SocketTransport::Timeout timeout( 100 );
+
+    BOOST_CHECK_THROW( SocketTransport::unix_domain( directory, 0, 2, timeout ),
+                       std::runtime_error );
+    BOOST_CHECK_THROW( SocketTransport::unix_domain( directory, 2, 3, timeout ),
+                       std::runtime_error );
+
+    test_uint_value( rmdir( directory ), 0, "rmdir( directory )" );
+}
+
+BOOST_AUTO_TEST_CASE( socket_transport_corrupt_header_test )
+{
+    char directory[] = "/tmp/transport_test_XXXXXX";
+
+    BOOST_REQUIRE( mkdtemp( directory ) != nullptr );
+
+    // Rank 0 of 2 is played by hand, listening where rank 1 looks for it
+    const std::string path = std::string( directory ) + "/rank_0.sock";
+    const int listener = ::socket( AF_UNIX, SOCK_STREAM, 0 );
+    sockaddr_un address{};
+
+    address.sun_family = AF_UNIX;
+    std::strcpy( address.sun_path, path.c_str() );
+
+    BOOST_REQUIRE( ::bind( listener, reinterpret_cast< sockaddr * >( &address ),
+                           sizeof( address ) ) == 0 );
+    BOOST_REQUIRE( ::listen( listener, 1 ) == 0 );
+
+    // Connecting only needs the listen backlog, rank 1 has no higher rank
+    std::unique_ptr< SocketTransport > transport = SocketTransport::unix_domain( directory, 1, 2 );
+    const int peer = ::accept( listener, nullptr, nullptr );
+    std::int32_t identity = -1;
+
+    BOOST_REQUIRE( ::recv( peer, &identity, sizeof( identity ), MSG_WAITALL ) ==
+                   static_cast< ssize_t >( sizeof( identity ) ) );
+    test_uint_value( identity, 1, "identity" );
+
+    // Same layout as the transport header, announcing 2^64 - 1 values
+    struct
+    {
+        std::int32_t tag;
+        std::uint64_t count;
+    } header{};
+
+    header.tag = 5;
+    header.count = ~std::uint64_t( 0 );
+
+    BOOST_REQUIRE( ::send( peer, &header, sizeof( header ), 0 ) ==
+                   static_cast< ssize_t >( sizeof( header ) ) );
+
+    // The reader drops the peer instead of allocating
+    BOOST_CHECK_THROW( transport->receive( 0, 5 ), TransportClosed );
+
+    ::close( peer );
+    transport.reset();
+    ::close( listener );
+    ::unlink( path.c_str() );
+
+    test_uint_value( rmdir( directory ), 0, "rmdir( directory )" );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+/* src/transport.hpp test suite end */
@@ -0,0 +1,66 @@
+#include <boost/test/unit_test.hpp>
+
+#include "../src/triangular_matrix.hpp"
+
+#include "test_utils.hpp"
+
+BOOST_AUTO_TEST_SUITE( TRIANGULAR_MATRIX_CLASS_TEST_SUITE )
+
+BOOST_AUTO_TEST_CASE( triangular_matrix_conversion_test )
+{
+    Matrix matrix;
+
+    matrix.set( {1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0}, 3, 3 );
+
+    TriangularMatrix lower( matrix, Triangle::lower );
+    TriangularMatrix upper( matrix, Triangle::upper );
+
+    BOOST_CHECK_CLOSE( lower.get( 2, 1 ), 8.0, 0.00001 );
+    BOOST_CHECK_SMALL( lower.get( 0, 2 ), 0.00001 );
+    BOOST_CHECK_CLOSE( upper.get( 0, 2 ), 3.0, 0.00001 );
+    BOOST_CHECK_SMALL( upper.get( 2, 1 ), 0.00001 );
+    BOOST_CHECK_CLOSE( upper.to_matrix()[1][2], 6.0, 0.00001 );
+    BOOST_CHECK_SMALL( upper.to_matrix()[1][0], 0.00001 );
+
+    BOOST_REQUIRE_THROW( lower.element( 0, 1 ), std::out_of_range );
+
+    BOOST_CHECK_CLOSE( lower.determinant(), 45.0, 0.00001 );
+}
+
+BOOST_AUTO_TEST_CASE( triangular_matrix_solve_test )
+{
+    Matrix matrix;
+
+    matrix.set( {2.0, 0.0, 0.0, 1.0, 4.0, 0.0, -1.0, 3.0, 5.0}, 3, 3 );
+
+    TriangularMatrix lower( matrix, Triangle::lower );
+    TriangularMatrix upper( matrix.transposed(), Triangle::upper );
+
+    std::vector< value_t > expected( {1.0, -2.0, 0.5} );
+    std::vector< value_t > product = lower.multiply( expected );
+    std::vector< value_t > solution = lower.solve( product );
+
+    for( position_t i = 0; i < 3; ++i )
+    {
+        BOOST_CHECK_CLOSE( solution[i], expected[i], 0.00001 );
+    }
+
+    product = upper.multiply( expected );
+    solution = upper.solve( product );
+
+    for( position_t i = 0; i < 3; ++i )
+    {
+        BOOST_CHECK_CLOSE( solution[i], expected[i], 0.00001 );
+    }
+
+    // L^T x = U x, since U was built from L transposed
+    lower.solve_transposed_in_place( product.data() );
+
+    for( position_t i = 0; i < 3; ++i )
+    {
+        BOOST_CHECK_CLOSE( product[i], expected[i], 0.00001 );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+/* src/triangular_matrix.hpp test suite end */
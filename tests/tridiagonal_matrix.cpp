@@ -0,0 +1,58 @@
+#include <boost/test/unit_test.hpp>
+
+#include "../src/tridiagonal_matrix.hpp"
+
+#include "test_utils.hpp"
+
+BOOST_AUTO_TEST_SUITE( TRIDIAGONAL_MATRIX_CLASS_TEST_SUITE )
+
+BOOST_AUTO_TEST_CASE( tridiagonal_matrix_conversion_test )
+{
+    TridiagonalMatrix matrix( 4 );
+
+    for( position_t i = 0; i < 4; ++i )
+    {
+        matrix.element( i, i ) = 4.0;
+
+        if( i > 0 )
+        {
+            matrix.element( i, i - 1 ) = -1.0;
+            matrix.element( i - 1, i ) = 2.0;
+        }
+    }
+
+    BOOST_REQUIRE_THROW( matrix.element( 0, 2 ), std::out_of_range );
+
+    Matrix dense = matrix.to_matrix();
+
+    BOOST_CHECK_CLOSE( dense[2][1], -1.0, 0.00001 );
+    BOOST_CHECK_CLOSE( dense[1][2], 2.0, 0.00001 );
+    BOOST_CHECK_SMALL( dense[0][3], 0.00001 );
+
+    BOOST_CHECK_CLOSE( matrix.determinant(), dense.determinant(), 0.00001 );
+
+    TridiagonalMatrix copy( dense );
+
+    BOOST_CHECK_CLOSE( copy.get( 3, 2 ), -1.0, 0.00001 );
+}
+
+BOOST_AUTO_TEST_CASE( tridiagonal_matrix_thomas_solve_test )
+{
+    Matrix dense;
+
+    dense.set( {4.0, 1.0, 0.0, 0.0, 1.0, 4.0, 1.0, 0.0, 0.0, 1.0, 4.0, 1.0, 0.0, 0.0, 1.0, 4.0},
+               4,
+               4 );
+
+    TridiagonalMatrix matrix( dense );
+    std::vector< value_t > expected( {1.0, 2.0, -1.0, 0.5} );
+    std::vector< value_t > solution = matrix.solve( matrix.multiply( expected ) );
+
+    for( position_t i = 0; i < 4; ++i )
+    {
+        BOOST_CHECK_CLOSE( solution[i], expected[i], 0.00001 );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+/* src/tridiagonal_matrix.hpp test suite end */
@@ -1,5 +1,7 @@
 #include <boost/test/unit_test.hpp>
 
+#include <limits>
+
 #include "../src/vector.hpp"
 
 #include "test_utils.hpp"
@@ -265,5 +267,82 @@ BOOST_AUTO_TEST_CASE( calculate_threedimensional_cross_product_test )
     test_vector_coordinates_equal( product2, expected2 );
 }
 
+BOOST_AUTO_TEST_CASE( vector_arithmetic_test )
+{
+    const Vector< 3, double > vec1( {1.0, 2.0, 3.0} );
+    const Vector< 3, double > vec2( {4.0, -1.0, 0.5} );
+
+    test_vector_coordinates_equal( vec1 + vec2, Vector< 3, double >( {5.0, 1.0, 3.5} ) );
+    test_vector_coordinates_equal( vec1 - vec2, Vector< 3, double >( {-3.0, 3.0, 2.5} ) );
+    test_vector_coordinates_equal( vec1 * 2.0, Vector< 3, double >( {2.0, 4.0, 6.0} ) );
+    test_vector_coordinates_equal( 2.0 * vec1, Vector< 3, double >( {2.0, 4.0, 6.0} ) );
+    test_vector_coordinates_equal( vec1 / 2.0, Vector< 3, double >( {0.5, 1.0, 1.5} ) );
+    test_vector_coordinates_equal( -vec1, Vector< 3, double >( {-1.0, -2.0, -3.0} ) );
+
+    test_bool_value( vec1 == Vector< 3, double >( {1.0, 2.0, 3.0} ), true, "vec1 == vec1" );
+    test_bool_value( vec1 != vec2, true, "vec1 != vec2" );
+}
+
+namespace
+{
+constexpr Vector< 3, double > make_normal( Vector< 3, double > const &first,
+                                           Vector< 3, double > const &second )
+{
+    return first.cross( second );
+}
+
+constexpr Vector< 3, double > basis[3] = {
+    Vector< 3, double >( {1.0, 0.0, 0.0} ),
+    Vector< 3, double >( {0.0, 1.0, 0.0} ),
+    make_normal( Vector< 3, double >( {1.0, 0.0, 0.0} ), Vector< 3, double >( {0.0, 1.0, 0.0} ) )};
+}
+
+BOOST_AUTO_TEST_CASE( constexpr_vector_operations_test )
+{
+    static_assert( basis[2] == Vector< 3, double >( {0.0, 0.0, 1.0} ),
+                   "cross product should be computed at compile time" );
+    static_assert( basis[0].dot( basis[1] ) == 0.0, "dot product should be constexpr" );
+    static_assert( ( basis[0] + basis[1] ).get< 1 >() == 1.0, "get should be constexpr" );
+    static_assert( basis[0][0] == 1.0, "operator[] should be constexpr" );
+    static_assert( Vector< 2, double >( {1.0, 1.0} ).cross( Vector< 2, double >( {4.0, 5.0} ) ) ==
+                       1.0,
+                   "bidimensional cross product should be constexpr" );
+    static_assert( ( basis[0] * 3.0 ).squared_distance_to( basis[0] ) == 4.0,
+                   "squared distance should be constexpr" );
+
+    BOOST_CHECK_CLOSE( basis[2].get< 2 >(), 1.0, 0.00001 );
+}
+
+BOOST_AUTO_TEST_CASE( vector_reduction_test )
+{
+    const Vector< 3, double > vec( {3.0, -4.0, 1.0} );
+
+    Reduction< double > result = vec.reduce();
+
+    BOOST_CHECK_SMALL( result.sum, 0.00001 );
+    BOOST_CHECK_CLOSE( result.l1_norm(), 8.0, 0.00001 );
+    BOOST_CHECK_CLOSE( result.l2_norm(), std::sqrt( 26.0 ), 0.00001 );
+    BOOST_CHECK_CLOSE( result.linf_norm(), 4.0, 0.00001 );
+    test_uint_value( result.minimum_index, 1, "result.minimum_index" );
+    test_uint_value( result.maximum_index, 0, "result.maximum_index" );
+
+    static_assert( Vector< 2, double >( {1.0, -5.0} ).reduce().max_absolute == 5.0,
+                   "reduce should be constexpr" );
+
+    test_bool_value(
+        vec.approx_equal( Vector< 3, double >( {3.0, -4.00001, 1.0} ), 0.0001 ), true, "approx_equal" );
+    test_bool_value(
+        vec.approx_equal( Vector< 3, double >( {3.0, -4.1, 1.0} ), 0.0001 ), false, "approx_equal" );
+
+    const double nan = std::numeric_limits< double >::quiet_NaN();
+
+    test_bool_value( vec.approx_equal( Vector< 3, double >( {3.0, nan, 1.0} ), 1.0 ),
+                     false,
+                     "approx_equal with NaN" );
+    test_bool_value( Vector< 3, double >( {nan, nan, nan} ).approx_equal( vec, 1e300 ),
+                     false,
+                     "NaN approx_equal" );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 /* src/vector.hpp test suite end */
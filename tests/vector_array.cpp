@@ -0,0 +1,109 @@
+#include <boost/test/unit_test.hpp>
+
+#include "../src/vector_array.hpp"
+
+#include "test_utils.hpp"
+
+BOOST_AUTO_TEST_SUITE( VECTOR_ARRAY_CLASS_TEST_SUITE )
+
+BOOST_AUTO_TEST_CASE( vector_array_size_test )
+{
+    VectorArray< 3, double > array( 5 );
+
+    test_uint_value( array.size(), 5, "array.size()" );
+    test_uint_value( array.dimensions(), 3, "array.dimensions()" );
+
+    array.push_back( Vector< 3, double >( {1.0, 2.0, 3.0} ) );
+
+    test_uint_value( array.size(), 6, "array.size()" );
+}
+
+BOOST_AUTO_TEST_CASE( vector_array_element_proxy_test )
+{
+    VectorArray< 3, double > array( 2 );
+
+    array[1] = Vector< 3, double >( {4.0, 5.0, 6.0} );
+    array[0][2] = 7.5;
+
+    Vector< 3, double > second = array[1];
+
+    BOOST_CHECK_CLOSE( second[0], 4.0, 0.00001 );
+    BOOST_CHECK_CLOSE( second[1], 5.0, 0.00001 );
+    BOOST_CHECK_CLOSE( second[2], 6.0, 0.00001 );
+    BOOST_CHECK_CLOSE( array.component( 2 )[0], 7.5, 0.00001 );
+
+    BOOST_REQUIRE_THROW( array[2], std::out_of_range );
+}
+
+BOOST_AUTO_TEST_CASE( vector_array_dot_with_vector_test )
+{
+    VectorArray< 2, double > array;
+
+    array.push_back( Vector< 2, double >( {0.0, 1.0} ) );
+    array.push_back( Vector< 2, double >( {3.0, 4.0} ) );
+
+    std::vector< double > result = array.dot( Vector< 2, double >( {3.0, 4.0} ) );
+
+    BOOST_CHECK_CLOSE( result[0], 4.0, 0.00001 );
+    BOOST_CHECK_CLOSE( result[1], 25.0, 0.00001 );
+}
+
+BOOST_AUTO_TEST_CASE( vector_array_element_wise_dot_and_cross_test )
+{
+    VectorArray< 3, double > first;
+    VectorArray< 3, double > second;
+
+    first.push_back( Vector< 3, double >( {0, 1, 1} ) );
+    first.push_back( Vector< 3, double >( {3, -3, 1} ) );
+    second.push_back( Vector< 3, double >( {1, -1, 3} ) );
+    second.push_back( Vector< 3, double >( {4, 9, 2} ) );
+
+    std::vector< double > dots = first.dot( second );
+
+    BOOST_CHECK_CLOSE( dots[0], 2.0, 0.00001 );
+    BOOST_CHECK_CLOSE( dots[1], -13.0, 0.00001 );
+
+    VectorArray< 3, double > products = first.cross( second );
+
+    BOOST_CHECK_CLOSE( products[0][0], 4.0, 0.00001 );
+    BOOST_CHECK_CLOSE( products[0][1], 1.0, 0.00001 );
+    BOOST_CHECK_CLOSE( products[0][2], -1.0, 0.00001 );
+    BOOST_CHECK_CLOSE( products[1][0], -15.0, 0.00001 );
+    BOOST_CHECK_CLOSE( products[1][1], -2.0, 0.00001 );
+    BOOST_CHECK_CLOSE( products[1][2], 39.0, 0.00001 );
+
+    second.push_back( Vector< 3, double >() );
+
+    BOOST_REQUIRE_THROW( first.dot( second ), std::domain_error );
+}
+
+BOOST_AUTO_TEST_CASE( vector_array_norms_and_normalize_test )
+{
+    VectorArray< 2, double > array;
+
+    array.push_back( Vector< 2, double >( {3.0, 4.0} ) );
+    array.push_back( Vector< 2, double >( {0.0, 0.0} ) );
+
+    std::vector< double > norms = array.norms();
+
+    BOOST_CHECK_CLOSE( norms[0], 5.0, 0.00001 );
+    BOOST_CHECK_SMALL( norms[1], 0.00001 );
+
+    std::vector< double > distances = array.distances_to( Vector< 2, double >( {0.0, 4.0} ) );
+
+    BOOST_CHECK_CLOSE( distances[0], 3.0, 0.00001 );
+    BOOST_CHECK_CLOSE( distances[1], 4.0, 0.00001 );
+
+    array.scale( 2.0 );
+
+    BOOST_CHECK_CLOSE( array[0][1], 8.0, 0.00001 );
+
+    array.normalize();
+
+    BOOST_CHECK_CLOSE( array[0][0], 0.6, 0.00001 );
+    BOOST_CHECK_CLOSE( array[0][1], 0.8, 0.00001 );
+    BOOST_CHECK_SMALL( array[1][0], 0.00001 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+/* src/vector_array.hpp test suite end */